@@ -0,0 +1,158 @@
+/*
+ * ============================================================================
+ *  bench_diff.c — Diff Algoritmaları Karşılaştırması
+ * ============================================================================
+ *
+ *  Sentetik, C koduna benzeyen dosyalar üretir (çok sayıda "{", "}", boş
+ *  satır ve "return 0;") ve ikinci bir sürümünü çıkarır:
+ *    edit → satırların ~%1'i değiştirilmiş, eklenmiş veya silinmiş
+ *    move → ayrıca her 32 bloktan biri (64 satır) dosyanın sonuna taşınmış
+ *  Her senaryo, boyut ve algoritma için en iyi süreyi ve üretilen +/- satır
+ *  sayısını yazdırır.
+ *
+ *  Kullanım: make bench   (veya ./build/bench_diff [satır sayısı...])
+ * ============================================================================
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "../include/vault_cli.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_RUNS  3
+
+typedef struct {
+    char   *data;
+    size_t  size;
+    size_t  capacity;
+} Buffer;
+
+static void buf_line(Buffer *buf, const char *line){
+    size_t len = strlen(line);
+    if (buf->size + len + 1 > buf->capacity) {
+        buf->capacity = (buf->capacity + len + 1) * 2;
+        buf->data = realloc(buf->data, buf->capacity);
+        if (!buf->data) {
+            perror("realloc");
+            exit(1);
+        }
+    }
+    memcpy(buf->data + buf->size, line, len);
+    buf->data[buf->size + len] = '\n';
+    buf->size += len + 1;
+}
+
+/* Fonksiyon gövdeleri: tekrar eden satırlar ağırlıkta */
+static void gen_line(char *out, size_t size, unsigned *seed, int *fn){
+    static const char *common[] = {
+        "{", "}", "", "    return 0;", "    }", "    {", "        break;",
+        "    if (err != VAULT_OK)", "        return err;", "#endif",
+    };
+    unsigned r = (unsigned)rand_r(seed) % 100;
+    if (r < 60)
+        snprintf(out, size, "%s", common[(unsigned)rand_r(seed) % 10]);
+    else if (r < 65)
+        snprintf(out, size, "static int fn_%d(int x)", (*fn)++);
+    else
+        snprintf(out, size, "    x = x * %d + %d;", rand_r(seed) % 1000, rand_r(seed) % 1000);
+}
+
+#define BENCH_BLOCK  64
+
+/* old: n satır. new: aynı dizi, ~%1 satır değiştirilmiş / eklenmiş / silinmiş;
+ * move ise bazı bloklar sona taşınmış */
+static void generate(size_t lines, int move, Buffer *old_buf, Buffer *new_buf){
+    unsigned seed_old = 42, seed_edit = 7;
+    int fn = 0;
+    char line[128];
+    Buffer moved = { NULL, 0, 0 };
+    for (size_t i = 0; i < lines; i++) {
+        gen_line(line, sizeof(line), &seed_old, &fn);
+        buf_line(old_buf, line);
+        Buffer *dst = (move && (i / BENCH_BLOCK) % 32 == 1) ? &moved : new_buf;
+
+        unsigned e = (unsigned)rand_r(&seed_edit) % 300;
+        if (e == 0)
+            continue;                               /* sil */
+        if (e == 1) {
+            snprintf(line, sizeof(line), "    y = %d;", rand_r(&seed_edit));
+        } else if (e == 2) {
+            char extra[128];
+            snprintf(extra, sizeof(extra), "    log(%d);", rand_r(&seed_edit));
+            buf_line(dst, extra);                   /* ekle */
+        }
+        buf_line(dst, line);
+    }
+    for (size_t i = 0; i < moved.size; ) {
+        char *nl = memchr(moved.data + i, '\n', moved.size - i);
+        *nl = '\0';
+        buf_line(new_buf, moved.data + i);
+        i = (size_t)(nl - moved.data) + 1;
+    }
+    free(moved.data);
+}
+
+static double now_ms(void){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+int main(int argc, char **argv){
+    static const size_t default_sizes[] = { 10000, 100000, 500000 };
+    static const struct {
+        const char         *name;
+        VaultDiffAlgorithm  algorithm;
+    } algorithms[] = {
+        { "myers",     VAULT_DIFF_MYERS     },
+        { "patience",  VAULT_DIFF_PATIENCE  },
+        { "histogram", VAULT_DIFF_HISTOGRAM },
+    };
+
+    size_t count = argc > 1 ? (size_t)(argc - 1) : sizeof(default_sizes) / sizeof(default_sizes[0]);
+    printf("%-6s %-10s %-10s %12s %10s %10s\n",
+           "case", "lines", "algorithm", "best ms", "-lines", "+lines");
+
+    for (size_t c = 0; c < 2 * count; c++) {
+        int move = (int)(c / count);
+        size_t s = c % count;
+        size_t lines = argc > 1 ? strtoul(argv[s + 1], NULL, 10) : default_sizes[s];
+        Buffer old_buf = { NULL, 0, 0 }, new_buf = { NULL, 0, 0 };
+        generate(lines, move, &old_buf, &new_buf);
+
+        for (size_t a = 0; a < sizeof(algorithms) / sizeof(algorithms[0]); a++) {
+            double best = 0;
+            size_t dels = 0, adds = 0;
+            for (int run = 0; run < BENCH_RUNS; run++) {
+                DiffResult result;
+                double start = now_ms();
+                VaultError err = vault_diff_compute_with(old_buf.data, old_buf.size,
+                                                         new_buf.data, new_buf.size,
+                                                         algorithms[a].algorithm, &result);
+                double elapsed = now_ms() - start;
+                if (err != VAULT_OK) {
+                    fprintf(stderr, "bench_diff: %s failed (%d)\n", algorithms[a].name, err);
+                    return 1;
+                }
+                if (run == 0 || elapsed < best)
+                    best = elapsed;
+                dels = adds = 0;
+                for (size_t i = 0; i < result.count; i++) {
+                    dels += result.lines[i].op == '-';
+                    adds += result.lines[i].op == '+';
+                }
+                vault_diff_free(&result);
+            }
+            printf("%-6s %-10zu %-10s %12.2f %10zu %10zu\n", move ? "move" : "edit",
+                   lines, algorithms[a].name, best, dels, adds);
+        }
+
+        free(old_buf.data);
+        free(new_buf.data);
+    }
+    return 0;
+}
@@ -0,0 +1,536 @@
+/*
+ * ============================================================================
+ *  bench_e2e.c — Uçtan Uca Komut Ölçümleri
+ * ============================================================================
+ *
+ *  Tohuma (seed) bağlı, her çalıştırmada aynı olan sentetik bir repo üretir
+ *  ve vault ikilisini ayrı süreçler hâlinde çalıştırarak komutları ölçer:
+ *
+ *    init, add (tüm ağaç), commit   → bir kez
+ *    add_incremental, commit_incremental
+ *                                   → geçmiş oluşturulurken her commit'te
+ *    log, status_clean, checkout    → temiz ağaçta (checkout ilk commit'e)
+ *    status_dirty, diff             → dosyaların churn%'i değiştirilip
+ *                                     bir o kadar yeni dosya eklendikten sonra
+ *
+ *  Tekrarlanan komutlar önce bir kez ısınma için çalıştırılır (untracked
+ *  cache, sayfa önbelleği); her biri için medyan duvar süresine sahip
+ *  çalıştırmanın değerleri raporlanır.
+ *
+ *  Çıktı stdout'a JSON'dur: duvar süresi, kullanıcı/sistem CPU süresi ve
+ *  tepe RSS (wait4), read/write ailesi sistem çağrısı sayıları
+ *  (/proc/<pid>/io: syscr, syscw; yoksa null), bağlam değişimleri ve
+ *  sayfa hataları.
+ *
+ *  Üretici:
+ *    --files N        dosya sayısı
+ *    --min-size B     en küçük dosya (byte)
+ *    --max-size B     en büyük dosya; boyutlar log-düzgün dağılır (çoğu
+ *                     küçük, az sayıda büyük dosya)
+ *    --depth D        en fazla dizin derinliği (dizin başına ~16 dosya)
+ *    --commits H      geçmiş uzunluğu
+ *    --churn P        commit / kirli ağaç başına değişen dosya yüzdesi
+ *    --runs R         tekrarlanan komutların çalıştırılma sayısı
+ *    --seed S
+ *    --dir PATH       çalışma dizini (varsayılan: $TMPDIR altında geçici)
+ *    --keep           çalışma dizinini silme
+ *
+ *  Kullanım: make bench   (veya ./build/bench_e2e [./vault] [seçenekler])
+ * ============================================================================
+ */
+
+#define _GNU_SOURCE         /* wait4, WNOWAIT, nftw */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <ftw.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+#define BENCH_FILES_PER_DIR  16
+#define BENCH_MAX_SAMPLES    256
+#define BENCH_MAX_OPS        16
+
+typedef struct {
+    size_t   files;
+    size_t   min_size;
+    size_t   max_size;
+    size_t   depth;
+    size_t   commits;
+    size_t   churn;
+    size_t   runs;
+    uint64_t seed;
+    const char *dir;
+    int      keep;
+} BenchParams;
+
+/* Tek bir vault çalıştırması */
+typedef struct {
+    double    wall_ms;
+    double    user_ms;
+    double    sys_ms;
+    long      max_rss_kb;
+    long long syscr;            /* -1 = ölçülemedi */
+    long long syscw;
+    long      nvcsw;
+    long      nivcsw;
+    long      minflt;
+    long      majflt;
+} Sample;
+
+typedef struct {
+    const char *name;
+    Sample      samples[BENCH_MAX_SAMPLES];
+    size_t      count;
+} Op;
+
+typedef struct {
+    char       vault[4096];     /* mutlak yol: komutlar çalışma dizininde koşar */
+    char     **paths;           /* üretilen dosyalar */
+    size_t     path_count;
+    size_t     path_cap;
+    size_t     dir_count;
+    uint64_t   bytes;
+    uint64_t   rng;
+    Op         ops[BENCH_MAX_OPS];
+    size_t     op_count;
+} Bench;
+
+static void die(const char *what){
+    fprintf(stderr, "bench_e2e: %s: %s\n", what, strerror(errno));
+    exit(1);
+}
+
+/* ---- Sentetik repo ------------------------------------------------------ */
+
+/* xorshift64*: libc'den bağımsız, her platformda aynı dizi */
+static uint64_t rng_next(uint64_t *s){
+    *s ^= *s >> 12;
+    *s ^= *s << 25;
+    *s ^= *s >> 27;
+    return *s * 0x2545F4914F6CDD1DULL;
+}
+
+static size_t rng_below(uint64_t *s, size_t n){
+    return n ? (size_t)(rng_next(s) % n) : 0;
+}
+
+/* [min, max] aralığında log-düzgün boyut: önce 2'nin kuvveti, sonra içinde düzgün */
+static size_t gen_size(uint64_t *s, size_t min, size_t max){
+    size_t buckets = 0;
+    while ((min << (buckets + 1)) <= max)
+        buckets++;
+    size_t lo = min << rng_below(s, buckets + 1);
+    size_t hi = lo * 2 < max ? lo * 2 : max;
+    return lo + rng_below(s, hi - lo + 1);
+}
+
+/* Kaynak koda benzer satırlar: diff ve sıkıştırma gerçekçi davranır */
+static size_t gen_line(uint64_t *s, char *out, size_t size){
+    static const char *words[] = {
+        "if", "return", "err", "VAULT_OK", "size_t", "i", "count", "path",
+        "free", "(", ")", "{", "}", ";", "0", "1", "->", "idx", "entries",
+        "const", "char", "*", "=", "+", "while", "len", "buf", "NULL",
+    };
+    size_t len = 4 * rng_below(s, 3);
+    memset(out, ' ', len);
+    size_t n = 1 + rng_below(s, 10);
+    for (size_t i = 0; i < n && len + 16 < size; i++) {
+        const char *w = words[rng_below(s, sizeof(words) / sizeof(words[0]))];
+        len += (size_t)snprintf(out + len, size - len, i ? " %s" : "%s", w);
+    }
+    out[len++] = '\n';
+    return len;
+}
+
+static void write_file(Bench *b, const char *path, size_t size){
+    FILE *fp = fopen(path, "wb");
+    if (!fp)
+        die(path);
+    char line[128];
+    for (size_t written = 0; written < size; ) {
+        size_t len = gen_line(&b->rng, line, sizeof(line));
+        if (len > size - written)
+            len = size - written;
+        fwrite(line, 1, len, fp);
+        written += len;
+    }
+    if (fclose(fp) != 0)
+        die(path);
+    b->bytes += size;
+}
+
+static void add_path(Bench *b, const char *path){
+    if (b->path_count == b->path_cap) {
+        b->path_cap = b->path_cap ? b->path_cap * 2 : 256;
+        if (!(b->paths = realloc(b->paths, b->path_cap * sizeof(*b->paths))))
+            die("realloc");
+    }
+    if (!(b->paths[b->path_count++] = strdup(path)))
+        die("strdup");
+}
+
+/* Dizin ağacı ve dosyalar; dizin i'nin ebeveyni her zaman i'den küçüktür */
+static char **gen_tree(Bench *b, const BenchParams *p){
+    size_t dirs = p->depth ? p->files / BENCH_FILES_PER_DIR + 1 : 1;
+    char **names = calloc(dirs, sizeof(*names));
+    size_t *depth = calloc(dirs, sizeof(*depth));
+    if (!names || !depth || !(names[0] = strdup("")))
+        die("calloc");
+
+    for (size_t d = 1; d < dirs; d++) {
+        size_t parent = rng_below(&b->rng, d);
+        while (depth[parent] >= p->depth)
+            parent = 0;
+        depth[d] = depth[parent] + 1;
+        size_t len = strlen(names[parent]) + 16;
+        if (!(names[d] = malloc(len)))
+            die("malloc");
+        snprintf(names[d], len, "%sd%03zu/", names[parent], d);
+        if (mkdir(names[d], 0755) != 0)
+            die(names[d]);
+    }
+    b->dir_count = dirs;
+    free(depth);
+
+    static const char *exts[] = { ".c", ".h", ".md", ".txt" };
+    for (size_t i = 0; i < p->files; i++) {
+        char path[4096];
+        snprintf(path, sizeof(path), "%sf%05zu%s", names[rng_below(&b->rng, dirs)], i,
+                 exts[rng_below(&b->rng, 4)]);
+        write_file(b, path, gen_size(&b->rng, p->min_size, p->max_size));
+        add_path(b, path);
+    }
+    return names;
+}
+
+/* Dosyanın rastgele bir yerine bir satır yazar ve sonuna bir satır ekler */
+static void edit_file(Bench *b, const char *path){
+    FILE *fp = fopen(path, "r+b");
+    if (!fp)
+        die(path);
+    struct stat st;
+    char line[128];
+    if (fstat(fileno(fp), &st) != 0)
+        die(path);
+    size_t len = gen_line(&b->rng, line, sizeof(line));
+    if ((size_t)st.st_size > len) {
+        fseek(fp, (long)rng_below(&b->rng, (size_t)st.st_size - len), SEEK_SET);
+        fwrite(line, 1, len, fp);
+    }
+    fseek(fp, 0, SEEK_END);
+    len = gen_line(&b->rng, line, sizeof(line));
+    fwrite(line, 1, len, fp);
+    if (fclose(fp) != 0)
+        die(path);
+}
+
+/* churn%: var olan dosyaların bir kısmını değiştirir, bir o kadar yeni dosya ekler */
+static void churn(Bench *b, const BenchParams *p, char **dirs, size_t round){
+    size_t n = p->files * p->churn / 100;
+    if (n == 0)
+        n = 1;
+    for (size_t i = 0; i < n; i++)
+        edit_file(b, b->paths[rng_below(&b->rng, b->path_count)]);
+    for (size_t i = 0; i < n; i++) {
+        char path[4096];
+        snprintf(path, sizeof(path), "%sn%03zu_%05zu.c", dirs[rng_below(&b->rng, b->dir_count)],
+                 round, i);
+        write_file(b, path, gen_size(&b->rng, p->min_size, p->max_size));
+        add_path(b, path);
+    }
+}
+
+/* ---- Ölçüm -------------------------------------------------------------- */
+
+static double now_ms(void){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+static double tv_ms(struct timeval tv){
+    return tv.tv_sec * 1e3 + tv.tv_usec / 1e3;
+}
+
+/* Süreç reap edilmeden önce (zombi) /proc/<pid>/io okunur */
+static void read_proc_io(pid_t pid, Sample *s){
+    char path[64], line[128];
+    s->syscr = s->syscw = -1;
+    snprintf(path, sizeof(path), "/proc/%d/io", (int)pid);
+    FILE *fp = fopen(path, "r");
+    if (!fp)
+        return;
+    while (fgets(line, sizeof(line), fp)) {
+        sscanf(line, "syscr: %lld", &s->syscr);
+        sscanf(line, "syscw: %lld", &s->syscw);
+    }
+    fclose(fp);
+}
+
+/* argv'yi vault ile çalıştırır; çıktısı atılır. Başarısızsa çıkar. */
+static void run_vault(const Bench *b, Sample *s, const char *const *args){
+    const char *argv[8] = { b->vault };
+    for (size_t i = 0; args[i] && i + 2 < sizeof(argv) / sizeof(argv[0]); i++)
+        argv[i + 1] = args[i];
+
+    double start = now_ms();
+    pid_t pid = fork();
+    if (pid < 0)
+        die("fork");
+    if (pid == 0) {
+        int null = open("/dev/null", O_WRONLY);
+        if (null >= 0) {
+            dup2(null, STDOUT_FILENO);
+            dup2(null, STDERR_FILENO);
+        }
+        execv(b->vault, (char *const *)argv);
+        _exit(127);
+    }
+
+    siginfo_t info;
+    if (waitid(P_PID, (id_t)pid, &info, WEXITED | WNOWAIT) != 0)
+        die("waitid");
+    s->wall_ms = now_ms() - start;
+    read_proc_io(pid, s);
+
+    int status;
+    struct rusage ru;
+    if (wait4(pid, &status, 0, &ru) < 0)
+        die("wait4");
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        fprintf(stderr, "bench_e2e: vault");
+        for (size_t i = 0; args[i]; i++)
+            fprintf(stderr, " %s", args[i]);
+        fprintf(stderr, " failed (status %d)\n", status);
+        exit(1);
+    }
+    s->user_ms    = tv_ms(ru.ru_utime);
+    s->sys_ms     = tv_ms(ru.ru_stime);
+    s->max_rss_kb = ru.ru_maxrss;
+    s->nvcsw      = ru.ru_nvcsw;
+    s->nivcsw     = ru.ru_nivcsw;
+    s->minflt     = ru.ru_minflt;
+    s->majflt     = ru.ru_majflt;
+}
+
+static Op *op_get(Bench *b, const char *name){
+    for (size_t i = 0; i < b->op_count; i++)
+        if (strcmp(b->ops[i].name, name) == 0)
+            return &b->ops[i];
+    Op *op = &b->ops[b->op_count++];
+    op->name = name;
+    return op;
+}
+
+/* Bir kez çalıştırıp name altına kaydeder */
+static void measure(Bench *b, const char *name, const char *const *args){
+    Op *op = op_get(b, name);
+    if (op->count < BENCH_MAX_SAMPLES)
+        run_vault(b, &op->samples[op->count++], args);
+    else
+        run_vault(b, &(Sample){ 0 }, args);
+}
+
+/* Isınma çalıştırması + runs ölçüm */
+static void measure_repeated(Bench *b, const BenchParams *p, const char *name,
+                             const char *const *args){
+    Sample warm;
+    run_vault(b, &warm, args);
+    for (size_t i = 0; i < p->runs; i++)
+        measure(b, name, args);
+}
+
+static int sample_cmp(const void *a, const void *b){
+    double x = ((const Sample *)a)->wall_ms, y = ((const Sample *)b)->wall_ms;
+    return (x > y) - (x < y);
+}
+
+static void print_count(const char *key, long long value, int last){
+    if (value < 0)
+        printf("      \"%s\": null%s\n", key, last ? "" : ",");
+    else
+        printf("      \"%s\": %lld%s\n", key, value, last ? "" : ",");
+}
+
+static void print_json(Bench *b, const BenchParams *p){
+    printf("{\n");
+    printf("  \"benchmark\": \"vault-e2e\",\n");
+    printf("  \"vault\": \"%s\",\n", b->vault);
+    printf("  \"cpus\": %ld,\n", sysconf(_SC_NPROCESSORS_ONLN));
+    printf("  \"params\": { \"files\": %zu, \"min_size\": %zu, \"max_size\": %zu, "
+           "\"depth\": %zu, \"commits\": %zu, \"churn_percent\": %zu, \"runs\": %zu, "
+           "\"seed\": %llu },\n", p->files, p->min_size, p->max_size, p->depth,
+           p->commits, p->churn, p->runs, (unsigned long long)p->seed);
+    printf("  \"repo\": { \"files\": %zu, \"dirs\": %zu, \"bytes\": %llu },\n",
+           b->path_count, b->dir_count, (unsigned long long)b->bytes);
+    printf("  \"ops\": [\n");
+    for (size_t i = 0; i < b->op_count; i++) {
+        Op *op = &b->ops[i];
+        qsort(op->samples, op->count, sizeof(*op->samples), sample_cmp);
+        const Sample *m = &op->samples[op->count / 2];
+        printf("    {\n");
+        printf("      \"name\": \"%s\",\n", op->name);
+        printf("      \"runs\": %zu,\n", op->count);
+        printf("      \"wall_ms\": %.3f,\n", m->wall_ms);
+        printf("      \"wall_ms_min\": %.3f,\n", op->samples[0].wall_ms);
+        printf("      \"wall_ms_max\": %.3f,\n", op->samples[op->count - 1].wall_ms);
+        printf("      \"user_ms\": %.3f,\n", m->user_ms);
+        printf("      \"sys_ms\": %.3f,\n", m->sys_ms);
+        printf("      \"cpu_ms\": %.3f,\n", m->user_ms + m->sys_ms);
+        printf("      \"max_rss_kb\": %ld,\n", m->max_rss_kb);
+        print_count("read_syscalls", m->syscr, 0);
+        print_count("write_syscalls", m->syscw, 0);
+        print_count("voluntary_ctx_switches", m->nvcsw, 0);
+        print_count("involuntary_ctx_switches", m->nivcsw, 0);
+        print_count("minor_faults", m->minflt, 0);
+        print_count("major_faults", m->majflt, 1);
+        printf("    }%s\n", i + 1 < b->op_count ? "," : "");
+    }
+    printf("  ]\n");
+    printf("}\n");
+}
+
+/* ---- Senaryo ------------------------------------------------------------ */
+
+static int remove_entry(const char *path, const struct stat *st, int flag, struct FTW *ftw){
+    (void)st;
+    (void)flag;
+    (void)ftw;
+    return remove(path);
+}
+
+static void read_head(char *out, size_t size){
+    FILE *fp = fopen(".vault/HEAD", "r");
+    if (!fp || !fgets(out, (int)size, fp))
+        die(".vault/HEAD");
+    fclose(fp);
+    out[strcspn(out, "\r\n")] = '\0';
+}
+
+static void parse_args(int argc, char **argv, BenchParams *p, Bench *b){
+    static const struct {
+        const char *name;
+        size_t      offset;
+    } sizes[] = {
+        { "--files",    offsetof(BenchParams, files)    },
+        { "--min-size", offsetof(BenchParams, min_size) },
+        { "--max-size", offsetof(BenchParams, max_size) },
+        { "--depth",    offsetof(BenchParams, depth)    },
+        { "--commits",  offsetof(BenchParams, commits)  },
+        { "--churn",    offsetof(BenchParams, churn)    },
+        { "--runs",     offsetof(BenchParams, runs)     },
+    };
+    const char *vault = "./vault";
+    for (int i = 1; i < argc; i++) {
+        size_t s;
+        for (s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+            if (strcmp(argv[i], sizes[s].name) == 0 && i + 1 < argc)
+                break;
+        if (s < sizeof(sizes) / sizeof(sizes[0])) {
+            *(size_t *)((char *)p + sizes[s].offset) = strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            p->seed = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--dir") == 0 && i + 1 < argc) {
+            p->dir = argv[++i];
+        } else if (strcmp(argv[i], "--keep") == 0) {
+            p->keep = 1;
+        } else if (argv[i][0] != '-') {
+            vault = argv[i];
+        } else {
+            fprintf(stderr, "usage: bench_e2e [vault] [--files N] [--min-size B] "
+                            "[--max-size B] [--depth D] [--commits H] [--churn P] "
+                            "[--runs R] [--seed S] [--dir PATH] [--keep]\n");
+            exit(2);
+        }
+    }
+    if (p->min_size == 0)
+        p->min_size = 1;
+    if (p->max_size < p->min_size)
+        p->max_size = p->min_size;
+    if (p->commits == 0)
+        p->commits = 1;
+    if (p->runs == 0)
+        p->runs = 1;
+    if (p->runs > BENCH_MAX_SAMPLES)
+        p->runs = BENCH_MAX_SAMPLES;
+    if (!realpath(vault, b->vault))
+        die(vault);
+}
+
+int main(int argc, char **argv){
+    BenchParams p = {
+        .files = 2000, .min_size = 128, .max_size = 64 * 1024, .depth = 4,
+        .commits = 10, .churn = 2, .runs = 5, .seed = 1,
+    };
+    static Bench b;
+    parse_args(argc, argv, &p, &b);
+    b.rng = p.seed * 0x9E3779B97F4A7C15ULL + 1;     /* sıfır durum olmasın */
+
+    char dir[4096];
+    if (p.dir) {
+        snprintf(dir, sizeof(dir), "%s", p.dir);
+        if (mkdir(dir, 0755) != 0)
+            die(dir);
+    } else {
+        const char *tmp = getenv("TMPDIR");
+        snprintf(dir, sizeof(dir), "%s/vault-bench-XXXXXX", tmp && *tmp ? tmp : "/tmp");
+        if (!mkdtemp(dir))
+            die(dir);
+    }
+    if (chdir(dir) != 0)
+        die(dir);
+
+    char **dirs = gen_tree(&b, &p);
+
+    measure(&b, "init", (const char *[]){ "init", NULL });
+    measure(&b, "add", (const char *[]){ "add", ".", NULL });
+    measure(&b, "commit", (const char *[]){ "commit", "-m", "bench 0", NULL });
+    char first[128], tip[128];
+    read_head(first, sizeof(first));
+
+    for (size_t h = 1; h < p.commits; h++) {
+        char message[32];
+        snprintf(message, sizeof(message), "bench %zu", h);
+        churn(&b, &p, dirs, h);
+        measure(&b, "add_incremental", (const char *[]){ "add", ".", NULL });
+        measure(&b, "commit_incremental", (const char *[]){ "commit", "-m", message, NULL });
+    }
+    read_head(tip, sizeof(tip));
+
+    measure_repeated(&b, &p, "log", (const char *[]){ "log", NULL });
+    measure_repeated(&b, &p, "status_clean", (const char *[]){ "status", NULL });
+    if (p.commits > 1) {
+        for (size_t i = 0; i < p.runs; i++) {
+            measure(&b, "checkout", (const char *[]){ "checkout", first, NULL });
+            Sample back;
+            run_vault(&b, &back, (const char *[]){ "checkout", tip, NULL });
+        }
+    }
+
+    churn(&b, &p, dirs, p.commits);
+    measure_repeated(&b, &p, "status_dirty", (const char *[]){ "status", NULL });
+    measure_repeated(&b, &p, "diff", (const char *[]){ "diff", NULL });
+
+    print_json(&b, &p);
+
+    if (chdir("/") != 0)
+        die("/");
+    if (!p.keep && nftw(dir, remove_entry, 64, FTW_DEPTH | FTW_PHYS) != 0)
+        die(dir);
+    for (size_t i = 0; i < b.dir_count; i++)
+        free(dirs[i]);
+    free(dirs);
+    for (size_t i = 0; i < b.path_count; i++)
+        free(b.paths[i]);
+    free(b.paths);
+    return 0;
+}
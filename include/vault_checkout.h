@@ -0,0 +1,78 @@
+/*
+ * ============================================================================
+ *  vault_checkout.h — Çalışma Dizinini Bir Tree'ye Getirme
+ * ============================================================================
+ *
+ *  Checkout, çalışma dizinini temizleyip hedef tree'deki her blob'u yeniden
+ *  yazmaz. Mevcut HEAD'in tree'si ile hedef tree arasında vault_tree_diff
+ *  çalıştırılır ve yalnızca değişen yollar silinir, oluşturulur ya da
+ *  üzerine yazılır. Üç dosyası farklı iki commit arasında geçiş üç dosya
+ *  yazar; diğer dosyaların mtime'ları (editörler, build sistemleri) ve
+ *  index'teki stat bilgileri (stat cache) olduğu gibi kalır.
+ *
+ *  İlk checkout gibi çok dosyalı durumlarda yazma paraleldir: bir işçi
+ *  havuzu blob'ları açıp dosyaları aynı anda yazar. Dizinler önceden, sırayla
+ *  oluşturulur; işçiler mkdir için yarışmaz. Aynı anda açık olan blob
+ *  byte'ları VAULT_CHECKOUT_INFLIGHT_LIMIT ile sınırlıdır, böylece büyük
+ *  ağaçlarda bellek kullanımı iş parçacığı sayısıyla değil bütçeyle ölçeklenir.
+ *  VAULT_INDEX_STREAM_THRESHOLD'dan büyük blob'lar belleğe alınmaz,
+ *  vault_object_read_fd ile parça parça geçici dosyaya açılır.
+ *
+ *  Bağımlılık: vault_index.h, vault_tree.h, pthread
+ * ============================================================================
+ */
+
+#ifndef VAULT_CHECKOUT_H
+#define VAULT_CHECKOUT_H
+
+#include "vault_index.h"
+
+/* Aynı anda açık (inflate edilmiş) blob byte'larının üst sınırı. Akışla
+ * yazılan büyük blob'lar yalnızca VAULT_CHECKOUT_STREAM_COST sayılır. */
+#define VAULT_CHECKOUT_INFLIGHT_LIMIT  (64u * 1024 * 1024)
+#define VAULT_CHECKOUT_STREAM_COST     (2u * VAULT_STREAM_CHUNK)
+
+/* ---- Veri Yapıları ------------------------------------------------------ */
+
+typedef struct {
+    size_t written;     /* Oluşturulan ya da üzerine yazılan dosya sayısı */
+    size_t removed;     /* Silinen dosya sayısı */
+} VaultCheckoutStats;
+
+/* ---- Checkout ----------------------------------------------------------- */
+
+/*
+ * vault_checkout_tree:
+ *   Çalışma dizinini ve index'i from_tree'den to_tree'ye taşır.
+ *
+ *   İşlem sırası:
+ *     1. vault_tree_diff ile değişen dosyalar toplanır.
+ *     2. Eklenecek bir yolda takip edilmeyen bir dosya varsa hiçbir şeye
+ *        dokunulmadan hata dönülür.
+ *     3. Silinenler silinir ve index'ten çıkarılır; boşalan dizinler
+ *        kaldırılır.
+ *     4. Yazılacak dosyaların üst dizinleri ağaç sırasında oluşturulur.
+ *     5. Eklenen / değişen dosyalar 'jobs' iş parçacığında atomik olarak
+ *        (geçici dosya + rename) yazılır.
+ *     6. Index girişleri tek iş parçacığında vault_index_update ile
+ *        güncellenir. Yazılamayan dosyalar raporlanır ve index'te eski
+ *        hâlinde kalır; diğerleri yine de yazılır.
+ *
+ *   Index yerinde güncellenir ama diske yazılmaz; HEAD'e dokunulmaz. İkisi
+ *   de çağıranın işidir. Çalışma dizininin from_tree ile uyumlu olduğu
+ *   (kaydedilmemiş değişiklik olmadığı) varsayılır.
+ *
+ *   Parametreler:
+ *     idx       → from_tree ile eşleşen index (yerinde güncellenir)
+ *     from_tree → Mevcut root tree (ilk checkout'ta sıfır oid)
+ *     to_tree   → Hedef root tree
+ *     jobs      → İş parçacığı sayısı (<= 0 ise çekirdek sayısı)
+ *     stats     → Yazılan / silinen dosya sayıları (çıktı, NULL olabilir)
+ *
+ *   Dönüş: VAULT_OK veya hata kodu
+ */
+VaultError vault_checkout_tree(VaultIndex *idx, const VaultOid *from_tree,
+                               const VaultOid *to_tree, int jobs,
+                               VaultCheckoutStats *stats);
+
+#endif /* VAULT_CHECKOUT_H */
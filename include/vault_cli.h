@@ -9,13 +9,15 @@
  *
  *  Desteklenen komutlar:
  *    vault init                     → Yeni repo oluştur
- *    vault add <dosya>              → Dosyayı staging'e ekle
+ *    vault add <dosya|dizin>        → Dosyayı staging'e ekle
  *    vault commit -m "mesaj"        → Commit oluştur
  *    vault log                      → Commit geçmişini göster
  *    vault status                   → Değişiklikleri listele
  *    vault checkout <hash>          → Eski commit'e dön
  *    vault diff <dosya>             → Dosya farklarını göster
  *    vault diff <hash1> <hash2>     → İki commit arası farklar
+ *    vault repack                   → Loose nesneleri tek pack'te topla
+ *    vault fsmonitor start|stop|run → Dosya sistemi izleyicisi
  *
  *  Bağımlılık: vault_objects.h, vault_index.h
  * ============================================================================
@@ -41,10 +43,22 @@ typedef enum {
     VAULT_CMD_STATUS,       /* vault status */
     VAULT_CMD_CHECKOUT,     /* vault checkout <hash> */
     VAULT_CMD_DIFF,         /* vault diff ... */
+    VAULT_CMD_REPACK,       /* vault repack */
+    VAULT_CMD_FSMONITOR,    /* vault fsmonitor start|stop|run */
     VAULT_CMD_HELP,         /* vault help */
     VAULT_CMD_UNKNOWN       /* Tanınmayan komut */
 } VaultCommand;
 
+/*
+ * vault diff'in satır eşleştirme algoritması (--diff-algorithm=...).
+ * Ayrıntılar için bkz. vault_diff_compute_with.
+ */
+typedef enum {
+    VAULT_DIFF_MYERS,       /* Varsayılan: minimal fark (maliyet tavanıyla) */
+    VAULT_DIFF_PATIENCE,    /* Tekil satır çapaları */
+    VAULT_DIFF_HISTOGRAM    /* En seyrek ortak satırlar */
+} VaultDiffAlgorithm;
+
 /* ---- Parsed Argümanlar -------------------------------------------------- */
 
 /*
@@ -66,6 +80,8 @@ typedef struct {
     char        **targets;          /* Dosya yolları veya hash'ler listesi */
     int           target_cnt;       /* targets dizisindeki eleman sayısı */
     int           verbose;          /* -v flag'i: ayrıntılı çıktı */
+    int           jobs;             /* -j N: iş parçacığı sayısı (0 = çekirdek sayısı) */
+    VaultDiffAlgorithm diff_algorithm; /* --diff-algorithm=myers|patience|histogram */
 } VaultArgs;
 
 /* ---- CLI Parser --------------------------------------------------------- */
@@ -114,6 +130,13 @@ VaultError vault_cmd_init(const VaultArgs *args);
  *   Her target dosya için vault_index_add() çağırır.
  *   Dosya bulunamazsa hata mesajı yazdırır ama diğer dosyalara devam eder.
  *
+ *   Dosyalar vault_index_add_batch() ile -j N iş parçacığında paralel
+ *   işlenir (varsayılan: çekirdek sayısı); çıktı yine verilen sıradadır.
+ *
+ *   Hedef bir dizinse ("vault add ." dahil) vault_status ile taranır:
+ *   altındaki değişmiş ve izlenmeyen dosyalar eklenir, silinmiş olanlar
+ *   index'ten çıkarılır ("removed: <dosya>").
+ *
  *   Örnek çıktı:
  *     $ vault add src/main.c README.md
  *     added: src/main.c
@@ -139,7 +162,9 @@ VaultError vault_cmd_commit(const VaultArgs *args);
 /*
  * vault_cmd_log:
  *   Commit geçmişini ters kronolojik sırayla gösterir.
- *   HEAD'den başlayıp parent zincirini takip eder.
+ *   HEAD'den başlayıp parent zincirini takip eder. Zincir .vault/commit-graph
+ *   üzerinden izlenir (bkz. vault_graph.h); grafikte olmayan commit'lerde
+ *   parent commit nesnesinden okunur.
  *
  *   Çıktı formatı:
  *     commit a1b2c3d4e5f6...
@@ -167,6 +192,8 @@ VaultError vault_cmd_log(const VaultArgs *args);
  *
  *     Untracked files:
  *       new_file.c
+ *
+ *   fsmonitor token'ı ya da untracked cache değiştiyse index kaydedilir.
  */
 VaultError vault_cmd_status(const VaultArgs *args);
 
@@ -178,11 +205,12 @@ VaultError vault_cmd_status(const VaultArgs *args);
  *
  *   İşlem sırası:
  *     1. Hedef commit'i oku → tree hash'ini al
- *     2. Tree'yi recursive olarak çöz
- *     3. Çalışma dizinindeki mevcut dosyaları temizle
- *     4. Tree'deki blob'ları dosya olarak geri yaz
- *     5. Index'i güncelle
- *     6. HEAD'i güncelle
+ *     2. HEAD'in tree'si ile hedef tree'yi karşılaştır (vault_tree_diff)
+ *     3. Yalnızca değişen yolları sil / oluştur / üzerine yaz
+ *        (bkz. vault_checkout_tree); dokunulmayan dosyalar yerinde kalır.
+ *        Blob'lar -j N iş parçacığında paralel açılıp yazılır
+ *     4. Index'i yerinde güncelle: değişmeyen dosyaların stat bilgisi korunur
+ *     5. HEAD'i güncelle
  *
  *   Güvenlik: Kaydedilmemiş değişiklik varsa uyarı ver!
  *     "Error: uncommitted changes. Commit or discard them first."
@@ -193,11 +221,17 @@ VaultError vault_cmd_checkout(const VaultArgs *args);
  * vault_cmd_diff:
  *   İki versiyon arasındaki farkları gösterir.
  *
- *   Kullanım 1: vault diff <dosya>
+ *   Kullanım 1: vault diff [<dosya>...]
  *     → Dosyanın mevcut hali ile index'teki hali arasındaki fark
+ *       (dosya verilmezse index'te değişmiş tüm dosyalar)
+ *
+ *   --diff-algorithm=myers|patience|histogram satır eşleştirme algoritmasını
+ *   seçer (varsayılan myers, bkz. vault_diff_compute_with).
  *
  *   Kullanım 2: vault diff <hash1> <hash2>
- *     → İki commit arasındaki farklar
+ *     → İki commit (ya da tree) arasındaki farklar. Tree'ler
+ *       vault_tree_diff ile gezilir: aynı alt dizinler atlanır, yalnızca
+ *       değişen dosyaların blob'ları okunur.
  *
  *   Çıktı formatı (basitleştirilmiş diff):
  *     --- a/src/main.c
@@ -210,10 +244,44 @@ VaultError vault_cmd_checkout(const VaultArgs *args);
  */
 VaultError vault_cmd_diff(const VaultArgs *args);
 
+/*
+ * vault_cmd_repack:
+ *   Tüm loose nesneleri tek bir pack dosyasına toplar (bkz. vault_pack.h).
+ *
+ *   Örnek çıktı:
+ *     $ vault repack
+ *     packed 1532 objects
+ */
+VaultError vault_cmd_repack(const VaultArgs *args);
+
+/*
+ * vault_cmd_fsmonitor:
+ *   Dosya sistemi izleyicisini yönetir (bkz. vault_fsmonitor.h).
+ *
+ *     vault fsmonitor start → arka planda başlat
+ *     vault fsmonitor stop  → durdur
+ *     vault fsmonitor run   → ön planda çalıştır (Ctrl-C ile durur)
+ *
+ *   Daemon çalışırken vault status yalnızca değişen yollara bakar.
+ */
+VaultError vault_cmd_fsmonitor(const VaultArgs *args);
+
 /* ---- Diff Engine (Dahili) ----------------------------------------------- */
 
+/* Hunk başına değişikliğin önünde ve arkasında gösterilen ortak satır sayısı */
+#define VAULT_DIFF_CONTEXT   3
+
+/* Myers aramasının bölme başına en düşük maliyet tavanı (bkz. vault_diff_compute) */
+#define VAULT_DIFF_COST_MIN  256
+
+/* Histogram: eski tarafta bundan sık geçen satırlar çapa adayı olmaz */
+#define VAULT_DIFF_HISTOGRAM_MAX_CHAIN  64
+
 /*
  * DiffLine: Diff çıktısındaki tek bir satırı temsil eder.
+ * Metin kopyalanmaz: text, vault_diff_compute'a verilen eski veya yeni
+ * tampondaki satırın başına işaret eder, NUL ile bitmez ve '\n' içermez.
+ * Tamponlar DiffResult kullanıldığı sürece yaşamalıdır.
  *
  * op değerleri:
  *   ' ' → Değişmeyen satır (context)
@@ -222,7 +290,8 @@ VaultError vault_cmd_diff(const VaultArgs *args);
  */
 typedef struct {
     char  op;           /* '+', '-', veya ' ' */
-    char *text;         /* Satır içeriği */
+    const char *text;   /* Satırın kaynak tampondaki başı */
+    size_t len;         /* Satır uzunluğu ('\n' hariç) */
     int   line_old;     /* Eski dosyadaki satır numarası (-1 ise yeni satır) */
     int   line_new;     /* Yeni dosyadaki satır numarası (-1 ise silinen satır) */
 } DiffLine;
@@ -235,15 +304,31 @@ typedef struct {
 
 /*
  * vault_diff_compute:
- *   İki metin arasındaki farkları hesaplar.
- *   Basit bir LCS (Longest Common Subsequence) algoritması kullanılabilir.
+ *   İki metin arasındaki farkları satır bazında hesaplar.
+ *
+ *   Girdiler önce satırlara ayrılır: her satır için kaynak tampondaki konum,
+ *   uzunluk, hash ve denklik id'si tutulur. Aynı içerikli satırlar aynı id'yi
+ *   alır; algoritma yalnızca id'leri karşılaştırır.
+ *
+ *   Algoritma Myers'ın O(ND) farkıdır, doğrusal bellekli haliyle: orta yılan
+ *   bulunur, problem ikiye bölünür. N x M tablo yoktur; bellek O(N + M).
+ *   Ortak baş ve son satırlar önce kırpılır, böylece büyük ve çoğu aynı
+ *   dosyalarda arama yalnızca değişen bölgede yapılır.
+ *
+ *   Bir bölmede maliyet yaklaşık sqrt(N + M) (en az VAULT_DIFF_COST_MIN)
+ *   adımı aşarsa en çok ilerlenen köşegende bölünür. Sonuç bu durumda
+ *   minimal olmayabilir ama her zaman doğru bir farktır ve süre sınırlı kalır.
+ *
+ *   result tüm satırları sırayla içerir (ortak satırlar ' ' ile); hunk'lara
+ *   ayırmak vault_diff_print'in işidir.
  *
  *   Parametreler:
  *     old_text  → Eski dosya içeriği
  *     old_size  → Eski dosya boyutu
  *     new_text  → Yeni dosya içeriği
  *     new_size  → Yeni dosya boyutu
- *     result    → Diff sonucu (çıktı, çağıran free etmeli)
+ *     result    → Diff sonucu (çıktı, çağıran free etmeli). Satırlar
+ *                 old_text/new_text'e işaret eder.
  *
  *   Dönüş: VAULT_OK veya hata kodu
  */
@@ -251,10 +336,31 @@ VaultError vault_diff_compute(const char *old_text, size_t old_size,
                               const char *new_text, size_t new_size,
                               DiffResult *result);
 
+/*
+ * vault_diff_compute_with:
+ *   vault_diff_compute ile aynı, algoritma seçilebilir. Tokenizer, ortak
+ *   baş/son kırpma ve sonuç formatı tüm algoritmalarda ortaktır.
+ *
+ *   VAULT_DIFF_PATIENCE: İki tarafta da tam bir kez geçen satırlardan en
+ *     uzun artan alt dizi çapa olarak seçilir; çapalar arasındaki her parça
+ *     bağımsız olarak aynı yolla çözülür. Çapası olmayan parça Myers'a düşer.
+ *   VAULT_DIFF_HISTOGRAM: Eski taraftaki geçiş sayılarıyla en seyrek ortak
+ *     bölge bulunur ve problem onun iki yanına bölünür. Süslü parantez, boş
+ *     satır gibi çok tekrarlanan satırlar çapa olmaz; sonuç hem daha
+ *     okunaklı hem de bu tür dosyalarda genellikle daha hızlıdır.
+ *
+ *   Dönüş: VAULT_OK veya hata kodu
+ */
+VaultError vault_diff_compute_with(const char *old_text, size_t old_size,
+                                   const char *new_text, size_t new_size,
+                                   VaultDiffAlgorithm algorithm,
+                                   DiffResult *result);
+
 /*
  * vault_diff_print:
- *   DiffResult'ı terminale formatlanmış şekilde yazdırır.
- *   (Yeşil/kırmızı ANSI renkleri opsiyonel bonus)
+ *   DiffResult'ı unified formatta yazdırır: değişiklikler VAULT_DIFF_CONTEXT
+ *   satırlık bağlamla hunk'lara gruplanır. Değişiklik yoksa hiçbir şey
+ *   yazılmaz.
  */
 void vault_diff_print(const DiffResult *result,
                       const char *old_path, const char *new_path);
@@ -282,6 +388,8 @@ void vault_diff_free(DiffResult *result);
  *       status     Show working directory status
  *       checkout   Restore a previous commit
  *       diff       Show differences between versions
+ *       repack     Pack loose objects into a single pack file
+ *       fsmonitor  Start or stop the file system monitor daemon
  */
 void vault_cmd_help(void);
 
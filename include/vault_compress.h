@@ -0,0 +1,124 @@
+/*
+ * ============================================================================
+ *  vault_compress.h — Nesne Sıkıştırma (Codec'ler)
+ * ============================================================================
+ *
+ *  Loose nesneler eskiden her zaman varsayılan seviyede zlib ile
+ *  sıkıştırılıyordu. PNG, zip, jar gibi zaten sıkıştırılmış dosyalarda bu
+ *  hiçbir kazanç olmadan CPU harcar. Artık codec ve seviye repo başına
+ *  .vault/config'ten seçilir (bkz. vault_config.h):
+ *
+ *      [core]
+ *          codec = zlib            # zlib (varsayılan) | zstd | none
+ *          compression = 6         # -1 = codec varsayılanı, 0 = sıkıştırma yok
+ *
+ *  zstd yalnızca derleme sırasında <zstd.h> bulunduysa vardır
+ *  (VAULT_HAVE_ZSTD); yoksa "codec = zstd" uyarıyla zlib'e düşer.
+ *
+ *  Loose nesne dosyası, codec'i belirten iki byte'lık bir başlıkla başlar:
+ *
+ *      'V' | codec (u8) | sıkıştırılmış ("<tip> <boyut>\0" + içerik)
+ *
+ *  'V' (0x56) geçerli bir zlib akışının ilk byte'ı olamaz (CM != 8); bu
+ *  başlık olmayan dosyalar eski biçimdir ve zlib olarak okunur. Okuyucular
+ *  codec'leri karışık bir nesne dizinini şeffaf olarak okur.
+ *
+ *  Sıkıştırılamazlık sondası: blob'lar sıkıştırılmadan önce içerikten
+ *  alınan küçük örnekler hızlı zlib ile denenir; kazanç
+ *  VAULT_COMPRESS_MIN_GAIN yüzdesinin altındaysa blob ham (none) saklanır.
+ *
+ *  Bağımlılık: zlib, isteğe bağlı libzstd
+ * ============================================================================
+ */
+
+#ifndef VAULT_COMPRESS_H
+#define VAULT_COMPRESS_H
+
+#include "vault_objects.h"
+
+#define VAULT_LOOSE_MAGIC  'V'
+
+typedef enum {
+    VAULT_CODEC_NONE = 0,       /* Ham: sıkıştırma yok */
+    VAULT_CODEC_ZLIB = 1,
+    VAULT_CODEC_ZSTD = 2
+} VaultCodec;
+
+/* Sonda: bu boyuttan küçük blob'lar sınanmadan sıkıştırılır */
+#define VAULT_COMPRESS_PROBE_MIN     4096
+/* Sonda: baştan, ortadan ve sondan alınan örneklerin her biri */
+#define VAULT_COMPRESS_PROBE_SLICE   4096
+/* Sıkıştırma örnekte en az bu kadar yüzde kazandırmalı */
+#define VAULT_COMPRESS_MIN_GAIN      5
+
+typedef struct {
+    VaultCodec codec;
+    int        level;           /* Codec'e özgü; -1 = varsayılan */
+} VaultCompressSettings;
+
+/* Sıkıştırılmış çıktının gittiği yer (ör. geçici dosya) */
+typedef VaultError (*VaultCompressSink)(const uint8_t *data, size_t size, void *ctx);
+
+typedef struct VaultCompressor   VaultCompressor;
+typedef struct VaultDecompressor VaultDecompressor;
+
+/* ---- Ayarlar ------------------------------------------------------------ */
+
+/*
+ * vault_compress_settings:
+ *   core.codec ve core.compression ayarlarını döner (süreç başına bir kez
+ *   okunur). core.compression = 0 ya da codec = none → VAULT_CODEC_NONE.
+ */
+void vault_compress_settings(VaultCompressSettings *out);
+
+/*
+ * vault_codec_available:
+ *   Bu derlemede codec okunup yazılabiliyor mu? (zstd derlemeye bağlı)
+ */
+int vault_codec_available(VaultCodec codec);
+
+/*
+ * vault_compress_probe:
+ *   İçerik sıkıştırmaya değmeyecek kadar rastgele mi? Baştan, ortadan ve
+ *   sondan VAULT_COMPRESS_PROBE_SLICE'lık örnekler en hızlı zlib seviyesiyle
+ *   sıkıştırılır; kazanç VAULT_COMPRESS_MIN_GAIN yüzdesinin altındaysa 1.
+ *   VAULT_COMPRESS_PROBE_MIN'den küçük içerik için her zaman 0.
+ */
+int vault_compress_probe(const uint8_t *data, size_t size);
+
+/* ---- Sıkıştırma (akış) -------------------------------------------------- */
+
+/*
+ * vault_compressor_open:
+ *   Verilen codec ve seviyede bir sıkıştırıcı açar. Üretilen her çıktı
+ *   parçası sink'e verilir; sink hata dönerse write / finish o hatayı döner.
+ */
+VaultError vault_compressor_open(VaultCompressor **out, VaultCodec codec, int level,
+                                 VaultCompressSink sink, void *ctx);
+
+VaultError vault_compressor_write(VaultCompressor *c, const uint8_t *data, size_t size);
+
+/* Akışı kapatır (son çıktı sink'e gider); sıkıştırıcıyı serbest bırakmaz */
+VaultError vault_compressor_finish(VaultCompressor *c);
+
+void vault_compressor_free(VaultCompressor *c);
+
+/* ---- Açma (akış) -------------------------------------------------------- */
+
+VaultError vault_decompressor_open(VaultDecompressor **out, VaultCodec codec);
+
+/*
+ * vault_decompressor_run:
+ *   *in'deki girdiden *out'a açar; ikisini de tüketilen / üretilen kadar
+ *   ilerletir (*in_size / *out_size kalanları gösterir). Çıktı dolunca ya
+ *   da girdi bitince döner. Sıkıştırılmış akış bittiğinde *done = 1.
+ *
+ *   Dönüş: VAULT_OK, bozuk veride VAULT_ERR_CORRUPT
+ */
+VaultError vault_decompressor_run(VaultDecompressor *d,
+                                  const uint8_t **in, size_t *in_size,
+                                  uint8_t **out, size_t *out_size, int *done);
+
+void vault_decompressor_free(VaultDecompressor *d);
+
+#endif /* VAULT_COMPRESS_H */
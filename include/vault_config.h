@@ -0,0 +1,53 @@
+/*
+ * ============================================================================
+ *  vault_config.h — Repo Ayarları (.vault/config)
+ * ============================================================================
+ *
+ *  Repo'ya özel ayarlar .vault/config dosyasında, Git'in config dosyasına
+ *  benzer basit bir biçimde tutulur:
+ *
+ *      # yorum
+ *      [core]
+ *          compression = 1
+ *          codec = zstd
+ *
+ *  Anahtarlar "bölüm.isim" olarak sorulur (ör. "core.codec"); bölüm ve
+ *  isim büyük/küçük harf duyarsızdır, değerin başındaki / sonundaki
+ *  boşluklar atılır. Dosya yoksa tüm ayarlar varsayılandır.
+ *
+ *  Dosya süreç başına bir kez, ilk sorguda okunur.
+ *
+ *  Bağımlılık: yok
+ * ============================================================================
+ */
+
+#ifndef VAULT_CONFIG_H
+#define VAULT_CONFIG_H
+
+#define VAULT_CONFIG_FILE  ".vault/config"
+
+/*
+ * vault_config_get:
+ *   Anahtarın değerini döner; ayar yoksa NULL. Aynı anahtar birden fazla
+ *   kez yazılmışsa sonuncusu geçerlidir. Dönen string süreç boyunca
+ *   geçerlidir, değiştirilmemeli.
+ *
+ *   Örnek:
+ *     const char *codec = vault_config_get("core.codec");
+ */
+const char *vault_config_get(const char *key);
+
+/*
+ * vault_config_get_int:
+ *   Anahtarın tamsayı değeri; ayar yoksa ya da sayı değilse fallback.
+ */
+int vault_config_get_int(const char *key, int fallback);
+
+/*
+ * vault_config_get_bool:
+ *   true/yes/on/1 → 1, false/no/off/0 → 0; ayar yoksa ya da bunlardan
+ *   biri değilse fallback.
+ */
+int vault_config_get_bool(const char *key, int fallback);
+
+#endif /* VAULT_CONFIG_H */
@@ -0,0 +1,59 @@
+/*
+ * ============================================================================
+ *  vault_delta.h — Delta Kodlama (Pack İçi Sıkıştırma)
+ * ============================================================================
+ *
+ *  Takip edilen dosyalar commit'ten commit'e birkaç satır değişir. Her
+ *  versiyonu tam olarak saklamak yerine, pack içinde bir nesneyi başka bir
+ *  nesneye (base) göre "kopyala / ekle" talimatları olarak saklarız.
+ *
+ *  Delta formatı (Git'teki ile aynı mantık):
+ *    [base boyutu: varint][sonuç boyutu: varint] ardından talimatlar:
+ *
+ *      1xxxxxxx  → KOPYALA: base'den (offset, uzunluk) aralığını kopyala.
+ *                  Alt 4 bit hangi offset byte'larının, sonraki 3 bit hangi
+ *                  uzunluk byte'larının geldiğini söyler (little-endian).
+ *                  Uzunluk 0 ise 0x10000 kabul edilir.
+ *      0nnnnnnn  → EKLE: ardından gelen n (1..127) byte'ı olduğu gibi yaz.
+ *
+ *  Bağımlılık: vault_objects.h (yalnızca VaultError için)
+ * ============================================================================
+ */
+
+#ifndef VAULT_DELTA_H
+#define VAULT_DELTA_H
+
+#include "vault_objects.h"
+
+/*
+ * vault_delta_create:
+ *   target'ı base'e göre ifade eden bir delta üretir.
+ *
+ *   Parametreler:
+ *     base, base_size     → Referans alınan nesne
+ *     target, target_size → Delta'sı çıkarılacak nesne
+ *     max_size            → Delta bu boyutu aşarsa vazgeçilir (0 = sınırsız)
+ *     out_delta           → Delta verisi (malloc, ÇAĞIRAN free() YAPMALI)
+ *     out_size            → Delta boyutu
+ *
+ *   Dönüş: VAULT_OK, delta max_size'ı aşarsa VAULT_ERR_NOTFOUND,
+ *          bellek yetmezse VAULT_ERR_NOMEM
+ */
+VaultError vault_delta_create(const uint8_t *base, size_t base_size,
+                              const uint8_t *target, size_t target_size,
+                              size_t max_size,
+                              uint8_t **out_delta, size_t *out_size);
+
+/*
+ * vault_delta_apply:
+ *   Delta'yı base'e uygulayıp hedef nesneyi yeniden oluşturur.
+ *   Sonuç buffer'ı sonuna '\0' eklenmiş olarak ayrılır (vault_object_read
+ *   ile aynı sözleşme).
+ *
+ *   Dönüş: VAULT_OK, delta bozuksa VAULT_ERR_CORRUPT
+ */
+VaultError vault_delta_apply(const uint8_t *base, size_t base_size,
+                             const uint8_t *delta, size_t delta_size,
+                             uint8_t **out_data, size_t *out_size);
+
+#endif /* VAULT_DELTA_H */
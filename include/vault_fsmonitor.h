@@ -0,0 +1,100 @@
+/*
+ * ============================================================================
+ *  vault_fsmonitor.h — Dosya Sistemi İzleyicisi (vault fsmonitor)
+ * ============================================================================
+ *
+ *  vault_status her çağrıda takip edilen her dosyayı lstat() eder; on
+ *  binlerce dosyalı bir çalışma dizininde hiçbir şey değişmemişken bile bu
+ *  iş dosya sayısıyla büyür. İsteğe bağlı "vault fsmonitor" daemon'u
+ *  çalışma dizinini inotify ile izler ve değişen yolları bellekte tutar;
+ *  status yalnızca bunlara bakar:
+ *
+ *    vault fsmonitor start   → daemon'u arka planda başlat
+ *    vault fsmonitor run     → ön planda çalıştır (hata ayıklama)
+ *    vault fsmonitor stop    → daemon'u durdur
+ *
+ *  Daemon .vault/fsmonitor.sock Unix soketinden sorgulanır. Her cevap bir
+ *  token taşır; index bu token'ı (FSMN eklentisi) ve "son status'ta temiz
+ *  bulundu" bitlerini saklar. Sonraki status "<token>'dan beri ne değişti"
+ *  diye sorar, yalnızca dönen yolları ve biti düşük kayıtları inceler.
+ *
+ *  Protokol (satır sonu '\n'):
+ *    istek  "query <token>"  → "ok <yeni token>" ve ardından NUL ile biten
+ *                              yollar, ya da "full <yeni token>"
+ *           "stop"           → "ok"
+ *    '/' ile biten yol bir dizindir: altındaki her şey değişmiş sayılır.
+ *
+ *  "full" cevabı: token başka bir daemon örneğine ya da eski bir döneme
+ *  (epoch) ait, inotify kuyruğu taştı (IN_Q_OVERFLOW), değişen yol sayısı
+ *  VAULT_FSMONITOR_MAX_PATHS'i aştı ya da bir dizin izlemeye alınamadı.
+ *  Çağıran o zaman tam taramaya düşer; daemon hiç yoksa da aynısı olur.
+ *
+ *  Yarış: daemon cevaplamadan önce .vault'ta bir "cookie" dosyası yaratıp
+ *  onun olayını görene kadar kuyruğu işler. Böylece sorgudan önce yapılmış
+ *  her değişiklik cevapta yer alır; sonrakiler bir sonraki token'a kalır.
+ *
+ *  .vault/config'te "fsmonitor = false" ([core]) soketi hiç sormaz.
+ *  Daemon Linux'a özgüdür (inotify); başka sistemlerde status hep tam
+ *  tarama yapar.
+ *
+ *  Bağımlılık: vault_objects.h, vault_config.h
+ * ============================================================================
+ */
+
+#ifndef VAULT_FSMONITOR_H
+#define VAULT_FSMONITOR_H
+
+#include "vault_objects.h"
+
+#define VAULT_FSMONITOR_SOCKET      ".vault/fsmonitor.sock"
+
+/* Token'ın en uzun hali (NUL dahil) */
+#define VAULT_FSMONITOR_TOKEN_MAX   64
+
+/* Daemon bundan fazla değişen yol biriktirirse dönemi kapatır ("full") */
+#define VAULT_FSMONITOR_MAX_PATHS   (1u << 20)
+
+/* İstemcinin cevap için bekleyeceği süre (ms); aşılırsa tam tarama */
+#define VAULT_FSMONITOR_TIMEOUT_MS  2000
+
+/*
+ * VaultFsmonitorChanges: Bir sorgunun cevabı.
+ *   full = 1 ise paths boştur ve çağıran her şeye bakmalıdır; token yine
+ *   de geçerlidir (bir sonraki sorgu ondan itibaren sorar).
+ */
+typedef struct {
+    char         token[VAULT_FSMONITOR_TOKEN_MAX];
+    int          full;
+    const char **paths;         /* buf'ın içini gösterir */
+    size_t       count;
+    char        *buf;
+} VaultFsmonitorChanges;
+
+/*
+ * vault_fsmonitor_query:
+ *   since token'ından ("" = ilk sorgu) beri değişen yolları sorar.
+ *
+ *   Dönüş: VAULT_OK, daemon yoksa (ya da core.fsmonitor = false)
+ *          VAULT_ERR_NOTFOUND, zaman aşımı / bozuk cevapta VAULT_ERR_IO
+ */
+VaultError vault_fsmonitor_query(const char *since, VaultFsmonitorChanges *out);
+
+void vault_fsmonitor_changes_free(VaultFsmonitorChanges *changes);
+
+/*
+ * vault_fsmonitor_run:
+ *   Daemon'u bu süreçte çalıştırır (repo kökünde çağrılmalı). detach = 1
+ *   ise önce arka plana geçer; çağıran, soket cevap verene kadar bekler.
+ *   Aynı repoda çalışan bir daemon varsa VAULT_ERR_IO döner.
+ */
+VaultError vault_fsmonitor_run(int detach);
+
+/*
+ * vault_fsmonitor_stop:
+ *   Çalışan daemon'a durmasını söyler.
+ *
+ *   Dönüş: VAULT_OK, daemon yoksa VAULT_ERR_NOTFOUND
+ */
+VaultError vault_fsmonitor_stop(void);
+
+#endif /* VAULT_FSMONITOR_H */
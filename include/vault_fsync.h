@@ -0,0 +1,78 @@
+/*
+ * ============================================================================
+ *  vault_fsync.h — Yazma Kalıcılığı (core.fsync)
+ * ============================================================================
+ *
+ *  Nesneler, index, HEAD ve pack'ler "geçici dosya → rename()" ile atomik
+ *  yazılır. Atomiklik yarım dosyayı engeller ama kalıcılığı sağlamaz: fsync
+ *  olmadan bir çökme sonrası HEAD diske inmiş, işaret ettiği nesneler
+ *  inmemiş olabilir. Her nesneyi tek tek fsync etmek ise binlerce dosyalı
+ *  bir commit'i dakikalara çıkarır. Mod .vault/config'ten seçilir:
+ *
+ *      [core]
+ *          fsync = batch           # none | per-object | batch (varsayılan)
+ *
+ *    none        → fsync yok (eski davranış; en hızlı, çökmede veri kaybı)
+ *    per-object  → her dosya rename'den önce, hedef dizini rename'den sonra
+ *                  fsync edilir
+ *    batch       → dosyalar fsync'siz yazılır; kalıcılık gereken noktada
+ *                  (HEAD / index yazılmadan, repack eski nesneleri silmeden
+ *                  önce) tek bir syncfs() bekleyen her şeyi diske indirir
+ *
+ *  Sıralama kuralı: HEAD ve index, işaret ettikleri nesneler kalıcı olduktan
+ *  sonra yazılır. vault_head_write bu yüzden önce bir bariyer çağırır, HEAD'i
+ *  yazar, sonra kendisi için bir bariyer daha çağırır; bir commit'in maliyeti
+ *  nesne sayısından bağımsız olarak iki syncfs()'tir.
+ *
+ *  syncfs() Linux'a özgüdür; başka sistemlerde bariyer sync() kullanır.
+ *
+ *  Bağımlılık: vault_config.h
+ * ============================================================================
+ */
+
+#ifndef VAULT_FSYNC_H
+#define VAULT_FSYNC_H
+
+#include "vault_objects.h"
+
+typedef enum {
+    VAULT_FSYNC_NONE,
+    VAULT_FSYNC_PER_OBJECT,
+    VAULT_FSYNC_BATCH
+} VaultFsyncMode;
+
+/*
+ * vault_fsync_mode:
+ *   core.fsync ayarı (süreç başına bir kez okunur). Bilinmeyen değer uyarıyla
+ *   varsayılana (batch) düşer.
+ */
+VaultFsyncMode vault_fsync_mode(void);
+
+/*
+ * vault_fsync_file:
+ *   Yazılmış, henüz rename edilmemiş geçici dosya. per-object'te fsync eder,
+ *   batch'te bir sonraki bariyere bırakır. FILE* ile yazanlar önce fflush
+ *   etmeli.
+ *
+ *   Dönüş: VAULT_OK, fsync başarısızsa VAULT_ERR_IO
+ */
+VaultError vault_fsync_file(int fd);
+
+/*
+ * vault_fsync_dir:
+ *   İçine rename yapılmış dizin. per-object'te dizini fsync eder (yeni
+ *   giriş kalıcı olsun), batch'te bir sonraki bariyere bırakır.
+ */
+VaultError vault_fsync_dir(const char *dir);
+
+/*
+ * vault_fsync_barrier:
+ *   batch modunda bekleyen yazmalar varsa .vault'un bulunduğu dosya
+ *   sistemini tek çağrıda diske indirir. Diğer modlarda bir şey yapmaz
+ *   (per-object'te her şey zaten kalıcıdır).
+ *
+ *   Dönüş: VAULT_OK veya VAULT_ERR_IO
+ */
+VaultError vault_fsync_barrier(void);
+
+#endif /* VAULT_FSYNC_H */
@@ -0,0 +1,145 @@
+/*
+ * ============================================================================
+ *  vault_graph.h — Commit Grafiği (Geçmiş Gezinme Hızlandırıcısı)
+ * ============================================================================
+ *
+ *  "vault log" HEAD'den başlayıp her commit'i açarak (inflate +
+ *  vault_commit_deserialize) parent zincirini izler. 200 bin commit'lik bir
+ *  geçmişte bu, sadece sırayı bulmak için 200 bin dosya açma ve zlib akışı
+ *  demektir.
+ *
+ *  .vault/commit-graph dosyası commit'lerin yapısal bilgisini tek bir mmap
+ *  edilebilir dosyada tutar: sıralı commit id'leri, parent'ın dosyadaki
+ *  konumu, root tree, zaman damgası ve generation numarası. Parent'a geçmek
+ *  bir dizi indekslemesidir; nesne dosyalarına dokunulmaz.
+ *
+ *  Dosya formatı (tüm sayılar big-endian):
+ *
+ *    "VGPH" | versiyon (u32) | commit sayısı N (u32)
+ *    fanout[256] (u32)   → fanout[b] = ilk byte'ı <= b olan commit sayısı
+ *    oid[N][32]          → ham commit hash'leri, sıralı
+ *    Her commit için (oid ile aynı sırada, 48 byte):
+ *      root tree (32 byte) | parent konumu (u32) | generation (u32) |
+ *      zaman damgası (i64)
+ *    Sonda: önceki tüm byte'ların SHA-256'sı (32 byte)
+ *
+ *  Parent konumu yoksa VAULT_GRAPH_NO_PARENT'tır. Generation: kök commit 1,
+ *  diğerleri parent'ın generation'ı + 1.
+ *
+ *  Her commit'te bu dosyayı yeniden yazmak geçmişin boyutu kadar I/O ve
+ *  hash demektir. Yeni commit'ler bu yüzden önce ikinci bir katmana,
+ *  .vault/commit-graph-tip dosyasının sonuna eklenir:
+ *
+ *    "VGTP" | versiyon (u32) | taban dosyanın sondaki checksum'ı (32 byte)
+ *    Her commit için, eklenme sırasında (80 byte):
+ *      oid (32 byte) | root tree (32 byte) | parent konumu (u32) |
+ *      generation (u32) | zaman damgası (i64)
+ *
+ *  Uç katmandaki i. kaydın konumu taban commit sayısı + i'dir; parent'lar
+ *  her zaman kendinden önce eklendiğinden konumu kendininkinden küçüktür.
+ *  Checksum tabanla tutmayan uç katman (ör. birleştirme yarıda kaldıysa)
+ *  yok sayılır, sonda yarım kalmış kayıt atılır.
+ *
+ *  Uç katman VAULT_GRAPH_TIP_MIN kaydı ve taban boyutunun
+ *  1/VAULT_GRAPH_TIP_RATIO'sunu geçince iki katman tek bir tabana
+ *  birleştirilir; tabanın checksum'ı yalnızca bu sırada doğrulanır. Böylece
+ *  commit başına yeniden yazılan kayıt sayısı ortalamada sabittir.
+ *
+ *  vault_create_commit her yeni commit'ten sonra vault_graph_add'i çağırır.
+ *  Grafikte olmayan tarihçe (ör. dosya silinmişse) bir kez nesnelerden
+ *  okunup eklenir; sonraki commit'lerde yalnızca yeni commit eklenir.
+ *  Grafik bir hızlandırıcıdır: okuyucular grafikte olmayan commit'ler için
+ *  nesne dosyalarına düşer.
+ *
+ *  Bağımlılık: vault_objects.h
+ * ============================================================================
+ */
+
+#ifndef VAULT_GRAPH_H
+#define VAULT_GRAPH_H
+
+#include "vault_objects.h"
+
+/* ---- Sabitler ----------------------------------------------------------- */
+
+#define VAULT_GRAPH_FILE       ".vault/commit-graph"
+#define VAULT_GRAPH_TIP_FILE   ".vault/commit-graph-tip"
+#define VAULT_GRAPH_VERSION    1
+#define VAULT_GRAPH_NO_PARENT  0xffffffffu
+
+#define VAULT_GRAPH_TIP_MIN    64   /* birleştirmeden önce uçta en az kayıt */
+#define VAULT_GRAPH_TIP_RATIO  8    /* uç, tabanın 1/8'ini geçince birleştir */
+
+/* ---- Veri Yapıları ------------------------------------------------------ */
+
+/* Grafikteki tek bir commit'in çözülmüş hali */
+typedef struct {
+    VaultOid oid;
+    VaultOid tree;              /* Root tree */
+    uint32_t parent;            /* Parent'ın grafikteki konumu */
+    uint32_t generation;
+    long     timestamp;
+} VaultGraphCommit;
+
+/* mmap edilmiş .vault/commit-graph + .vault/commit-graph-tip */
+typedef struct {
+    const uint8_t  *map;
+    size_t          map_size;
+    uint32_t        count;          /* Toplam: taban + uç */
+    uint32_t        base_count;
+    const uint8_t  *fanout;
+    const uint8_t  *oids;
+    const uint8_t  *data;
+    const uint8_t  *tip_map;
+    size_t          tip_map_size;
+    const uint8_t  *tip;            /* Uç katmanın ilk kaydı */
+    const uint8_t **tip_sorted;     /* Uç kayıtları oid sırasında */
+} VaultCommitGraph;
+
+/* ---- Okuma -------------------------------------------------------------- */
+
+/*
+ * vault_graph_open:
+ *   Commit grafiğini (iki katmanı) mmap eder. Dosya yoksa count = 0 olan boş
+ *   bir grafik döner (hata değildir). Uç katman okunamazsa yalnızca taban
+ *   kullanılır.
+ *
+ *   Dönüş: VAULT_OK, başlık veya boyut tutarsızsa VAULT_ERR_CORRUPT
+ */
+VaultError vault_graph_open(VaultCommitGraph *graph);
+
+/*
+ * vault_graph_find:
+ *   Commit'in grafikteki konumunu bulur (fanout + binary search).
+ *
+ *   Dönüş: 1 = bulundu (*out_pos dolu), 0 = grafikte yok
+ */
+int vault_graph_find(const VaultCommitGraph *graph, const VaultOid *oid,
+                     uint32_t *out_pos);
+
+/*
+ * vault_graph_get:
+ *   pos konumundaki commit'i çözer.
+ *
+ *   Dönüş: VAULT_OK, konum veya parent konumu geçersizse VAULT_ERR_CORRUPT
+ */
+VaultError vault_graph_get(const VaultCommitGraph *graph, uint32_t pos,
+                           VaultGraphCommit *out_commit);
+
+void vault_graph_close(VaultCommitGraph *graph);
+
+/* ---- Yazma -------------------------------------------------------------- */
+
+/*
+ * vault_graph_add:
+ *   commit_oid'i ve grafikte henüz olmayan atalarını uç katmanın sonuna
+ *   ekler; yalnızca yeni commit'lerin nesneleri açılır, yalnızca yeni
+ *   kayıtlar yazılır. Uç katman sınırı geçince iki katman atomik olarak
+ *   (geçici dosya + rename) tek bir tabana birleştirilir. Tabanın sondaki
+ *   checksum'ı o sırada tutmuyorsa grafik baştan oluşturulur.
+ *
+ *   Dönüş: VAULT_OK veya hata kodu
+ */
+VaultError vault_graph_add(const VaultOid *commit_oid);
+
+#endif /* VAULT_GRAPH_H */
@@ -0,0 +1,86 @@
+/*
+ * ============================================================================
+ *  vault_ignore.h — .vaultignore Eşleyicisi
+ * ============================================================================
+ *
+ *  Çalışma dizinindeki herhangi bir dizinde bulunan .vaultignore dosyası,
+ *  o dizin ve altındaki yolların "izlenmeyen" olarak bildirilmesini
+ *  engeller. Biçim .gitignore ile aynıdır:
+ *
+ *      # yorum
+ *      *.o             → her dizinde .o ile biten dosya/dizinler
+ *      build/          → yalnızca dizinler (adı build olan her dizin)
+ *      /TODO           → yalnızca bu .vaultignore'un dizinindeki TODO
+ *      docs/index.html → '/' içeren kalıplar bu dizine göre çapalıdır
+ *      tmp-?.log       → '?' tek karakter, [a-z] sınıf
+ *      !keep.o         → önceki bir kuralla yoksayılanı geri alır
+ *
+ *  '*', '?' ve sınıflar '/' ile eşleşmez; [!x] olumsuz sınıf ve '\'
+ *  kaçışı desteklenir. '/' ile çevrili "**" sıfır ya da daha çok dizinle,
+ *  kalıbın sonundaki "**" o dizinin altındaki her şeyle eşleşir.
+ *
+ *  Aynı dosyada son eşleşen kural, farklı dosyalarda en derin dizindeki
+ *  dosya geçerlidir. Yoksayılan bir dizinin içine hiç girilmez; bu yüzden
+ *  altındaki bir yol '!' ile geri alınamaz.
+ *
+ *  Kurallar yüklenirken derlenir: joker içermeyen kalıplar doğrudan
+ *  karşılaştırılır, "*.ext" biçimindekiler yalnızca son ek kontrolüdür,
+ *  diğerlerinde jokerden önceki sabit önek eşleşmedikçe glob çalışmaz.
+ *
+ *  Yoksayma yalnızca izlenmeyen dosyaları etkiler; index'teki dosyalar
+ *  kalıplarla eşleşse de takip edilmeye devam eder.
+ *
+ *  Bağımlılık: vault_objects.h
+ * ============================================================================
+ */
+
+#ifndef VAULT_IGNORE_H
+#define VAULT_IGNORE_H
+
+#include "vault_objects.h"
+
+#define VAULT_IGNORE_FILE  ".vaultignore"
+
+/* Bir .vaultignore dosyasının derlenmiş kuralları */
+typedef struct VaultIgnore VaultIgnore;
+
+/*
+ * VaultIgnoreStack: Bir dizin için geçerli kural dosyaları zinciri.
+ *   En derin dizinin kuralları başta, parent köke doğru gider. Düğümler
+ *   değiştirilmez; alt dizinler üst dizinin zincirini paylaşır.
+ */
+typedef struct VaultIgnoreStack {
+    const struct VaultIgnoreStack *parent;
+    const VaultIgnore             *rules;
+} VaultIgnoreStack;
+
+/*
+ * vault_ignore_parse:
+ *   text'teki kuralları derler. base, dosyanın bulunduğu dizinin repo
+ *   köküne göreceli yoludur ('/' ile biter, "" = kök).
+ *
+ *   Dönüş: VAULT_OK (hiç kural yoksa *out = NULL) ya da VAULT_ERR_NOMEM
+ */
+VaultError vault_ignore_parse(const char *base, const char *text, size_t len,
+                              VaultIgnore **out);
+
+/*
+ * vault_ignore_load:
+ *   base dizinindeki .vaultignore'u okuyup derler.
+ *
+ *   Dönüş: VAULT_OK (dosya yoksa ya da boşsa *out = NULL), okuma
+ *          hatasında VAULT_ERR_IO
+ */
+VaultError vault_ignore_load(const char *base, VaultIgnore **out);
+
+void vault_ignore_free(VaultIgnore *ig);
+
+/*
+ * vault_ignore_match:
+ *   path (repo köküne göreceli, sonunda '/' yok) yoksayılıyorsa 1.
+ *   is_dir yolun dizin olup olmadığıdır ("build/" gibi kurallar için).
+ *   stack NULL olabilir. Thread-safe'tir.
+ */
+int vault_ignore_match(const VaultIgnoreStack *stack, const char *path, int is_dir);
+
+#endif /* VAULT_IGNORE_H */
@@ -13,7 +13,8 @@
  *    - Tree nesnelerini oluşturma (klasör yapısını tree'ye çevirme)
  *    - Commit nesnesi oluşturma ve parent zincirini yönetme
  *
- *  Bağımlılık: vault_objects.h (hash, read/write fonksiyonlarını kullanır)
+ *  Bağımlılık: vault_objects.h (hash, read/write fonksiyonlarını kullanır),
+ *              vault_fsmonitor.h
  * ============================================================================
  */
 
@@ -21,6 +22,7 @@
 #define VAULT_INDEX_H
 
 #include "vault_objects.h"
+#include "vault_fsmonitor.h"
 #include <time.h>
 
 /* ---- Sabitler ----------------------------------------------------------- */
@@ -29,6 +31,24 @@
 #define VAULT_HEAD_FILE   ".vault/HEAD"    /* Şu anki commit hash'ini tutar */
 #define VAULT_MAX_PATH    1024
 
+/* İkili index dosyasının başlığı */
+#define VAULT_INDEX_MAGIC    "VNDX"
+#define VAULT_INDEX_VERSION  2
+
+/*
+ * Bu boyuttan büyük dosyalar belleğe tek parça okunmaz; akış API'si
+ * (vault_object_stream_*) ile sabit bellekle blob'a dönüştürülür.
+ */
+#define VAULT_INDEX_STREAM_THRESHOLD  (8 * 1024 * 1024)
+
+/*
+ * vault_status'ta içeriği hash'lenmesi gereken (stat'ı değişmiş ya da racy)
+ * dosyalardan bu boyuta kadar olanlar VAULT_STATUS_HASH_BATCH'lik gruplar
+ * hâlinde okunup vault_hash_blob_many ile birlikte hash'lenir.
+ */
+#define VAULT_STATUS_HASH_BATCH     64
+#define VAULT_STATUS_HASH_MAX_FILE  (64 * 1024)
+
 /* ---- Veri Yapıları ------------------------------------------------------ */
 
 /*
@@ -41,24 +61,101 @@
  *   4. Bu struct'a dosya yolu ve hash kaydedilir
  *
  * Örnek:
- *   { .filepath = "src/main.c", .hash = "a1b2c3...", .mtime = 1719500000 }
+ *   { .filepath = "src/main.c", .hash = <a1b2c3...>, .mtime = 1719500000 }
+ *
+ * filepath sabit boyutlu bir dizi değil, bir işaretçidir: index diskten
+ * yüklendiyse doğrudan mmap edilmiş dosyanın içini gösterir (kopya yok),
+ * sonradan eklenen kayıtlarda ise index'e ait heap belleğini.
+ *
+ * Stat cache: mtime dışındaki stat alanları da saklanır. vault_status,
+ * lstat() sonucu bunlarla birebir aynıysa dosyayı yeniden hash'lemez.
+ *
+ * fsmonitor_valid: kayıt, index'teki fsmonitor token'ı alındıktan sonra
+ * temiz bulundu; daemon bu yolun değiştiğini bildirmedikçe lstat() bile
+ * edilmez (bkz. vault_fsmonitor.h). Stat bilgisi güncellenince düşer.
  */
 typedef struct {
-    char filepath[VAULT_MAX_PATH];      /* Dosyanın repo kökünden göreceli yolu */
-    char hash[VAULT_HASH_HEX_SIZE];     /* Dosyanın blob hash'i */
+    const char *filepath;               /* Dosyanın repo kökünden göreceli yolu */
+    VaultOid hash;                      /* Dosyanın blob hash'i */
     long mtime;                         /* Son değişiklik zamanı (cache için) */
+    long mtime_nsec;                    /* mtime'ın nanosaniye kısmı */
+    long ctime;                         /* inode değişiklik zamanı */
+    long ctime_nsec;
+    uint64_t size;                      /* Dosya boyutu (0 = "racy", bkz. vault_status) */
+    uint64_t ino;
+    uint64_t dev;
+    int fsmonitor_valid;
 } IndexEntry;
 
+/*
+ * IndexTreeNode: Cache-tree'de bir dizinin son yazılan tree hash'i.
+ *
+ * vault_build_tree her commit'te tüm alt-tree'leri yeniden serileştirip
+ * hash'lemek yerine geçerli (valid) düğümlerin hash'ini olduğu gibi kullanır.
+ * Bir dosya eklendiğinde/değiştiğinde/silindiğinde yolu üzerindeki tüm
+ * dizinlerin düğümleri geçersiz kılınır; commit yalnızca bu "kirli"
+ * dizinleri yeniden oluşturur.
+ *
+ * path her zaman '/' ile biter ("" = kök, "src/", "src/lib/"). Bu sayede
+ * düğümlerin byte sırası tree'lerin derinlik öncelikli (pre-order) sırasıyla
+ * aynıdır ve bir dizinin alt düğümleri dizide ardışık durur.
+ */
+typedef struct {
+    char    *path;             /* Dizin yolu (heap, index'e ait) */
+    VaultOid oid;              /* Dizinin tree hash'i */
+    int      valid;            /* 0 = geçersiz kılındı, yeniden oluşturulmalı */
+} IndexTreeNode;
+
+/*
+ * IndexUntrackedDir: Untracked cache'te bir dizinin son okunduğu haldeki
+ * stat bilgisi ve içinde bulunan izlenmeyen dosyalar ile alt dizinler.
+ *
+ * Dizinin mtime/ctime/ino/dev'i değişmediyse içine dosya eklenmemiş,
+ * silinmemiş ya da yeniden adlandırılmamıştır: vault_status readdir() ve
+ * dosya başına lstat() yerine names listesini kullanır. Listedeki dosyalar
+ * raporlanırken yine index'e bakılır (sonradan eklenmiş olabilir); index'ten
+ * çıkarılan bir dosya ise dizinini geçersiz kılar.
+ *
+ * path tree düğümleri gibi '/' ile biter ("" = kök). names NUL ile ayrılmış
+ * adlardır, readdir sonrası sıralandıkları düzende; alt dizin adları '/'
+ * ile biter.
+ */
+typedef struct {
+    char    *path;              /* Dizin yolu (heap, index'e ait) */
+    long     mtime;
+    long     mtime_nsec;
+    long     ctime;
+    long     ctime_nsec;
+    uint64_t ino;
+    uint64_t dev;
+    char    *names;             /* "a.txt\0sub/\0..." (heap) */
+    size_t   names_len;         /* names'in byte uzunluğu (son NUL dahil) */
+    int      valid;             /* 0 = geçersiz kılındı, yeniden okunmalı */
+} IndexUntrackedDir;
+
 /*
  * VaultIndex: Tüm staging area'yı temsil eder.
  * .vault/index dosyasının bellekteki hali.
  *
  * Dinamik dizi olarak yönetilir (tıpkı VaultTree gibi).
+ * entries her zaman filepath'e göre (byte sırası) sıralı tutulur;
+ * vault_index_find bu yüzden binary search yapar.
  */
 typedef struct {
-    IndexEntry *entries;    /* IndexEntry dizisi (dinamik) */
-    size_t      count;      /* Mevcut kayıt sayısı */
-    size_t      capacity;   /* Ayrılmış kapasite */
+    IndexEntry    *entries;    /* IndexEntry dizisi (dinamik, sıralı) */
+    size_t         count;      /* Mevcut kayıt sayısı */
+    size_t         capacity;   /* Ayrılmış kapasite */
+    const uint8_t *map;        /* mmap edilmiş .vault/index (yoksa NULL) */
+    size_t         map_size;
+    long           timestamp;       /* Yüklenen index dosyasının mtime'ı */
+    long           timestamp_nsec;
+    IndexTreeNode *tree_nodes;      /* Cache-tree, path'e göre sıralı */
+    size_t         tree_count;
+    char           fsmonitor_token[VAULT_FSMONITOR_TOKEN_MAX];  /* "" = yok */
+    int            fsmonitor_changed;   /* token ya da bitler değişti: kaydedilmeli */
+    IndexUntrackedDir *untracked_dirs;  /* Untracked cache, path'e göre sıralı */
+    size_t         untracked_count;
+    int            untracked_changed;   /* status dizin okudu: kaydedilmeli */
 } VaultIndex;
 
 /* ---- Index (Staging Area) Fonksiyonları --------------------------------- */
@@ -68,6 +165,9 @@ typedef struct {
  *   .vault/index dosyasını okuyup VaultIndex yapısına yükler.
  *   Dosya yoksa boş bir index döner (ilk kullanımda normal).
  *
+ *   Dosya mmap edilir ve sondaki checksum doğrulanır; kayıtların yolları
+ *   kopyalanmaz. vault_index_free çağrılana kadar map açık kalır.
+ *
  *   Parametreler:
  *     idx → Yüklenecek VaultIndex yapısı (çağıran oluşturur)
  *
@@ -85,12 +185,34 @@ VaultError vault_index_load(VaultIndex *idx);
  *   Bellekteki VaultIndex'i .vault/index dosyasına yazar.
  *   Atomik yazma kullanılmalı (geçici dosya → rename).
  *
- *   Index dosya formatı (her satır bir entry):
- *     "<hash> <mtime> <filepath>\n"
+ *   Index dosya formatı (ikili, tüm sayılar big-endian):
+ *     "VNDX" | versiyon (u32) | kayıt sayısı N (u32)
+ *     offset[N] (u32)    → her kaydın dosya içindeki konumu
+ *     Her kayıt (yola göre sıralı):
+ *       ham hash (32 byte)
+ *       mtime | mtime_nsec | ctime | ctime_nsec | size | ino | dev (i64/u64)
+ *       yol uzunluğu (u16) | yol | '\0'
+ *     Kayıtlardan sonra sıfır veya daha fazla eklenti:
+ *       imza (4 byte) | veri uzunluğu (u32) | veri
+ *       Bilinmeyen imzalı eklentiler atlanır.
+ *       "TREE" (cache-tree): düğüm sayısı (u32), her geçerli düğüm için
+ *         yol uzunluğu (u16) | yol | tree hash (32 byte)
+ *       "FSMN" (fsmonitor): token uzunluğu (u16) | token |
+ *         kayıt başına bir bit fsmonitor_valid ((N + 7) / 8 byte)
+ *       "UNTR" (untracked cache): dizin sayısı (u32), her dizin için
+ *         yol uzunluğu (u16) | yol | mtime | mtime_nsec | ctime |
+ *         ctime_nsec | ino | dev (i64/u64) | adların uzunluğu (u32) | adlar
+ *     Sonda: önceki tüm byte'ların SHA-256'sı (32 byte)
+ *
+ *   Yolların sonundaki '\0' sayesinde yükleme sırasında kopya yapılmaz;
+ *   IndexEntry.filepath doğrudan mmap'in içini gösterir.
  *
- *   Örnek dosya içeriği:
- *     a1b2c3d4e5... 1719500000 src/main.c
- *     f6a7b8c9d0... 1719500100 include/utils.h
+ *   Racy-clean koruması: mtime'ı yazma anıyla aynı zaman diliminde olan
+ *   kayıtların size alanı 0 olarak yazılır ("smudge"). Böylece dosya aynı
+ *   zaman diliminde tekrar değiştirilmişse bile vault_status onu stat
+ *   verisine güvenip atlamaz, içeriğini hash'ler.
+ *   Untracked cache'te de mtime'ı yazma anından eski olmayan dizinler
+ *   yazılmaz; sonraki status onları yeniden okur.
  */
 VaultError vault_index_save(const VaultIndex *idx);
 
@@ -104,6 +226,10 @@ VaultError vault_index_save(const VaultIndex *idx);
  *     3. vault_blob_write() ile blob olarak kaydet
  *     4. Index'te aynı filepath varsa güncelle, yoksa yeni entry ekle
  *
+ *   VAULT_INDEX_STREAM_THRESHOLD'dan büyük dosyalarda 1-3. adımlar
+ *   vault_object_stream_* ile parça parça yapılır; dosya hiçbir zaman
+ *   bütünüyle belleğe alınmaz.
+ *
  *   Parametreler:
  *     idx      → Güncellenecek index
  *     filepath → Eklenecek dosyanın yolu (repo köküne göreceli)
@@ -117,6 +243,42 @@ VaultError vault_index_save(const VaultIndex *idx);
  */
 VaultError vault_index_add(VaultIndex *idx, const char *filepath);
 
+/*
+ * vault_index_update:
+ *   İçeriğinin hash'i zaten bilinen bir dosyanın girişini ekler ya da
+ *   günceller (ör. checkout'un az önce yazdığı dosya). Dosya yeniden
+ *   okunmaz; yalnızca stat bilgisi diskten alınır.
+ *
+ *   Dönüş: VAULT_OK, dosya yoksa VAULT_ERR_NOTFOUND
+ */
+VaultError vault_index_update(VaultIndex *idx, const char *filepath, const VaultOid *oid);
+
+/*
+ * vault_index_add_batch:
+ *   Birden fazla dosyayı paralel olarak staging'e ekler.
+ *
+ *   Okuma, hash'leme, sıkıştırma ve atomik blob yazma işleri 'jobs' adet
+ *   iş parçacığına dağıtılır. Index güncellemesi ise hepsi bittikten sonra
+ *   tek iş parçacığında, filepaths sırasıyla yapılır; böylece .vault/index
+ *   iş parçacığı sayısından bağımsız olarak hep aynı çıkar.
+ *
+ *   Parametreler:
+ *     idx       → Güncellenecek index
+ *     filepaths → Eklenecek dosya yolları
+ *     count     → Dosya sayısı
+ *     jobs      → İş parçacığı sayısı (<= 0 ise çekirdek sayısı)
+ *     results   → Her dosyanın sonucu (count elemanlı, NULL olabilir)
+ *
+ *   Dönüş: Hepsi eklendiyse VAULT_OK, değilse ilk hatalı dosyanın kodu
+ *
+ *   Örnek:
+ *     VaultError res[2];
+ *     char *files[] = { "src/main.c", "README.md" };
+ *     vault_index_add_batch(&idx, files, 2, 0, res);
+ */
+VaultError vault_index_add_batch(VaultIndex *idx, char *const *filepaths,
+                                 size_t count, int jobs, VaultError *results);
+
 /*
  * vault_index_remove:
  *   Bir dosyayı staging area'dan çıkarır.
@@ -126,7 +288,7 @@ VaultError vault_index_remove(VaultIndex *idx, const char *filepath);
 
 /*
  * vault_index_find:
- *   Verilen dosya yolunun index'teki konumunu bulur.
+ *   Verilen dosya yolunun index'teki konumunu bulur (binary search).
  *
  *   Dönüş: Entry'nin index'teki pozisyonu, bulunamazsa -1
  */
@@ -159,14 +321,17 @@ int vault_index_find(const VaultIndex *idx, const char *filepath);
  *   Her alt-tree önce yazılır, hash'i alınır, üst tree'ye eklenir.
  *   Bu süreç özyinelemeli (recursive) olarak yapılır.
  *
+ *   Cache-tree'de geçerli düğümü olan dizinler yeniden oluşturulmaz, alt
+ *   ağaçlarına inilmez. Oluşturulan dizinlerin hash'leri cache-tree'ye
+ *   yazılır; kalıcı olması için çağıran index'i kaydetmelidir.
+ *
  *   Parametreler:
- *     idx           → Mevcut index (dosya listesi)
- *     out_tree_hash → Root tree'nin hash'i (çıktı)
+ *     idx           → Mevcut index (dosya listesi; cache-tree güncellenir)
+ *     out_tree_oid  → Root tree'nin hash'i (çıktı)
  *
  *   Dönüş: VAULT_OK veya hata kodu
  */
-VaultError vault_build_tree(const VaultIndex *idx,
-                            char out_tree_hash[VAULT_HASH_HEX_SIZE]);
+VaultError vault_build_tree(VaultIndex *idx, VaultOid *out_tree_oid);
 
 /* ---- Commit Oluşturma --------------------------------------------------- */
 
@@ -182,32 +347,33 @@ VaultError vault_build_tree(const VaultIndex *idx,
  *     5. HEAD dosyasını yeni commit hash'iyle güncelle
  *
  *   Parametreler:
- *     idx         → Mevcut staging area
+ *     idx         → Mevcut staging area (cache-tree'si güncellenir)
  *     author      → Yazar adı
  *     message     → Commit mesajı
- *     out_hash    → Yeni commit'in hash'i (çıktı)
+ *     out_oid     → Yeni commit'in hash'i (çıktı)
  *
  *   Dönüş: VAULT_OK veya hata kodu
  */
-VaultError vault_create_commit(const VaultIndex *idx,
+VaultError vault_create_commit(VaultIndex *idx,
                                const char *author,
                                const char *message,
-                               char out_hash[VAULT_HASH_HEX_SIZE]);
+                               VaultOid *out_oid);
 
 /* ---- HEAD Yönetimi ------------------------------------------------------ */
 
 /*
  * vault_head_read:
- *   .vault/HEAD dosyasından şu anki commit hash'ini okur.
- *   Eğer henüz hiç commit yapılmamışsa out_hash[0] = '\0' olur.
+ *   .vault/HEAD dosyasından şu anki commit hash'ini okur (dosyada hex).
+ *   Eğer henüz hiç commit yapılmamışsa out_oid sıfır oid olur
+ *   (bkz. vault_oid_is_null).
  */
-VaultError vault_head_read(char out_hash[VAULT_HASH_HEX_SIZE]);
+VaultError vault_head_read(VaultOid *out_oid);
 
 /*
  * vault_head_write:
- *   .vault/HEAD dosyasına yeni commit hash'ini yazar.
+ *   .vault/HEAD dosyasına yeni commit hash'ini hex olarak yazar.
  */
-VaultError vault_head_write(const char hash[VAULT_HASH_HEX_SIZE]);
+VaultError vault_head_write(const VaultOid *oid);
 
 /* ---- Değişiklik Tespiti ------------------------------------------------- */
 
@@ -219,8 +385,38 @@ VaultError vault_head_write(const char hash[VAULT_HASH_HEX_SIZE]);
  *     - Yeni dosyalar (index'te yok)
  *     - Silinmiş dosyalar (index'te var ama diskte yok)
  *
+ *   Stat cache: Takip edilen bir dosyanın lstat() sonucu (size, mtime,
+ *   ctime, inode, device) index'tekiyle aynıysa dosya okunmaz. Yalnızca
+ *   stat'ı farklı olan ya da "racy" olan dosyalar hash'lenir. Racy: dosyanın
+ *   mtime'ı index dosyasının yazıldığı andan eski değil; bu durumda aynı
+ *   zaman dilimi içinde yapılan bir değişiklik stat'a yansımamış olabilir.
+ *   Hash'lenecek küçük dosyalar gruplanıp çoklu akışta (AVX2 şeritleri)
+ *   hash'lenir; callback sırası yine index'in yol sırasıdır.
+ *
+ *   fsmonitor: daemon çalışıyorsa (bkz. vault_fsmonitor.h) index'teki
+ *   token'dan beri değişen yollar sorulur; fsmonitor_valid'i 1 olup
+ *   bildirilmeyen kayıtlar hiç incelenmez. Daemon yoksa, taştıysa ya da
+ *   token tanınmazsa her kayıt incelenir. Yeni token ve bitler idx'e
+ *   yazılır, fsmonitor_changed işaretlenir; kalıcı olması için çağıran
+ *   index'i kaydetmelidir.
+ *
+ *   Untracked cache: İzlenmeyen dosyalar aranırken stat bilgisi önbellekteki
+ *   ile aynı olan dizinler okunmaz; yalnızca alt dizinleri lstat() edilir.
+ *   Okunan dizinler önbelleğe yazılır ve untracked_changed işaretlenir.
+ *   .vault/config'te "untrackedcache = false" ([core]) önbelleği kapatır.
+ *
+ *   Çalışma dizini vault_walk ile paralel taranır (bkz. vault_walk.h); her
+ *   dizinin sıralı adları index'in o dizine düşen aralığıyla birleştirilir,
+ *   taramada lstat edilen izlenen dosyalar yeniden lstat edilmez. İşçi
+ *   sayısı "walkjobs" ([core]) ile ayarlanır (varsayılan: çekirdek sayısı).
+ *
+ *   .vaultignore: Kurallarla eşleşen izlenmeyen dosyalar bildirilmez,
+ *   eşleşen dizinlere hiç girilmez (bkz. vault_ignore.h). İzlenen
+ *   dosyalar eşleşse de 'M'/'D' olarak bildirilir.
+ *
  *   Parametreler:
- *     idx       → Mevcut index
+ *     idx       → Mevcut index (fsmonitor token'ı, bitleri ve untracked
+ *                 cache güncellenir)
  *     callback  → Her farklılık için çağrılacak fonksiyon
  *     user_data → Callback'e geçirilecek ek veri (NULL olabilir)
  *
@@ -232,7 +428,7 @@ VaultError vault_head_write(const char hash[VAULT_HASH_HEX_SIZE]);
 typedef void (*VaultStatusCallback)(const char *filepath, char status,
                                     void *ctx);
 
-VaultError vault_status(const VaultIndex *idx,
+VaultError vault_status(VaultIndex *idx,
                         VaultStatusCallback callback,
                         void *user_data);
 
@@ -240,7 +436,8 @@ VaultError vault_status(const VaultIndex *idx,
 
 /*
  * vault_index_free:
- *   Index yapısını temizler. entries dizisini free() eder.
+ *   Index yapısını temizler. entries dizisini ve index'e ait yolları
+ *   free() eder, mmap'i kapatır.
  */
 void vault_index_free(VaultIndex *idx);
 
@@ -9,8 +9,9 @@
  *
  *  Temel sorumluluklar:
  *    - SHA-256 hash üretimi
- *    - Blob/Tree/Commit nesnelerini diske yazma (zlib sıkıştırmalı)
- *    - Diskten okuma (zlib açma)
+ *    - Blob/Tree/Commit nesnelerini diske yazma (zlib / zstd / ham,
+ *      bkz. vault_compress.h)
+ *    - Diskten okuma (codec'i dosya başlığından tanıyarak açma)
  *    - .vault/objects/ dizin yapısını yönetme
  *
  *  Kullanılan kütüphaneler: OpenSSL (SHA-256), zlib (sıkıştırma)
@@ -22,23 +23,35 @@
 
 #include <stddef.h>  /* size_t için */
 #include <stdint.h>  /* uint8_t gibi sabit boyutlu tipler için */
+#include <string.h>  /* memcmp (inline oid karşılaştırmaları) */
 
 /* ---- Sabitler ----------------------------------------------------------- */
 
 /*
  * SHA-256 hash'i 64 hex karakter + '\0' = 65 byte.
- * Her yerde aynı boyutu kullanmak için sabitle tanımlıyoruz.
+ * Hex yalnızca sınırlarda kullanılır: CLI çıktısı, tree/commit metin
+ * formatları, HEAD dosyası ve loose nesne yolları.
  */
 #define VAULT_HASH_HEX_SIZE 65
 
+/*
+ * Aynı hash'in ham (binary) hali: 32 byte.
+ * Bellekte ve pack/index dosyalarında hash'ler bu şekilde tutulur.
+ */
+#define VAULT_HASH_RAW_SIZE 32
+
 /*
  * .vault dizini altındaki objects klasöründe hash'in ilk 2 karakteri
  * alt klasör ismi olarak kullanılır (Git'teki gibi).
  *   Örnek: hash = "a1b2c3d4..."
  *          Yol  = .vault/objects/a1/b2c3d4...
  */
+#define VAULT_DIR         ".vault"
 #define VAULT_OBJECTS_DIR ".vault/objects"
 
+/* Nesne/pack dosya yolları için yeterli buffer boyutu */
+#define VAULT_OBJECT_PATH_MAX 256
+
 /* ---- Nesne Tipleri ------------------------------------------------------ */
 
 /*
@@ -55,6 +68,42 @@ typedef enum {
     VAULT_OBJ_COMMIT
 } VaultObjectType;
 
+/* ---- Nesne Kimliği (Object ID) ----------------------------------------- */
+
+/*
+ * VaultOid: Bir nesnenin 32 byte'lık ham SHA-256 hash'i.
+ * Yapı içinde tutulduğu için atama ile kopyalanabilir; karşılaştırma ve
+ * hash tablosu anahtarı olarak kullanım hex dönüşümü gerektirmez.
+ *
+ * Tüm sıfır oid "yok" anlamına gelir (ör. ilk commit'in parent'ı).
+ */
+typedef struct {
+    uint8_t id[VAULT_HASH_RAW_SIZE];
+} VaultOid;
+
+static inline int vault_oid_cmp(const VaultOid *a, const VaultOid *b){
+    return memcmp(a->id, b->id, VAULT_HASH_RAW_SIZE);
+}
+
+static inline int vault_oid_equal(const VaultOid *a, const VaultOid *b){
+    return memcmp(a->id, b->id, VAULT_HASH_RAW_SIZE) == 0;
+}
+
+static inline int vault_oid_is_null(const VaultOid *oid){
+    static const VaultOid null_oid;
+    return memcmp(oid->id, null_oid.id, VAULT_HASH_RAW_SIZE) == 0;
+}
+
+static inline void vault_oid_clear(VaultOid *oid){
+    memset(oid->id, 0, VAULT_HASH_RAW_SIZE);
+}
+
+/* SHA-256 çıktısı düzgün dağılımlıdır: ilk 4 byte hash tablosu için yeterli */
+static inline uint32_t vault_oid_hash(const VaultOid *oid){
+    return ((uint32_t)oid->id[0] << 24) | ((uint32_t)oid->id[1] << 16) |
+           ((uint32_t)oid->id[2] << 8)  |  (uint32_t)oid->id[3];
+}
+
 /* ---- Veri Yapıları ------------------------------------------------------ */
 
 /*
@@ -64,7 +113,7 @@ typedef enum {
  *   VaultBlob blob;
  *   blob.data = dosya_icerigi;    // "hello world\n"
  *   blob.size = 12;
- *   blob_write(&blob, hash_out);  // → diske yazar, hash'i döner
+ *   blob_write(&blob, &oid);     // → diske yazar, hash'i döner
  */
 typedef struct {
     uint8_t *data;      /* Dosyanın ham byte içeriği */
@@ -76,8 +125,8 @@ typedef struct {
  * Bir klasördeki her dosya/alt-klasör için bir TreeEntry var.
  *
  * Örnek:
- *   { .mode = "100644", .name = "main.c", .hash = "a1b2c3..." }
- *   { .mode = "040000", .name = "src",    .hash = "d4e5f6..." }
+ *   { .mode = "100644", .name = "main.c", .hash = <a1b2c3...> }
+ *   { .mode = "040000", .name = "src",    .hash = <d4e5f6...> }
  *
  * mode değerleri:
  *   "100644" → normal dosya (blob)
@@ -86,7 +135,7 @@ typedef struct {
 typedef struct {
     char mode[8];                       /* Dosya modu: "100644" veya "040000" */
     char name[256];                     /* Dosya/klasör adı */
-    char hash[VAULT_HASH_HEX_SIZE];    /* Bu girişin işaret ettiği nesne hash'i */
+    VaultOid hash;                      /* Bu girişin işaret ettiği nesne */
 } VaultTreeEntry;
 
 /*
@@ -108,15 +157,15 @@ typedef struct {
  * Commit: Projenin belirli bir andaki tam durumunu kaydeder.
  *
  * Örnek:
- *   tree_hash   = "abc123..."   → root tree'nin hash'i
- *   parent_hash = "def456..."   → bir önceki commit (ilk commit'te boş)
+ *   tree_hash   = <abc123...>   → root tree'nin hash'i
+ *   parent_hash = <def456...>   → bir önceki commit (ilk commit'te sıfır oid)
  *   author      = "Arda"
  *   message     = "İlk commit: proje yapısı oluşturuldu"
  *   timestamp   = 1719500000    → Unix epoch zamanı
  */
 typedef struct {
-    char    tree_hash[VAULT_HASH_HEX_SIZE];     /* Root tree nesnesinin hash'i */
-    char    parent_hash[VAULT_HASH_HEX_SIZE];   /* Önceki commit hash (ilk commit'te "\0") */
+    VaultOid tree_hash;                          /* Root tree nesnesinin hash'i */
+    VaultOid parent_hash;                        /* Önceki commit (ilk commit'te sıfır) */
     char    author[128];                         /* Yazar adı */
     char    message[512];                        /* Commit mesajı */
     long    timestamp;                           /* Unix zaman damgası */
@@ -132,7 +181,7 @@ typedef enum {
     VAULT_OK            =  0,   /* İşlem başarılı */
     VAULT_ERR_IO        = -1,   /* Dosya okuma/yazma hatası */
     VAULT_ERR_HASH      = -2,   /* SHA-256 hesaplama hatası */
-    VAULT_ERR_COMPRESS  = -3,   /* zlib sıkıştırma/açma hatası */
+    VAULT_ERR_COMPRESS  = -3,   /* Sıkıştırma/açma hatası, desteklenmeyen codec */
     VAULT_ERR_NOMEM     = -4,   /* Bellek ayırma (malloc) başarısız */
     VAULT_ERR_NOTFOUND  = -5,   /* Nesne disktte bulunamadı */
     VAULT_ERR_CORRUPT   = -6    /* Nesne bozuk veya okunamıyor */
@@ -147,28 +196,54 @@ typedef enum {
  *   Parametreler:
  *     data     → Hash'lenecek ham veri
  *     size     → Verinin boyutu (byte)
- *     out_hash → Sonucun yazılacağı buffer (en az VAULT_HASH_HEX_SIZE)
+ *     out_oid  → Sonuç (ham 32 byte)
  *
  *   Dönüş: VAULT_OK veya hata kodu
  *
  *   Örnek:
- *     char hash[VAULT_HASH_HEX_SIZE];
- *     vault_hash_content("hello", 5, hash);
- *     // hash = "2cf24dba5fb0a30e26e83b2ac5b9e29e..."
+ *     VaultOid oid;
+ *     vault_hash_content("hello", 5, &oid);
+ *     // hex: "2cf24dba5fb0a30e26e83b2ac5b9e29e..."
+ *
+ *   Not: Hash, CPU'ya göre seçilen SHA-NI / generic çekirdekle hesaplanır
+ *        (bkz. vault_sha256.h); sonuç her çekirdekte aynıdır.
  */
 VaultError vault_hash_content(const uint8_t *data, size_t size,
-                              char out_hash[VAULT_HASH_HEX_SIZE]);
+                              VaultOid *out_oid);
+
+/*
+ * vault_hash_content_many:
+ *   count adet buffer'ın hash'ini birlikte hesaplar; out_oids[i] =
+ *   vault_hash_content(data[i], sizes[i]). Çok sayıda küçük dosyada AVX2
+ *   şeritleri sayesinde tek tek çağırmaktan hızlıdır.
+ *
+ *   Dönüş: VAULT_OK veya VAULT_ERR_NOMEM
+ */
+VaultError vault_hash_content_many(const uint8_t *const *data, const size_t *sizes,
+                                   size_t count, VaultOid *out_oids);
+
+/*
+ * vault_hash_blob_many:
+ *   vault_hash_content_many ile aynı, ama her içerik bir blob nesnesi olarak
+ *   ("blob <boyut>\0" + içerik) hash'lenir: out_oids[i], içeriğin
+ *   vault_object_write / vault_hash_blob_file ile alacağı oid'dir.
+ *
+ *   Dönüş: VAULT_OK veya VAULT_ERR_NOMEM
+ */
+VaultError vault_hash_blob_many(const uint8_t *const *data, const size_t *sizes,
+                                size_t count, VaultOid *out_oids);
 
 /*
  * vault_object_write:
- *   Bir nesneyi (blob, tree veya commit) zlib ile sıkıştırıp
- *   .vault/objects/<ilk2>/<kalan> yoluna yazar.
+ *   Bir nesneyi (blob, tree veya commit) repo'nun codec'iyle sıkıştırıp
+ *   .vault/objects/<ilk2>/<kalan> yoluna yazar. Sıkıştırılamaz görünen
+ *   blob'lar ham saklanır (bkz. vault_compress.h).
  *
  *   Parametreler:
  *     type     → Nesne tipi (BLOB, TREE, COMMIT)
  *     data     → Nesnenin ham içeriği
  *     size     → İçeriğin boyutu
- *     out_hash → Yazılan nesnenin hash'i (çıktı)
+ *     out_oid  → Yazılan nesnenin hash'i (çıktı)
  *
  *   Dönüş: VAULT_OK veya hata kodu
  *
@@ -178,14 +253,18 @@ VaultError vault_hash_content(const uint8_t *data, size_t size,
  */
 VaultError vault_object_write(VaultObjectType type,
                               const uint8_t *data, size_t size,
-                              char out_hash[VAULT_HASH_HEX_SIZE]);
+                              VaultOid *out_oid);
 
 /*
  * vault_object_read:
  *   Hash'i verilen nesneyi diskten okuyup, sıkıştırmayı açıp döner.
  *
+ *   Arama sırası:
+ *     1. .vault/objects/pack/ altındaki pack index'leri (mmap + binary search)
+ *     2. Tek tek saklanan "loose" nesneler (.vault/objects/<ilk2>/<kalan>)
+ *
  *   Parametreler:
- *     hash     → Okunacak nesnenin hash'i
+ *     oid      → Okunacak nesnenin hash'i
  *     out_data → Okunan veri (malloc ile ayrılır, ÇAĞIRAN free() YAPMALI)
  *     out_size → Okunan verinin boyutu (çıktı)
  *     out_type → Nesnenin tipi (çıktı)
@@ -195,7 +274,7 @@ VaultError vault_object_write(VaultObjectType type,
  *   ⚠️ Bellek yönetimi: Bu fonksiyon out_data için bellek ayırır.
  *      Çağıran taraf kullanım sonrası free(out_data) yapmalıdır!
  */
-VaultError vault_object_read(const char hash[VAULT_HASH_HEX_SIZE],
+VaultError vault_object_read(const VaultOid *oid,
                              uint8_t **out_data, size_t *out_size,
                              VaultObjectType *out_type);
 
@@ -203,25 +282,236 @@ VaultError vault_object_read(const char hash[VAULT_HASH_HEX_SIZE],
  * vault_object_exists:
  *   Verilen hash'e sahip bir nesnenin diskte olup olmadığını kontrol eder.
  *
+ *   İlk çağrıda pack index'lerindeki tüm oid'ler bir varlık kümesine
+ *   yüklenir (bkz. vault_oidset.h). Loose nesneler fan-out dizini başına,
+ *   o önek ilk sorulduğunda tek bir readdir ile eklenir; sonraki sorgular
+ *   dosya sistemine dokunmaz. Bu süreçte yazılan nesneler kümeye eklenir.
+ *   Küme yüklenemezse (bellek) ya da dizin okunamazsa eskisi gibi
+ *   pack'lere ve loose dosyaya bakılır.
+ *
+ *   Küme yüklendiği andaki diskin görüntüsüdür: başka bir sürecin sonradan
+ *   yazdığı nesne "yok" görünebilir. Yazma yolunda bunun tek sonucu nesnenin
+ *   aynı içerikle yeniden yazılmasıdır.
+ *
  *   Dönüş: 1 = var, 0 = yok
  */
-int vault_object_exists(const char hash[VAULT_HASH_HEX_SIZE]);
+int vault_object_exists(const VaultOid *oid);
+
+/*
+ * vault_object_size:
+ *   Nesnenin tipini ve açılmış boyutunu içeriği okumadan döner: loose
+ *   nesnede yalnızca başlık inflate edilir, pack'te giriş (veya delta)
+ *   başlığına bakılır. Checkout gibi bellek bütçesi tutan çağıranlar,
+ *   nesneyi açmadan önce yer ayırmak için kullanır.
+ *
+ *   Dönüş: vault_object_read ile aynı hata kodları
+ */
+VaultError vault_object_size(const VaultOid *oid,
+                             size_t *out_size, VaultObjectType *out_type);
+
+/*
+ * vault_object_foreach_loose:
+ *   .vault/objects/<ilk2>/<kalan> altındaki her loose nesnenin oid'i için
+ *   fn'i çağırır (sırasız). fn VAULT_OK dışında bir şey dönerse tarama durur
+ *   ve o değer döner. Geçici dosyalar ve pack dizini atlanır.
+ *
+ *   Dönüş: VAULT_OK, objects dizini açılamazsa VAULT_ERR_IO
+ */
+typedef VaultError (*VaultOidCallback)(const VaultOid *oid, void *ctx);
+
+VaultError vault_object_foreach_loose(VaultOidCallback fn, void *ctx);
+
+/*
+ * vault_hash_blob_file:
+ *   Bir dosyanın blob hash'ini nesne yazmadan hesaplar
+ *   (SHA-256 of "blob <boyut>\0" + içerik). Dosya VAULT_STREAM_CHUNK'lık
+ *   parçalarla okunur; bellek kullanımı dosya boyutundan bağımsızdır.
+ *
+ *   Dönüş: VAULT_OK, dosya okunamazsa VAULT_ERR_IO / VAULT_ERR_NOTFOUND
+ */
+VaultError vault_hash_blob_file(const char *path, VaultOid *out_oid);
+
+/* ---- Nesne Cache'i ------------------------------------------------------ */
+
+/*
+ * log, checkout ve commit'ler arası diff aynı tree/commit nesnelerini tekrar
+ * tekrar okur. Açılmış (inflate edilmiş) nesneler hash'e göre anahtarlanan,
+ * boyutla sınırlı bir LRU cache'te tutulur ve çağırana kopya yerine salt
+ * okunur, referans sayılı bir "view" verilir:
+ *
+ *   VaultObjectView view;
+ *   if (vault_object_view(&commit_oid, &view) == VAULT_OK) {
+ *       vault_commit_deserialize(view.data, view.size, &commit);
+ *       vault_object_view_release(&view);
+ *   }
+ *
+ * View serbest bırakılana kadar verisi geçerli kalır; cache dolsa bile
+ * kullanımdaki nesneler atılmaz. Bütçeden büyük nesneler cache'e girmez,
+ * view'e özel bir kopya olarak verilir. Fonksiyonlar thread-safe'dir.
+ *
+ * vault_object_read cache'te bulunan nesneyi inflate etmeden kopyalar ama
+ * cache'e ekleme yapmaz (repack gibi tek geçişlik okumalar cache'i kirletmez).
+ */
+#define VAULT_OBJECT_CACHE_DEFAULT_LIMIT (32u * 1024 * 1024)
+
+typedef struct VaultCacheEntry VaultCacheEntry;
+
+typedef struct {
+    const uint8_t   *data;      /* Nesne içeriği (sonunda '\0'), salt okunur */
+    size_t           size;
+    VaultObjectType  type;
+    VaultCacheEntry *entry;     /* Dahili: release için */
+} VaultObjectView;
+
+typedef struct {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    size_t   bytes;             /* Cache'teki nesnelerin toplam boyutu */
+    size_t   count;             /* Cache'teki nesne sayısı */
+    size_t   limit;             /* Bütçe (byte) */
+} VaultObjectCacheStats;
+
+/*
+ * vault_object_view:
+ *   Nesneyi cache'ten verir; yoksa okuyup cache'e ekler.
+ *   Başarılıysa view mutlaka vault_object_view_release ile bırakılmalı.
+ *
+ *   Dönüş: vault_object_read ile aynı hata kodları
+ */
+VaultError vault_object_view(const VaultOid *oid, VaultObjectView *out_view);
+
+/*
+ * vault_object_view_release:
+ *   View'in referansını bırakır. Bütçe aşılmışsa artık kullanılmayan en eski
+ *   nesneler atılır.
+ */
+void vault_object_view_release(VaultObjectView *view);
+
+/*
+ * vault_object_cache_set_limit:
+ *   Cache bütçesini byte cinsinden ayarlar (0 = cache kapalı).
+ *   Yeni bütçe aşılıyorsa kullanılmayan nesneler hemen atılır.
+ */
+void vault_object_cache_set_limit(size_t bytes);
+
+/*
+ * vault_object_cache_stats:
+ *   İsabet / kaçırma / atma sayaçlarını ve anlık doluluğu döner.
+ */
+void vault_object_cache_stats(VaultObjectCacheStats *out_stats);
+
+/*
+ * vault_object_cache_clear:
+ *   Kullanılmayan tüm nesneleri atar ve sayaçları sıfırlar. Kullanımdaki
+ *   view'ler geçerli kalır, bırakıldıklarında serbest kalırlar.
+ */
+void vault_object_cache_clear(void);
+
+/* ---- Akış (Streaming) Yazma -------------------------------------------- */
+
+/*
+ * vault_object_write tüm içeriğin tek bir buffer'da olmasını ister; çok
+ * büyük dosyalar (ör. 6 GB'lık bir asset) için bu kabul edilemez.
+ * Akış API'si içeriği parça parça alır:
+ *
+ *   - SHA-256 "blob <boyut>\0" başlığı + içerik üzerinden artımlı hesaplanır
+ *   - Her parça repo'nun codec'iyle sıkıştırılıp doğrudan geçici dosyaya
+ *     yazılır; sıkıştırılamazlık sondası ilk parçaya bakar
+ *   - finish() hash'i bulur ve geçici dosyayı .vault/objects/<ilk2>/<kalan>
+ *     yoluna rename() eder (nesne zaten varsa geçici dosya silinir)
+ *
+ * Bellek kullanımı içerik boyutundan bağımsızdır (VAULT_STREAM_CHUNK).
+ *
+ * Örnek:
+ *   VaultObjectStream *st;
+ *   vault_object_stream_open(&st, VAULT_OBJ_BLOB, dosya_boyutu);
+ *   while ((n = fread(buf, 1, sizeof(buf), fp)) > 0)
+ *       vault_object_stream_write(st, buf, n);
+ *   vault_object_stream_finish(st, &oid);   // st'yi de serbest bırakır
+ */
+#define VAULT_STREAM_CHUNK (64 * 1024)
+
+typedef struct VaultObjectStream VaultObjectStream;
+
+/*
+ * vault_object_stream_open:
+ *   Yeni bir akış başlatır. size, başlığa yazılacağı için baştan bilinmeli;
+ *   finish() sırasında toplam beslenen byte sayısı bununla eşleşmezse
+ *   nesne yazılmaz ve VAULT_ERR_CORRUPT döner.
+ */
+VaultError vault_object_stream_open(VaultObjectStream **out_stream,
+                                    VaultObjectType type, size_t size);
+
+/*
+ * vault_object_stream_write:
+ *   Bir içerik parçasını hash'e ve sıkıştırılmış geçici dosyaya ekler.
+ */
+VaultError vault_object_stream_write(VaultObjectStream *stream,
+                                     const uint8_t *data, size_t size);
+
+/*
+ * vault_object_stream_finish:
+ *   Akışı tamamlar, nesneyi atomik olarak yerine koyar ve hash'ini döner.
+ *   Başarılı ya da başarısız, stream'i serbest bırakır.
+ */
+VaultError vault_object_stream_finish(VaultObjectStream *stream,
+                                      VaultOid *out_oid);
+
+/*
+ * vault_object_stream_abort:
+ *   Akışı iptal eder, geçici dosyayı siler ve stream'i serbest bırakır.
+ */
+void vault_object_stream_abort(VaultObjectStream *stream);
+
+/*
+ * vault_object_read_fd:
+ *   Nesnenin içeriğini tamamını bellekte tutmadan fd'ye yazar (checkout'ta
+ *   büyük blob'lar için). Loose nesneler ve pack'teki tam girişler
+ *   VAULT_STREAM_CHUNK'lık parçalarla açılır. Nesne cache'i kullanılmaz.
+ *
+ *   Dönüş: VAULT_OK, VAULT_ERR_NOTFOUND, tipi type değilse ya da boyutu
+ *          başlıktakiyle uyuşmazsa VAULT_ERR_CORRUPT, yazma hatasında
+ *          VAULT_ERR_IO. Hata durumunda fd'ye kısmi içerik yazılmış olabilir.
+ */
+VaultError vault_object_read_fd(const VaultOid *oid, VaultObjectType type, int fd);
 
 /* ---- Yardımcı Fonksiyonlar ---------------------------------------------- */
 
+/*
+ * vault_oid_from_hex / vault_oid_to_hex:
+ *   64 karakterlik hex hash ile VaultOid arasında dönüşüm yapar.
+ *   Dönüşümler dallanmasızdır: kodlama 8 nibble'ı tek 64 bit kelimede
+ *   birlikte işler, çözme tablo tabanlıdır ve geçersiz karakteri sonda
+ *   tek seferde kontrol eder.
+ *
+ *   vault_oid_from_hex yalnızca ilk 64 karakteri okur (sonunda '\0'
+ *   gerekmez); geçersiz (hex olmayan) girdide VAULT_ERR_CORRUPT döner.
+ *   vault_oid_to_hex küçük harf üretir ve sonuna '\0' koyar.
+ */
+VaultError vault_oid_from_hex(const char *hex, VaultOid *out_oid);
+
+void vault_oid_to_hex(const VaultOid *oid, char out_hex[VAULT_HASH_HEX_SIZE]);
+
+/*
+ * vault_object_path:
+ *   Bir loose nesnenin disk yolunu üretir:
+ *     .vault/objects/<ilk2>/<kalan>
+ */
+void vault_object_path(const VaultOid *oid, char *out_path, size_t out_size);
+
 /*
  * vault_blob_write:
  *   Bir VaultBlob yapısını nesne olarak diske yazar.
  *   (vault_object_write etrafında kolaylık wrapper'ı)
  */
-VaultError vault_blob_write(const VaultBlob *blob,
-                            char out_hash[VAULT_HASH_HEX_SIZE]);
+VaultError vault_blob_write(const VaultBlob *blob, VaultOid *out_oid);
 
 /*
  * vault_tree_serialize / vault_tree_deserialize:
  *   Tree nesnesini byte dizisine çevirir / byte dizisinden geri yükler.
  *
- *   Serileştirme formatı (her satır bir entry):
+ *   Serileştirme formatı (her satır bir entry, hash hex olarak):
  *     "<mode> <hash> <name>\n"
  *
  *   Örnek:
@@ -0,0 +1,76 @@
+/*
+ * ============================================================================
+ *  vault_oidset.h — Nesne Varlık Kümesi (Bloom Filtresi + Sıralı Küme)
+ * ============================================================================
+ *
+ *  Var olan bir nesneyi yeniden yazmak en sık durumdur: değişmemiş dosyalar
+ *  tekrar add edilir, aynı alt tree'ler her commit'te yeniden üretilir.
+ *  Her seferinde pack index'lerine bakıp loose dosyayı stat() etmek yerine
+ *  bilinen tüm oid'ler bellekte bir kümede tutulur:
+ *
+ *    Bloom filtresi → oid başına ~10 bit, k = 7; "kesin yok" cevabı birkaç
+ *                     bellek erişimidir. Olmayan nesneler (yeni içerik)
+ *                     çoğunlukla burada elenir.
+ *    Sıralı dizi    → filtre "belki" dediğinde binary search ile kesin
+ *                     cevap; yanlış pozitifler buradan geçemez.
+ *    Ek tablo       → kümeye sonradan eklenen oid'ler (açık adresli hash
+ *                     tablosu). Sıralı diziden büyüyünce ikisi birleştirilip
+ *                     filtre yeniden kurulur.
+ *
+ *  SHA-256 düzgün dağılımlı olduğundan filtre ve tablo hash'leri doğrudan
+ *  oid byte'larından alınır.
+ *
+ *  Küme kendi başına thread-safe değildir; vault_object_exists onu bir
+ *  okuma/yazma kilidiyle korur.
+ *
+ *  Bağımlılık: vault_objects.h
+ * ============================================================================
+ */
+
+#ifndef VAULT_OIDSET_H
+#define VAULT_OIDSET_H
+
+#include "vault_objects.h"
+
+/* Bloom filtresi: oid başına bit sayısı (~%1 yanlış pozitif) ve hash sayısı */
+#define VAULT_OIDSET_BLOOM_BITS    10
+#define VAULT_OIDSET_BLOOM_HASHES  7
+
+typedef struct {
+    uint64_t *bloom;            /* 2'nin kuvveti kadar bit */
+    size_t    bloom_mask;       /* bit sayısı - 1 */
+    VaultOid *ids;              /* Sıralı, tekrarsız */
+    size_t    count;
+    VaultOid *extra;            /* Ek tablo; boş slot = sıfır oid */
+    size_t    extra_count;
+    size_t    extra_cap;        /* 2'nin kuvveti ya da 0 */
+} VaultOidSet;
+
+/*
+ * vault_oidset_build:
+ *   ids dizisinden kümeyi kurar; dizinin sahipliği kümeye geçer (malloc ile
+ *   ayrılmış olmalı, sıralanır ve tekrarlar atılır). count 0 ise ids NULL
+ *   olabilir.
+ *
+ *   Dönüş: VAULT_OK, VAULT_ERR_NOMEM (ids yine de serbest bırakılır)
+ */
+VaultError vault_oidset_build(VaultOidSet *set, VaultOid *ids, size_t count);
+
+/*
+ * vault_oidset_contains:
+ *   1 = kümede, 0 = değil. Önce Bloom filtresi, sonra binary search / ek
+ *   tablo.
+ */
+int vault_oidset_contains(const VaultOidSet *set, const VaultOid *oid);
+
+/*
+ * vault_oidset_add:
+ *   oid'i kümeye ekler (zaten varsa bir şey yapmaz).
+ *
+ *   Dönüş: VAULT_OK veya VAULT_ERR_NOMEM (küme değişmeden kalır)
+ */
+VaultError vault_oidset_add(VaultOidSet *set, const VaultOid *oid);
+
+void vault_oidset_free(VaultOidSet *set);
+
+#endif /* VAULT_OIDSET_H */
@@ -0,0 +1,143 @@
+/*
+ * ============================================================================
+ *  vault_pack.h — Pack Dosyaları (Fiziksel Katman Eklentisi)
+ * ============================================================================
+ *
+ *  Her nesnenin ayrı bir zlib dosyası olarak saklanması, yüz binlerce nesneli
+ *  bir repoda yüz binlerce inode ve her okuma için open/read/close demektir.
+ *  "vault repack" komutu bu loose nesneleri tek bir pack dosyasında toplar
+ *  ve yanına sıralı, fanout tablolu bir index yazar.
+ *
+ *  vault_object_read / vault_object_exists önce bu index'lere bakar
+ *  (mmap + binary search), bulamazsa loose nesnelere düşer.
+ *
+ *  Dosya formatları (tüm sayılar big-endian):
+ *
+ *    pack-<checksum>.pack
+ *      "VPAK" | versiyon (u32) | nesne sayısı (u32)
+ *      Her nesne: [tip: 1 byte][boyut: varint][zlib sıkıştırılmış içerik]
+ *      Delta nesne: [VAULT_PACK_OBJ_DELTA][delta boyutu: varint]
+ *                   [base'e olan geri mesafe: varint][zlib delta]
+ *                   (delta formatı için bkz. vault_delta.h)
+ *      Sonda: önceki tüm byte'ların SHA-256'sı (32 byte)
+ *
+ *    pack-<checksum>.idx
+ *      "VIDX" | versiyon (u32)
+ *      fanout[256] (u32)  → fanout[b] = ilk byte'ı <= b olan nesne sayısı
+ *      hash[N][32]        → ham hash'ler, sıralı
+ *      offset[N] (u64)    → her nesnenin pack içindeki konumu
+ *      pack checksum (32 byte)
+ *
+ *  Delta seçimi Git'teki gibidir: nesneler tip / isim hash'i / boyuta göre
+ *  sıralanır ve her nesne, kayan bir penceredeki son VAULT_PACK_WINDOW nesneye
+ *  karşı denenir. Zincir derinliği VAULT_PACK_MAX_DEPTH ile sınırlıdır ve
+ *  okuma tarafında yeniden oluşturulan base'ler bir cache'te tutulur.
+ *
+ *  Bağımlılık: vault_objects.h, vault_delta.h
+ * ============================================================================
+ */
+
+#ifndef VAULT_PACK_H
+#define VAULT_PACK_H
+
+#include "vault_objects.h"
+
+/* ---- Sabitler ----------------------------------------------------------- */
+
+#define VAULT_PACK_DIR      ".vault/objects/pack"
+#define VAULT_PACK_VERSION  2
+
+/* Pack içindeki giriş tipi: 0..2 VaultObjectType, bu değer delta demektir */
+#define VAULT_PACK_OBJ_DELTA  7
+
+/* Delta arama penceresi ve zincir sınırları */
+#define VAULT_PACK_WINDOW             10
+#define VAULT_PACK_MAX_DEPTH          50
+#define VAULT_PACK_DELTA_MIN_SIZE     64                  /* daha küçükler delta'lanmaz */
+#define VAULT_PACK_WINDOW_MAX_OBJECT  (64u * 1024 * 1024) /* pencereye giren en büyük nesne */
+#define VAULT_PACK_MAX_CHAIN          1024                /* okurken bozuk zincir koruması */
+
+/* Bundan büyük nesneler delta'lanmaz (ne hedef ne base olarak): delta
+ * üretmek ve uygulamak tüm içeriği bellekte ister, tam girişler ise
+ * vault_pack_read_fd ile parça parça açılabilir. vault add'in akış
+ * eşiğiyle aynıdır. */
+#define VAULT_PACK_DELTA_MAX_SIZE     (8u * 1024 * 1024)
+
+/* Yeniden oluşturulmuş delta base'leri için cache */
+#define VAULT_PACK_DELTA_CACHE_SLOTS  256
+#define VAULT_PACK_DELTA_CACHE_LIMIT  (16u * 1024 * 1024)
+
+/* ---- Okuma -------------------------------------------------------------- */
+
+/*
+ * vault_pack_contains:
+ *   Nesne herhangi bir pack'te var mı?
+ *   İlk çağrıda pack dizinindeki tüm .idx dosyaları mmap edilir.
+ *
+ *   Dönüş: 1 = var, 0 = yok
+ */
+int vault_pack_contains(const VaultOid *oid);
+
+/*
+ * vault_pack_read:
+ *   Nesneyi pack'lerden okur. Sözleşme vault_object_read ile aynıdır
+ *   (out_data malloc ile ayrılır, çağıran free() yapmalı).
+ *
+ *   Dönüş: VAULT_OK, nesne hiçbir pack'te yoksa VAULT_ERR_NOTFOUND,
+ *          pack bozuksa VAULT_ERR_CORRUPT
+ */
+VaultError vault_pack_read(const VaultOid *oid,
+                           uint8_t **out_data, size_t *out_size,
+                           VaultObjectType *out_type);
+
+/*
+ * vault_pack_read_fd:
+ *   Nesnenin içeriğini fd'ye yazar. Tam girişler VAULT_STREAM_CHUNK'lık
+ *   parçalarla açılır (bellek kullanımı boyuttan bağımsız); delta'lar
+ *   bellekte oluşturulup yazılır. Nesnenin tipi type değilse
+ *   VAULT_ERR_CORRUPT.
+ *
+ *   Dönüş: vault_pack_read ile aynı, yazma hatasında VAULT_ERR_IO
+ */
+VaultError vault_pack_read_fd(const VaultOid *oid, VaultObjectType type, int fd);
+
+/*
+ * vault_pack_object_size:
+ *   Nesnenin tipini ve açılmış boyutunu, içeriği yeniden oluşturmadan
+ *   döner. Delta'larda yalnızca delta başlığı açılır.
+ *
+ *   Dönüş: vault_pack_read ile aynı hata kodları
+ */
+VaultError vault_pack_object_size(const VaultOid *oid,
+                                  size_t *out_size, VaultObjectType *out_type);
+
+/*
+ * vault_pack_foreach_oid:
+ *   Tüm pack'lerdeki her oid için fn'i çağırır (pack başına sıralı).
+ *   fn VAULT_OK dışında bir şey dönerse durur ve o değeri döner.
+ */
+VaultError vault_pack_foreach_oid(VaultOidCallback fn, void *ctx);
+
+/* ---- Yazma -------------------------------------------------------------- */
+
+/*
+ * vault_repack:
+ *   Tüm loose nesneleri ve mevcut pack'lerin içeriğini tek bir yeni pack'te
+ *   toplar. Yeni pack ve index atomik olarak yerine konduktan sonra eski
+ *   pack'ler ve paketlenen loose nesneler silinir.
+ *
+ *   Parametreler:
+ *     out_count → Yeni pack'teki nesne sayısı (çıktı, NULL olabilir)
+ *
+ *   Dönüş: VAULT_OK veya hata kodu
+ */
+VaultError vault_repack(size_t *out_count);
+
+/*
+ * vault_pack_close_all:
+ *   mmap edilmiş tüm pack'leri kapatır. Bir sonraki okuma pack dizinini
+ *   yeniden tarar.
+ */
+void vault_pack_close_all(void);
+
+#endif /* VAULT_PACK_H */
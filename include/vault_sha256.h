@@ -0,0 +1,106 @@
+/*
+ * ============================================================================
+ *  vault_sha256.h — Donanım Hızlandırmalı SHA-256
+ * ============================================================================
+ *
+ *  add, status ve nesne okuma/yazma her dosya için SHA-256 hesaplar.
+ *  Dosyaların çoğu birkaç KB olduğundan OpenSSL EVP'nin çağrı başına
+ *  maliyeti (context ayırma, algoritma arama) hash'in kendisi kadar tutar.
+ *  Bu modül sıkıştırma fonksiyonunu doğrudan çağırır ve çalışma anında
+ *  CPU'ya göre çekirdek seçer:
+ *
+ *    sha-ni  → x86 SHA uzantıları (sha256rnds2 / sha256msg1 / sha256msg2)
+ *              ile tek akış; taşınabilir C'den birkaç kat hızlı.
+ *    avx2    → 8 şeritli (lane) çoklu akış: 8 bağımsız mesajın bloğu aynı
+ *              anda, her biri bir 32-bit şeritte işlenir. Tek bir mesajı
+ *              hızlandırmaz; çok sayıda küçük blob'u hash'lerken kullanılır.
+ *    generic → Taşınabilir C, her CPU'da çalışır.
+ *
+ *  Seçim ilk kullanımda CPUID ile bir kez yapılır. SHA-NI varsa çoklu akış
+ *  da onu kullanır (tek SHA-NI akışı 8 AVX2 şeridinden hızlıdır); AVX2
+ *  şeritleri SHA-NI'siz işlemciler içindir. Tüm çekirdekler bit bit
+ *  aynı sonucu üretir (testler OpenSSL ile karşılaştırır).
+ *
+ *  Bağımlılık: yok (x86'da GCC/Clang target attribute'ları)
+ * ============================================================================
+ */
+
+#ifndef VAULT_SHA256_H
+#define VAULT_SHA256_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define VAULT_SHA256_DIGEST_SIZE  32
+#define VAULT_SHA256_BLOCK_SIZE   64
+
+/* Çekirdek bayrakları (vault_sha256_use / vault_sha256_features) */
+#define VAULT_SHA256_SHANI  0x1u    /* Tek akış: SHA-NI */
+#define VAULT_SHA256_AVX2   0x2u    /* Çoklu akış: AVX2, 8 şerit */
+
+/* ---- Veri Yapıları ------------------------------------------------------ */
+
+/* Artımlı hash durumu. Alanlar dahilidir; yalnızca API ile kullanın. */
+typedef struct {
+    uint32_t state[8];
+    uint64_t total;                             /* Şimdiye kadarki byte */
+    uint8_t  block[VAULT_SHA256_BLOCK_SIZE];    /* Yarım kalan blok */
+    size_t   block_len;
+} VaultSha256;
+
+/* ---- Tek Akış ----------------------------------------------------------- */
+
+void vault_sha256_init(VaultSha256 *ctx);
+void vault_sha256_update(VaultSha256 *ctx, const void *data, size_t size);
+void vault_sha256_final(VaultSha256 *ctx, uint8_t out[VAULT_SHA256_DIGEST_SIZE]);
+
+/* Tek seferlik: init + update + final */
+void vault_sha256(const void *data, size_t size, uint8_t out[VAULT_SHA256_DIGEST_SIZE]);
+
+/* ---- Çoklu Akış --------------------------------------------------------- */
+
+/*
+ * vault_sha256_final_many:
+ *   count adet hash'i birlikte bitirir: ctx[i]'ye önce data[i] eklenir,
+ *   sonra sonuç out[i]'ye yazılır. ctx'ler önceden init edilmiş ve başlarına
+ *   ortak olmayan bir önek (ör. "blob 12\0" başlığı) eklenmiş olabilir.
+ *
+ *   AVX2 çekirdeği etkinse mesajlar 8 şeride dağıtılır; biten şeride
+ *   sıradaki mesaj alınır, böylece farklı boyutlu mesajlar şeritleri boş
+ *   bırakmaz. Değilse her mesaj tek akış çekirdeğiyle sırayla hash'lenir.
+ *
+ *   Parametreler:
+ *     ctx   → count adet context (bitince tekrar init edilmeden kullanılmaz)
+ *     data  → Her context'e eklenecek veri
+ *     sizes → Veri boyutları
+ *     count → Mesaj sayısı
+ *     out   → count adet 32 byte'lık özet (çıktı)
+ */
+void vault_sha256_final_many(VaultSha256 *ctx, const uint8_t *const *data,
+                             const size_t *sizes, size_t count,
+                             uint8_t (*out)[VAULT_SHA256_DIGEST_SIZE]);
+
+/* ---- Çekirdek Seçimi ---------------------------------------------------- */
+
+/*
+ * vault_sha256_features:
+ *   CPU'nun desteklediği çekirdek bayrakları (VAULT_SHA256_SHANI | ...).
+ */
+unsigned vault_sha256_features(void);
+
+/*
+ * vault_sha256_use:
+ *   Kullanılacak çekirdekleri seçer (testler ve benchmark'lar için; 0 =
+ *   yalnızca generic). Desteklenmeyen bayraklar yok sayılır; SHA-NI seçilirse
+ *   AVX2 devre dışı kalır. Etkin olan bayrakları döner. Hash hesaplanırken
+ *   başka bir iş parçacığından çağrılmamalı.
+ */
+unsigned vault_sha256_use(unsigned features);
+
+/*
+ * vault_sha256_impl_name:
+ *   Etkin çekirdeklerin adı: "sha-ni", "generic+avx2" veya "generic".
+ */
+const char *vault_sha256_impl_name(void);
+
+#endif /* VAULT_SHA256_H */
@@ -0,0 +1,70 @@
+/*
+ * ============================================================================
+ *  vault_tree.h — Tree Karşılaştırma (Tree-to-Tree Diff)
+ * ============================================================================
+ *
+ *  İki commit arasındaki farkı bulmanın saf yolu, iki tarafın da tüm dosya
+ *  listesini çıkarıp her dosyayı karşılaştırmaktır: 1 milyon dosyalık bir
+ *  repoda iki komşu commit için bile 1 milyon giriş.
+ *
+ *  vault_tree_diff iki tree'yi aynı anda, isim sırasında gezer (merge-walk).
+ *  Hash'i iki tarafta aynı olan bir alt dizin hiç açılmaz: içindeki her şey
+ *  aynıdır. Böylece maliyet değişen yolların sayısıyla orantılıdır, repo
+ *  boyutuyla değil. Blob'lar hiç okunmaz; içerik farkı çağıranın işidir.
+ *
+ *  Sıralama Git'teki gibidir: dizin isimleri sonlarında '/' varmış gibi
+ *  karşılaştırılır (vault_build_tree'nin ürettiği sıra).
+ *
+ *  Bağımlılık: vault_objects.h
+ * ============================================================================
+ */
+
+#ifndef VAULT_TREE_H
+#define VAULT_TREE_H
+
+#include "vault_objects.h"
+
+/* ---- Veri Yapıları ------------------------------------------------------ */
+
+/*
+ * Tek bir dosya değişikliği. Dizinler raporlanmaz; eklenen ya da silinen
+ * bir dizinin altındaki her dosya ayrı ayrı bildirilir. Dosya ↔ dizin
+ * dönüşümü, silme + ekleme olarak görünür.
+ */
+typedef struct {
+    const char           *path;       /* Tam yol, ör. "src/main.c" */
+    char                  status;     /* 'A' (eklendi), 'D' (silindi), 'M' (değişti) */
+    const VaultTreeEntry *old_entry;  /* 'A' ise NULL */
+    const VaultTreeEntry *new_entry;  /* 'D' ise NULL */
+} VaultTreeChange;
+
+/* VAULT_OK dışında bir değer dönerse gezinme durur ve o değer döner */
+typedef VaultError (*VaultTreeDiffCallback)(const VaultTreeChange *change, void *ctx);
+
+/* ---- Karşılaştırma ------------------------------------------------------ */
+
+/*
+ * vault_tree_diff:
+ *   old_tree ile new_tree arasındaki dosya değişikliklerini yol sırasında
+ *   callback'e bildirir. Sıfır oid boş tree demektir (ilk commit'e karşı
+ *   diff veya tüm dosyaların silinmesi).
+ *
+ *   Parametreler:
+ *     old_tree  → Eski root tree (sıfır oid olabilir)
+ *     new_tree  → Yeni root tree (sıfır oid olabilir)
+ *     callback  → Her değişen dosya için çağrılır
+ *     user_data → Callback'e geçirilecek ek veri
+ *
+ *   Dönüş: VAULT_OK, tree okunamazsa hata kodu, ya da callback'in döndürdüğü
+ *          hata
+ */
+VaultError vault_tree_diff(const VaultOid *old_tree, const VaultOid *new_tree,
+                           VaultTreeDiffCallback callback, void *user_data);
+
+/*
+ * vault_tree_entry_is_dir:
+ *   Giriş bir alt dizin mi (mode "040000")?
+ */
+int vault_tree_entry_is_dir(const VaultTreeEntry *entry);
+
+#endif /* VAULT_TREE_H */
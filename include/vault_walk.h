@@ -0,0 +1,76 @@
+/*
+ * ============================================================================
+ *  vault_walk.h — Paralel Dizin Taraması (Work-Stealing)
+ * ============================================================================
+ *
+ *  Çalışma dizini taraması (readdir + her girdiye lstat) tek iş parçacığında
+ *  gecikmeye bağlıdır: NVMe'de ve ağ dosya sistemlerinde aynı anda birden
+ *  çok dizin okumak birkaç kat daha hızlıdır. vault_walk_run dizinleri bir
+ *  işçi havuzuna dağıtır:
+ *
+ *    - Her işçinin kendi iki uçlu kuyruğu (deque) vardır. Bulduğu alt
+ *      dizinleri kuyruğunun sonuna ekler, sıradaki işi de sondan alır
+ *      (derinlik öncelikli; bellekte az dizin birikir).
+ *    - Kuyruğu boşalan işçi başka bir işçinin kuyruğunun başından iş çalar.
+ *      Baştaki dizinler ağaçta daha yukarıdadır: büyük alt ağaçlar çalınır,
+ *      çalma seyrek olur.
+ *    - Bekleyen ya da işlenmekte olan dizin kalmayınca işçiler çıkar.
+ *
+ *  Walker dizinlerin içini kendisi okumaz. Her dizin için çağıranın
+ *  fonksiyonu bir işçide çalışır ve içeri inilecek alt dizinleri
+ *  vault_walk_push ile ekler; böylece çağıran bir dizini okumadan geçebilir
+ *  (untracked cache) ya da alt ağaçları budayabilir. Her dizinle birlikte
+ *  çağıranın bir işaretçisi (data) taşınır; üst dizinden alt dizinlere
+ *  aktarılan durum (örn. .vaultignore kuralları) için. Sonuçlar işçi başına
+ *  toplanmalıdır (worker numarası 0..jobs-1); sıralama çağıranın işidir.
+ *
+ *  Bağımlılık: vault_objects.h, pthread
+ * ============================================================================
+ */
+
+#ifndef VAULT_WALK_H
+#define VAULT_WALK_H
+
+#include "vault_objects.h"
+#include <sys/stat.h>
+
+typedef struct VaultWalk VaultWalk;
+
+/*
+ * VaultWalkDirFn:
+ *   Bir dizini işler. path repo köküne göreceli dizin yoludur ("" = kök,
+ *   sonunda '/' yok), st onun lstat bilgisi, data dizin eklenirken verilen
+ *   işaretçi (kök için NULL). Hata dönerse tarama durur ve
+ *   vault_walk_run ilk hatayı döner.
+ */
+typedef VaultError (*VaultWalkDirFn)(VaultWalk *walk, int worker, const char *path,
+                                     size_t len, const struct stat *st, void *data,
+                                     void *ctx);
+
+/*
+ * vault_walk_jobs:
+ *   vault_walk_run'ın kullanacağı işçi sayısı (jobs <= 0 ise çekirdek
+ *   sayısı). Çağıran işçi başına durumu buna göre ayırır.
+ */
+int vault_walk_jobs(int jobs);
+
+/*
+ * vault_walk_run:
+ *   Kökten ("") başlayarak dizinleri fn ile işler. Çağıran iş parçacığı da
+ *   işçilerden biridir; dönüşte tüm dizinler işlenmiş ve işçiler bitmiştir.
+ *
+ *   Dönüş: VAULT_OK ya da fn'in / bellek ayırmanın ilk hatası
+ */
+VaultError vault_walk_run(int jobs, const struct stat *root_st,
+                          VaultWalkDirFn fn, void *ctx);
+
+/*
+ * vault_walk_push:
+ *   fn içinden, işlenecek bir alt dizini bu işçinin kuyruğuna ekler.
+ *   path kopyalanır; data olduğu gibi fn'e verilir ve walk bitene kadar
+ *   geçerli kalmalıdır.
+ */
+VaultError vault_walk_push(VaultWalk *walk, int worker, const char *path,
+                           size_t len, const struct stat *st, void *data);
+
+#endif /* VAULT_WALK_H */
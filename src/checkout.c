@@ -0,0 +1,447 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "../include/vault_checkout.h"
+#include "../include/vault_tree.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* ---- Değişiklik listesi ------------------------------------------------- */
+
+typedef struct {
+    char    *path;
+    char     status;            /* 'A', 'D', 'M' */
+    VaultOid oid;               /* Yeni içerik ('D' için kullanılmaz) */
+} CheckoutChange;
+
+typedef struct {
+    CheckoutChange *items;
+    size_t          count;
+    size_t          capacity;
+} ChangeList;
+
+static VaultError collect_change(const VaultTreeChange *change, void *ctx){
+    ChangeList *list = ctx;
+    if (list->count == list->capacity) {
+        size_t cap = list->capacity ? list->capacity * 2 : 32;
+        CheckoutChange *grown = realloc(list->items, cap * sizeof(*grown));
+        if (!grown)
+            return VAULT_ERR_NOMEM;
+        list->items = grown;
+        list->capacity = cap;
+    }
+
+    CheckoutChange *c = &list->items[list->count];
+    if (!(c->path = strdup(change->path)))
+        return VAULT_ERR_NOMEM;
+    c->status = change->status;
+    if (change->new_entry)
+        c->oid = change->new_entry->hash;
+    else
+        vault_oid_clear(&c->oid);
+    list->count++;
+    return VAULT_OK;
+}
+
+static void change_list_free(ChangeList *list){
+    for (size_t i = 0; i < list->count; i++)
+        free(list->items[i].path);
+    free(list->items);
+}
+
+/* ---- Dosya sistemi ------------------------------------------------------ */
+
+/*
+ * Yazılacak dosyaların üst dizinleri, işçiler başlamadan ağaç sırasında tek
+ * geçişte oluşturulur. Ardışık yollar ortak bir dizin önekini paylaştığından
+ * önceki yolla ortak olan kısım atlanır: her dizin için bir kez mkdir.
+ * Dizini oluşturulamayan dosyanın sonucu hata olarak işaretlenir.
+ */
+static void make_dirs(CheckoutChange **writes, size_t count, VaultError *results){
+    const char *prev = "";
+    size_t prev_dir = 0;            /* prev'in dizin kısmı, son '/' dahil */
+
+    for (size_t i = 0; i < count; i++) {
+        char *path = writes[i]->path;
+        size_t common = 0;
+        for (size_t k = 0; k < prev_dir && path[k] == prev[k]; k++)
+            if (path[k] == '/')
+                common = k + 1;
+
+        for (char *p = strchr(path + common, '/'); p; p = strchr(p + 1, '/')) {
+            *p = '\0';
+            int rc = mkdir(path, 0755);
+            int saved = errno;
+            *p = '/';
+            if (rc != 0 && saved != EEXIST) {
+                results[i] = VAULT_ERR_IO;
+                break;
+            }
+        }
+
+        const char *slash = strrchr(path, '/');
+        prev = path;
+        prev_dir = (results[i] == VAULT_OK && slash) ? (size_t)(slash - path) + 1 : 0;
+    }
+}
+
+/* Dosya silindikten sonra boşalan üst dizinleri kaldırır */
+static void remove_empty_parents(char *path){
+    char *slash;
+    while ((slash = strrchr(path, '/')) != NULL) {
+        *slash = '\0';
+        if (rmdir(path) != 0)
+            break;
+    }
+}
+
+/* Büyük blob'lar belleğe alınmadan doğrudan dosyaya açılır */
+static int blob_streamed(size_t size){
+    return size > VAULT_INDEX_STREAM_THRESHOLD;
+}
+
+/* Blob'u bellekte açıp fd'ye yazar */
+static VaultError write_blob_buffered(int fd, const VaultOid *oid){
+    uint8_t *data = NULL;
+    size_t size = 0;
+    VaultObjectType type;
+    VaultError err = vault_object_read(oid, &data, &size, &type);
+    if (err != VAULT_OK)
+        return err;
+    if (type != VAULT_OBJ_BLOB) {
+        free(data);
+        return VAULT_ERR_CORRUPT;
+    }
+
+    const uint8_t *p = data;
+    size_t left = size;
+    while (left > 0) {
+        ssize_t n = write(fd, p, left);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            break;
+        p += n;
+        left -= (size_t)n;
+    }
+    free(data);
+    return left == 0 ? VAULT_OK : VAULT_ERR_IO;
+}
+
+/*
+ * Blob'u aynı dizinde geçici bir dosyaya yazıp yerine taşır. Nesne cache'i
+ * atlanır (vault_object_read / _read_fd): her blob bir kez yazılır ve
+ * binlerce blob, log / diff'in sık kullandığı tree'leri LRU'dan atardı.
+ */
+static VaultError write_blob(const char *path, const VaultOid *oid, size_t size){
+    char tmp[VAULT_MAX_PATH + 16];
+    const char *slash = strrchr(path, '/');
+    int dir_len = slash ? (int)(slash - path) + 1 : 0;
+    snprintf(tmp, sizeof(tmp), "%.*s.vault_XXXXXX", dir_len, path);
+
+    int fd = mkstemp(tmp);
+    if (fd < 0)
+        return VAULT_ERR_IO;
+    fchmod(fd, 0644);
+
+    VaultError err = blob_streamed(size) ? vault_object_read_fd(oid, VAULT_OBJ_BLOB, fd)
+                                         : write_blob_buffered(fd, oid);
+    if (close(fd) != 0 && err == VAULT_OK)
+        err = VAULT_ERR_IO;
+    if (err == VAULT_OK && rename(tmp, path) != 0)
+        err = VAULT_ERR_IO;
+    if (err != VAULT_OK)
+        unlink(tmp);
+    return err;
+}
+
+static int path_ptr_cmp(const void *a, const void *b){
+    return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+/*
+ * Dizin ↔ dosya dönüşümü: 'A' yolunda duran dizin, içinde yalnızca bu
+ * checkout'un sileceği izlenen dosyalar varsa silme aşamasında kendiliğinden
+ * kalkar (remove_empty_parents). deleted sıralı 'D' yollarıdır. Başka bir şey
+ * (izlenmeyen dosya, boş alt dizin) varsa 0.
+ */
+static int dir_only_deleted(const VaultIndex *idx, char *path, size_t len,
+                            char **deleted, size_t deleted_count){
+    DIR *dir = opendir(path);
+    if (!dir)
+        return 0;
+    int ok = 1, empty = 1;
+    struct dirent *de;
+    while (ok && (de = readdir(dir)) != NULL) {
+        if (strcmp(de->d_name, ".") == 0 || strcmp(de->d_name, "..") == 0)
+            continue;
+        empty = 0;
+        size_t name_len = strlen(de->d_name);
+        if (len + name_len + 2 > VAULT_MAX_PATH) {
+            ok = 0;
+            break;
+        }
+        path[len] = '/';
+        memcpy(path + len + 1, de->d_name, name_len + 1);
+
+        struct stat st;
+        char *key = path;
+        if (lstat(path, &st) != 0)
+            ok = 0;
+        else if (S_ISDIR(st.st_mode))
+            ok = dir_only_deleted(idx, path, len + 1 + name_len, deleted, deleted_count);
+        else
+            ok = vault_index_find(idx, path) >= 0 &&
+                 bsearch(&key, deleted, deleted_count, sizeof(*deleted), path_ptr_cmp) != NULL;
+        path[len] = '\0';
+    }
+    closedir(dir);
+    return ok && !empty;
+}
+
+/*
+ * 'A' yolunun üst bileşenlerinden biri dizin değilse (ör. izlenmeyen 'a'
+ * dosyası, yeni giriş 'a/b') ve bu checkout onu silmiyorsa, dizin
+ * oluşturulamaz. from: önceki 'A' yoluyla ortak olduğu için zaten denetlenmiş
+ * önekin uzunluğu. Engelleyen bileşenin uzunluğu, yoksa 0.
+ */
+static size_t parent_blocked(const char *path, size_t from,
+                             char **deleted, size_t deleted_count){
+    char buf[VAULT_MAX_PATH];
+    for (const char *slash = strchr(path + from, '/'); slash; slash = strchr(slash + 1, '/')) {
+        size_t len = (size_t)(slash - path);
+        memcpy(buf, path, len);
+        buf[len] = '\0';
+
+        struct stat st;
+        char *key = buf;
+        if (lstat(buf, &st) != 0)
+            return 0;       /* yoksa altındakiler de yok */
+        if (S_ISDIR(st.st_mode))
+            continue;
+        /* Silinecek izlenen dosya: yerine dizin gelir */
+        return bsearch(&key, deleted, deleted_count, sizeof(*deleted), path_ptr_cmp)
+               ? 0 : len;
+    }
+    return 0;
+}
+
+/* Takip edilmeyen bir dosyanın (ya da böyle dosya içeren dizinin) üzerine
+ * yazılmaz. Hiçbir şey silinmeden önce çağrılır: yarım kalan checkout
+ * HEAD ile index'i tutarsız bırakırdı. */
+static VaultError check_untracked(const VaultIndex *idx, const ChangeList *list){
+    char **deleted = malloc((list->count ? list->count : 1) * sizeof(*deleted));
+    if (!deleted)
+        return VAULT_ERR_NOMEM;
+    size_t deleted_count = 0;
+    for (size_t i = 0; i < list->count; i++)
+        if (list->items[i].status == 'D')
+            deleted[deleted_count++] = list->items[i].path;
+    qsort(deleted, deleted_count, sizeof(*deleted), path_ptr_cmp);
+
+    VaultError err = VAULT_OK;
+    const char *prev = NULL;    /* Üst dizinleri denetlenmiş son 'A' yolu */
+    for (size_t i = 0; err == VAULT_OK && i < list->count; i++) {
+        struct stat st;
+        const CheckoutChange *c = &list->items[i];
+        if (c->status != 'A')
+            continue;
+
+        size_t from = 0;
+        for (size_t k = 0; prev && prev[k] && prev[k] == c->path[k]; k++)
+            if (prev[k] == '/')
+                from = k + 1;
+        size_t blocked = parent_blocked(c->path, from, deleted, deleted_count);
+        prev = c->path;
+        if (blocked) {
+            fprintf(stderr, "vault: untracked working tree file '%.*s' would be "
+                            "overwritten by checkout\n", (int)blocked, c->path);
+            err = VAULT_ERR_IO;
+            break;
+        }
+
+        if (vault_index_find(idx, c->path) >= 0 || lstat(c->path, &st) != 0)
+            continue;
+        if (S_ISDIR(st.st_mode)) {
+            char path[VAULT_MAX_PATH];
+            size_t len = strlen(c->path);
+            memcpy(path, c->path, len + 1);
+            if (dir_only_deleted(idx, path, len, deleted, deleted_count))
+                continue;
+        }
+        fprintf(stderr, "vault: untracked working tree file '%s' would be "
+                        "overwritten by checkout\n", c->path);
+        err = VAULT_ERR_IO;
+    }
+    free(deleted);
+    return err;
+}
+
+/* ---- İşçi havuzu -------------------------------------------------------- */
+
+/*
+ * İşçiler sıradaki dosyayı alır, blob'un açılmış boyutunu başlıktan okur ve
+ * o kadar byte'lık bütçe ayırdıktan sonra blob'u açıp yazar (akışla
+ * yazılanlar yalnızca VAULT_CHECKOUT_STREAM_COST ayırır). Bütçe dolu ise
+ * başka bir işçi yer bırakana kadar beklenir; hiçbir şey açık değilken
+ * bütçeden büyük tek bir blob'a yine de izin verilir (aksi halde kilitlenir).
+ */
+typedef struct {
+    CheckoutChange **writes;
+    VaultError      *results;   /* make_dirs'te hata almış dosya atlanır */
+    size_t           count;
+    size_t           next;      /* Sıradaki alınacak iş */
+    size_t           inflight;  /* Şu an açık olan blob byte'ları */
+    size_t           limit;
+    pthread_mutex_t  lock;
+    pthread_cond_t   room;
+} CheckoutPool;
+
+static void budget_acquire(CheckoutPool *pool, size_t size){
+    pthread_mutex_lock(&pool->lock);
+    while (pool->inflight > 0 && pool->inflight + size > pool->limit)
+        pthread_cond_wait(&pool->room, &pool->lock);
+    pool->inflight += size;
+    pthread_mutex_unlock(&pool->lock);
+}
+
+static void budget_release(CheckoutPool *pool, size_t size){
+    pthread_mutex_lock(&pool->lock);
+    pool->inflight -= size;
+    pthread_cond_broadcast(&pool->room);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+static void *checkout_worker(void *arg){
+    CheckoutPool *pool = arg;
+    for (;;) {
+        pthread_mutex_lock(&pool->lock);
+        size_t i = pool->next++;
+        pthread_mutex_unlock(&pool->lock);
+        if (i >= pool->count)
+            break;
+        if (pool->results[i] != VAULT_OK)
+            continue;
+
+        const CheckoutChange *c = pool->writes[i];
+        size_t size = 0;
+        VaultObjectType type;
+        VaultError err = vault_object_size(&c->oid, &size, &type);
+        if (err == VAULT_OK && type != VAULT_OBJ_BLOB)
+            err = VAULT_ERR_CORRUPT;
+        if (err == VAULT_OK) {
+            size_t cost = blob_streamed(size) ? VAULT_CHECKOUT_STREAM_COST : size;
+            budget_acquire(pool, cost);
+            err = write_blob(c->path, &c->oid, size);
+            budget_release(pool, cost);
+        }
+        pool->results[i] = err;
+    }
+    return NULL;
+}
+
+static int default_jobs(void){
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+}
+
+/* Dosyaları 'jobs' iş parçacığıyla yazar; sonuçlar results[]'a */
+static void write_all(CheckoutChange **writes, size_t count, int jobs,
+                      VaultError *results){
+    CheckoutPool pool = {
+        writes, results, count, 0, 0, VAULT_CHECKOUT_INFLIGHT_LIMIT,
+        PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER,
+    };
+
+    if (jobs <= 0)
+        jobs = default_jobs();
+    if ((size_t)jobs > count)
+        jobs = (int)count;
+
+    /* Ana iş parçacığı da çalışır; jobs - 1 ek iş parçacığı yeter */
+    pthread_t *threads = calloc((size_t)jobs, sizeof(*threads));
+    int started = 0;
+    if (threads)
+        while (started < jobs - 1 &&
+               pthread_create(&threads[started], NULL, checkout_worker, &pool) == 0)
+            started++;
+    checkout_worker(&pool);
+    for (int i = 0; i < started; i++)
+        pthread_join(threads[i], NULL);
+    free(threads);
+}
+
+/* ---- Checkout ----------------------------------------------------------- */
+
+VaultError vault_checkout_tree(VaultIndex *idx, const VaultOid *from_tree,
+                               const VaultOid *to_tree, int jobs,
+                               VaultCheckoutStats *stats){
+    VaultCheckoutStats local = { 0, 0 };
+    ChangeList list = { NULL, 0, 0 };
+    VaultError err = vault_tree_diff(from_tree, to_tree, collect_change, &list);
+    if (err == VAULT_OK)
+        err = check_untracked(idx, &list);
+
+    /* Önce silmeler: dosya ↔ dizin dönüşümünde yol boşalmış olmalı */
+    size_t write_count = 0;
+    for (size_t i = 0; err == VAULT_OK && i < list.count; i++) {
+        CheckoutChange *c = &list.items[i];
+        if (c->status != 'D') {
+            write_count++;
+            continue;
+        }
+        if (unlink(c->path) != 0 && errno != ENOENT) {
+            err = VAULT_ERR_IO;
+            break;
+        }
+        vault_index_remove(idx, c->path);
+        remove_empty_parents(c->path);
+        local.removed++;
+    }
+
+    CheckoutChange **writes = NULL;
+    VaultError *results = NULL;
+    if (err == VAULT_OK && write_count > 0) {
+        writes = malloc(write_count * sizeof(*writes));
+        results = calloc(write_count, sizeof(*results));
+        if (!writes || !results)
+            err = VAULT_ERR_NOMEM;
+    }
+
+    if (err == VAULT_OK && write_count > 0) {
+        size_t n = 0;
+        for (size_t i = 0; i < list.count; i++)
+            if (list.items[i].status != 'D')
+                writes[n++] = &list.items[i];
+
+        make_dirs(writes, write_count, results);
+        write_all(writes, write_count, jobs, results);
+
+        /* Index tek iş parçacığında, ağaç sırasında güncellenir */
+        for (size_t i = 0; i < write_count; i++) {
+            VaultError e = results[i];
+            if (e == VAULT_OK)
+                e = vault_index_update(idx, writes[i]->path, &writes[i]->oid);
+            if (e == VAULT_OK) {
+                local.written++;
+            } else {
+                fprintf(stderr, "vault: cannot write '%s'\n", writes[i]->path);
+                if (err == VAULT_OK)
+                    err = e;
+            }
+        }
+    }
+
+    free(writes);
+    free(results);
+    change_list_free(&list);
+    if (stats)
+        *stats = local;
+    return err;
+}
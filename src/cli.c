@@ -1,55 +1,956 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include "../include/vault_cli.h"
+#include "../include/vault_checkout.h"
+#include "../include/vault_fsmonitor.h"
+#include "../include/vault_graph.h"
+#include "../include/vault_pack.h"
+#include "../include/vault_tree.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+
+/* ---- Komut tablosu ------------------------------------------------------ */
+
+static const struct {
+    const char   *name;
+    VaultCommand  cmd;
+} commands[] = {
+    { "init",     VAULT_CMD_INIT     },
+    { "add",      VAULT_CMD_ADD      },
+    { "commit",   VAULT_CMD_COMMIT   },
+    { "log",      VAULT_CMD_LOG      },
+    { "status",   VAULT_CMD_STATUS   },
+    { "checkout", VAULT_CMD_CHECKOUT },
+    { "diff",     VAULT_CMD_DIFF     },
+    { "repack",   VAULT_CMD_REPACK   },
+    { "fsmonitor", VAULT_CMD_FSMONITOR },
+    { "help",     VAULT_CMD_HELP     },
+};
+
+static int repo_exists(void){
+    struct stat st;
+    return stat(VAULT_OBJECTS_DIR, &st) == 0 && S_ISDIR(st.st_mode);
+}
+
+static VaultError require_repo(void){
+    if (repo_exists())
+        return VAULT_OK;
+    fprintf(stderr, "vault: not a vault repository (run 'vault init' first)\n");
+    return VAULT_ERR_NOTFOUND;
+}
+
+static const char *error_text(VaultError err){
+    switch (err) {
+    case VAULT_OK:           return "success";
+    case VAULT_ERR_IO:       return "I/O error";
+    case VAULT_ERR_HASH:     return "hashing failed";
+    case VAULT_ERR_COMPRESS: return "compression failed";
+    case VAULT_ERR_NOMEM:    return "out of memory";
+    case VAULT_ERR_NOTFOUND: return "not found";
+    case VAULT_ERR_CORRUPT:  return "corrupt or invalid data";
+    }
+    return "unknown error";
+}
+
+static VaultError create_empty_file(const char *path){
+    FILE *fp = fopen(path, "wb");
+    if (!fp)
+        return VAULT_ERR_IO;
+    return fclose(fp) == 0 ? VAULT_OK : VAULT_ERR_IO;
+}
+
+/* ---- CLI Parser --------------------------------------------------------- */
 
 VaultError vault_parse_args(int argc, char **argv, VaultArgs *args){
-    (void) argc;
-    (void) argv;
-    (void) args;
+    memset(args, 0, sizeof(*args));
+    args->cmd = VAULT_CMD_UNKNOWN;
+
+    if (argc < 2) {
+        args->cmd = VAULT_CMD_HELP;
+        return VAULT_OK;
+    }
+
+    for (size_t i = 0; i < sizeof(commands) / sizeof(commands[0]); i++) {
+        if (strcmp(argv[1], commands[i].name) == 0) {
+            args->cmd = commands[i].cmd;
+            break;
+        }
+    }
+
+    args->targets = calloc((size_t)argc, sizeof(char *));
+    if (!args->targets)
+        return VAULT_ERR_NOMEM;
+
+    for (int i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "-m") == 0) {
+            if (++i >= argc)
+                goto invalid;
+            snprintf(args->message, sizeof(args->message), "%s", argv[i]);
+        } else if (strcmp(argv[i], "--author") == 0) {
+            if (++i >= argc)
+                goto invalid;
+            snprintf(args->author, sizeof(args->author), "%s", argv[i]);
+        } else if (strncmp(argv[i], "--diff-algorithm=", 17) == 0) {
+            const char *name = argv[i] + 17;
+            if (strcmp(name, "myers") == 0)
+                args->diff_algorithm = VAULT_DIFF_MYERS;
+            else if (strcmp(name, "patience") == 0)
+                args->diff_algorithm = VAULT_DIFF_PATIENCE;
+            else if (strcmp(name, "histogram") == 0)
+                args->diff_algorithm = VAULT_DIFF_HISTOGRAM;
+            else
+                goto invalid;
+        } else if (strcmp(argv[i], "-v") == 0) {
+            args->verbose = 1;
+        } else if (strncmp(argv[i], "-j", 2) == 0) {
+            /* "-j 4" veya "-j4" */
+            const char *val = argv[i][2] ? argv[i] + 2 : (++i < argc ? argv[i] : NULL);
+            char *end = NULL;
+            long n = val ? strtol(val, &end, 10) : 0;
+            if (!val || *end != '\0' || n <= 0 || n > 1024)
+                goto invalid;
+            args->jobs = (int)n;
+        } else {
+            args->targets[args->target_cnt] = strdup(argv[i]);
+            if (!args->targets[args->target_cnt]) {
+                vault_args_free(args);
+                return VAULT_ERR_NOMEM;
+            }
+            args->target_cnt++;
+        }
+    }
     return VAULT_OK;
+
+invalid:
+    vault_args_free(args);
+    return VAULT_ERR_CORRUPT;
 }
 
+/* ---- Komut Handler'ları ------------------------------------------------- */
+
 VaultError vault_cmd_init(const VaultArgs *args){
     (void) args;
+
+    if (repo_exists()) {
+        printf("Vault repository already exists in .vault/\n");
+        return VAULT_OK;
+    }
+
+    if ((mkdir(".vault", 0755) != 0 && errno != EEXIST) ||
+        (mkdir(VAULT_OBJECTS_DIR, 0755) != 0 && errno != EEXIST)) {
+        fprintf(stderr, "vault: cannot create .vault/: %s\n", strerror(errno));
+        return VAULT_ERR_IO;
+    }
+
+    if (create_empty_file(VAULT_INDEX_FILE) != VAULT_OK ||
+        create_empty_file(VAULT_HEAD_FILE) != VAULT_OK) {
+        fprintf(stderr, "vault: cannot initialize repository files\n");
+        return VAULT_ERR_IO;
+    }
+
+    printf("Initialized empty Vault repository in .vault/\n");
     return VAULT_OK;
 }
 
+/* vault_status sonuçlarını gruplar halinde yazdırmak için toplar */
+typedef struct {
+    char  **paths;
+    char   *codes;
+    size_t  count;
+    size_t  capacity;
+    int     failed;
+} StatusList;
+
+static void status_collect(const char *filepath, char status, void *ctx){
+    StatusList *list = ctx;
+    if (list->failed)
+        return;
+    if (list->count == list->capacity) {
+        size_t cap = list->capacity ? list->capacity * 2 : 32;
+        char **paths = realloc(list->paths, cap * sizeof(*paths));
+        if (paths)
+            list->paths = paths;
+        char *codes = paths ? realloc(list->codes, cap) : NULL;
+        if (!codes) {
+            list->failed = 1;
+            return;
+        }
+        list->codes = codes;
+        list->capacity = cap;
+    }
+    if (!(list->paths[list->count] = strdup(filepath))) {
+        list->failed = 1;
+        return;
+    }
+    list->codes[list->count++] = status;
+}
+
+static void status_list_free(StatusList *list){
+    for (size_t i = 0; i < list->count; i++)
+        free(list->paths[i]);
+    free(list->paths);
+    free(list->codes);
+}
+
+/*
+ * Dizin hedefi (ör. "." ya da "src/"): altındaki değişmiş ve izlenmeyen
+ * dosyalar files'a eklenir, silinmiş olanlar index'ten çıkarılır. Çalışma
+ * dizini vault_status ile bir kez taranır (paralel tarama + önbellekler).
+ */
+static int path_under(const char *path, const char *dir){
+    size_t len = strlen(dir);
+    return len == 0 || (strncmp(path, dir, len) == 0 && path[len] == '/');
+}
+
+static VaultError add_expand_dirs(VaultIndex *idx, char **dirs, size_t dir_count,
+                                  char ***files, size_t *file_count){
+    StatusList list = { NULL, NULL, 0, 0, 0 };
+    VaultError err = vault_status(idx, status_collect, &list);
+    if (err == VAULT_OK && list.failed)
+        err = VAULT_ERR_NOMEM;
+
+    for (size_t i = 0; err == VAULT_OK && i < list.count; i++) {
+        int match = 0;
+        for (size_t j = 0; j < dir_count && !match; j++)
+            match = path_under(list.paths[i], dirs[j]);
+        if (!match)
+            continue;
+
+        if (list.codes[i] == 'D') {
+            if (vault_index_remove(idx, list.paths[i]) == VAULT_OK)
+                printf("removed: %s\n", list.paths[i]);
+            continue;
+        }
+        char **grown = realloc(*files, (*file_count + 1) * sizeof(*grown));
+        if (!grown) {
+            err = VAULT_ERR_NOMEM;
+            break;
+        }
+        *files = grown;
+        (*files)[(*file_count)++] = list.paths[i];
+        list.paths[i] = NULL;   /* sahiplik files'a geçti */
+    }
+    status_list_free(&list);
+    return err;
+}
+
 VaultError vault_cmd_add(const VaultArgs *args){
-    (void) args;
+    VaultError err = require_repo();
+    if (err != VAULT_OK)
+        return err;
+
+    if (args->target_cnt == 0) {
+        fprintf(stderr, "vault: nothing specified, nothing added\n");
+        return VAULT_ERR_NOTFOUND;
+    }
+
+    VaultIndex idx;
+    if ((err = vault_index_load(&idx)) != VAULT_OK) {
+        fprintf(stderr, "vault: cannot read index: %s\n", error_text(err));
+        return err;
+    }
+
+    /* Dizin hedefleri yerine altındaki dosyalar eklenir */
+    char **files = calloc((size_t)args->target_cnt, sizeof(*files));
+    char **dirs = calloc((size_t)args->target_cnt, sizeof(*dirs));
+    size_t file_count = 0, dir_count = 0;
+    if (!files || !dirs) {
+        free(files);
+        free(dirs);
+        vault_index_free(&idx);
+        return VAULT_ERR_NOMEM;
+    }
+    for (int i = 0; i < args->target_cnt; i++) {
+        char *target = args->targets[i];
+        struct stat st;
+        if (stat(target, &st) != 0 || !S_ISDIR(st.st_mode)) {
+            files[file_count++] = target;
+            continue;
+        }
+        /* "./src/" → "src", "." → "" (tüm çalışma dizini) */
+        while (target[0] == '.' && target[1] == '/')
+            target += 2;
+        if (strcmp(target, ".") == 0)
+            target = "";
+        size_t len = strlen(target);
+        while (len > 0 && target[len - 1] == '/')
+            len--;
+        if (!(dirs[dir_count] = strndup(target, len))) {
+            err = VAULT_ERR_NOMEM;
+            break;
+        }
+        dir_count++;
+    }
+    size_t given = file_count;
+    if (err == VAULT_OK && dir_count > 0)
+        err = add_expand_dirs(&idx, dirs, dir_count, &files, &file_count);
+    for (size_t i = 0; i < dir_count; i++)
+        free(dirs[i]);
+    free(dirs);
+
+    VaultError *results = err == VAULT_OK ? calloc(file_count ? file_count : 1,
+                                                   sizeof(*results)) : NULL;
+    if (!results) {
+        for (size_t i = given; i < file_count; i++)
+            free(files[i]);
+        free(files);
+        vault_index_free(&idx);
+        if (err == VAULT_OK)
+            err = VAULT_ERR_NOMEM;
+        fprintf(stderr, "vault: cannot read working tree: %s\n", error_text(err));
+        return err;
+    }
+
+    /* Bir dosya eklenemezse hata yazdır ama diğerlerine devam et */
+    VaultError result = vault_index_add_batch(&idx, files, file_count, args->jobs, results);
+    for (size_t i = 0; i < file_count; i++) {
+        if (results[i] == VAULT_OK)
+            printf("added: %s\n", files[i]);
+        else
+            fprintf(stderr, "vault: cannot add '%s': %s\n",
+                    files[i], error_text(results[i]));
+    }
+    free(results);
+    for (size_t i = given; i < file_count; i++)
+        free(files[i]);
+    free(files);
+
+    if ((err = vault_index_save(&idx)) != VAULT_OK) {
+        fprintf(stderr, "vault: cannot write index: %s\n", error_text(err));
+        result = err;
+    }
+    vault_index_free(&idx);
+    return result;
+}
+
+/* Commit'in root tree'si: önce commit grafiği, yoksa commit nesnesi */
+static VaultError commit_tree(const VaultCommitGraph *graph, const VaultOid *commit_oid,
+                              VaultOid *out_tree){
+    uint32_t pos;
+    VaultGraphCommit gc;
+    if (vault_graph_find(graph, commit_oid, &pos) &&
+        vault_graph_get(graph, pos, &gc) == VAULT_OK) {
+        *out_tree = gc.tree;
+        return VAULT_OK;
+    }
+
+    VaultObjectView view;
+    VaultError err = vault_object_view(commit_oid, &view);
+    if (err != VAULT_OK)
+        return err;
+    VaultCommit commit;
+    err = vault_commit_deserialize(view.data, view.size, &commit);
+    vault_object_view_release(&view);
+    if (err == VAULT_OK)
+        *out_tree = commit.tree_hash;
+    return err;
+}
+
+/* vault_tree_diff callback'i: değişen her dosyayı sayar */
+static VaultError count_change(const VaultTreeChange *change, void *ctx){
+    (void)change;
+    (*(size_t *)ctx)++;
     return VAULT_OK;
 }
 
 VaultError vault_cmd_commit(const VaultArgs *args){
-    (void) args;
+    VaultError err = require_repo();
+    if (err != VAULT_OK)
+        return err;
+
+    if (args->message[0] == '\0') {
+        fprintf(stderr, "vault: commit message required (use -m \"message\")\n");
+        return VAULT_ERR_NOTFOUND;
+    }
+
+    VaultIndex idx;
+    if ((err = vault_index_load(&idx)) != VAULT_OK) {
+        fprintf(stderr, "vault: cannot read index: %s\n", error_text(err));
+        return err;
+    }
+    if (idx.count == 0) {
+        printf("nothing to commit\n");
+        vault_index_free(&idx);
+        return VAULT_ERR_NOTFOUND;
+    }
+
+    /*
+     * Önce tree kurulur: cache-tree'de geçerli olan dizinler yeniden
+     * oluşturulmaz. Root HEAD'inkiyle aynıysa commit'lenecek bir şey yoktur;
+     * değilse değişen dosyalar tree diff'inden sayılır (aynı alt dizinler
+     * açılmaz). vault_create_commit aynı tree'yi cache-tree'den hemen alır.
+     */
+    VaultOid tree, head, head_tree;
+    size_t changed = 0;
+    vault_oid_clear(&head_tree);
+    err = vault_build_tree(&idx, &tree);
+    if (err != VAULT_OK) {
+        fprintf(stderr, "vault: cannot build tree: %s\n", error_text(err));
+        vault_index_free(&idx);
+        return err;
+    }
+    err = vault_head_read(&head);
+    if (err == VAULT_OK && !vault_oid_is_null(&head)) {
+        VaultCommitGraph graph;
+        if (vault_graph_open(&graph) != VAULT_OK)
+            memset(&graph, 0, sizeof(graph));
+        err = commit_tree(&graph, &head, &head_tree);
+        vault_graph_close(&graph);
+    }
+    if (err != VAULT_OK) {
+        fprintf(stderr, "vault: cannot read HEAD: %s\n", error_text(err));
+        vault_index_free(&idx);
+        return err;
+    }
+    if (vault_oid_equal(&tree, &head_tree)) {
+        printf("nothing to commit, working tree clean\n");
+        vault_index_free(&idx);
+        return VAULT_OK;
+    }
+    if (vault_oid_is_null(&head_tree))
+        changed = idx.count;    /* ilk commit: her dosya yeni */
+    else if ((err = vault_tree_diff(&head_tree, &tree, count_change, &changed)) != VAULT_OK) {
+        fprintf(stderr, "vault: cannot compare with HEAD: %s\n", error_text(err));
+        vault_index_free(&idx);
+        return err;
+    }
+
+    const char *author = args->author[0] ? args->author : getenv("USER");
+    VaultOid oid;
+    err = vault_create_commit(&idx, author ? author : "unknown", args->message, &oid);
+    /* Güncellenen cache-tree sonraki commit için saklanır; hata kritik değil */
+    if (err == VAULT_OK && vault_index_save(&idx) != VAULT_OK)
+        fprintf(stderr, "vault: warning: could not update index cache-tree\n");
+    vault_index_free(&idx);
+    if (err != VAULT_OK) {
+        fprintf(stderr, "vault: commit failed: %s\n", error_text(err));
+        return err;
+    }
+
+    char hex[VAULT_HASH_HEX_SIZE];
+    vault_oid_to_hex(&oid, hex);
+    printf("[main %.7s] %.*s\n", hex, (int)strcspn(args->message, "\n"), args->message);
+    printf(" %zu file%s changed\n", changed, changed == 1 ? "" : "s");
     return VAULT_OK;
 }
 
+static void log_print(const VaultOid *oid, const VaultCommit *commit, long timestamp){
+    char hex[VAULT_HASH_HEX_SIZE];
+    char date[64] = "";
+    time_t t = (time_t)timestamp;
+    struct tm tm;
+    vault_oid_to_hex(oid, hex);
+    if (localtime_r(&t, &tm))
+        strftime(date, sizeof(date), "%a %b %d %H:%M:%S %Y", &tm);
+
+    printf("commit %s\n", hex);
+    printf("Author: %s\n", commit->author);
+    printf("Date:   %s\n\n", date);
+
+    /* Mesajın her satırı 4 boşlukla girintili */
+    const char *line = commit->message;
+    while (*line) {
+        const char *nl = strchr(line, '\n');
+        int len = nl ? (int)(nl - line) : (int)strlen(line);
+        printf("    %.*s\n", len, line);
+        line += len + (nl ? 1 : 0);
+    }
+    printf("\n");
+}
+
 VaultError vault_cmd_log(const VaultArgs *args){
     (void) args;
-    return VAULT_OK;
+
+    VaultError err = require_repo();
+    if (err != VAULT_OK)
+        return err;
+
+    VaultOid cur;
+    if ((err = vault_head_read(&cur)) != VAULT_OK) {
+        fprintf(stderr, "vault: cannot read HEAD: %s\n", error_text(err));
+        return err;
+    }
+    if (vault_oid_is_null(&cur)) {
+        printf("no commits yet\n");
+        return VAULT_OK;
+    }
+
+    /* Gezinme grafikten: parent'a geçmek bir konum okumasıdır. Grafikte
+     * olmayan commit'lerde (ör. eski repo) parent nesneden okunur. */
+    VaultCommitGraph graph;
+    if (vault_graph_open(&graph) != VAULT_OK)
+        memset(&graph, 0, sizeof(graph));
+
+    uint32_t pos;
+    int in_graph = vault_graph_find(&graph, &cur, &pos);
+    while (err == VAULT_OK) {
+        VaultGraphCommit gc;
+        if (in_graph && vault_graph_get(&graph, pos, &gc) != VAULT_OK)
+            in_graph = 0;
+
+        /* Yazar ve mesaj yalnızca commit nesnesinde */
+        VaultObjectView view;
+        VaultCommit commit;
+        if ((err = vault_object_view(&cur, &view)) != VAULT_OK)
+            break;
+        err = vault_commit_deserialize(view.data, view.size, &commit);
+        vault_object_view_release(&view);
+        if (err != VAULT_OK)
+            break;
+
+        log_print(&cur, &commit, in_graph ? gc.timestamp : commit.timestamp);
+
+        if (in_graph) {
+            if (gc.parent == VAULT_GRAPH_NO_PARENT)
+                break;
+            pos = gc.parent;
+            if (vault_graph_get(&graph, pos, &gc) == VAULT_OK)
+                cur = gc.oid;
+            else if (vault_oid_is_null(&commit.parent_hash))
+                break;
+            else
+                cur = commit.parent_hash;
+        } else {
+            if (vault_oid_is_null(&commit.parent_hash))
+                break;
+            cur = commit.parent_hash;
+            in_graph = vault_graph_find(&graph, &cur, &pos);
+        }
+    }
+    vault_graph_close(&graph);
+
+    if (err != VAULT_OK)
+        fprintf(stderr, "vault: cannot read commit: %s\n", error_text(err));
+    return err;
 }
 
 VaultError vault_cmd_status(const VaultArgs *args){
     (void) args;
-    return VAULT_OK;
+
+    VaultError err = require_repo();
+    if (err != VAULT_OK)
+        return err;
+
+    VaultIndex idx;
+    if ((err = vault_index_load(&idx)) != VAULT_OK) {
+        fprintf(stderr, "vault: cannot read index: %s\n", error_text(err));
+        return err;
+    }
+
+    StatusList list = { NULL, NULL, 0, 0, 0 };
+    err = vault_status(&idx, status_collect, &list);
+    /* fsmonitor token'ı ve untracked cache kaydedilemezse bir sonraki
+     * status daha çok bakar */
+    if (err == VAULT_OK && (idx.fsmonitor_changed || idx.untracked_changed) &&
+        vault_index_save(&idx) != VAULT_OK)
+        fprintf(stderr, "vault: warning: could not update %s\n", VAULT_INDEX_FILE);
+    vault_index_free(&idx);
+    if (err == VAULT_OK && list.failed)
+        err = VAULT_ERR_NOMEM;
+
+    if (err != VAULT_OK) {
+        fprintf(stderr, "vault: cannot read working tree: %s\n", error_text(err));
+    } else if (list.count == 0) {
+        printf("nothing to commit, working tree clean\n");
+    } else {
+        int header = 0;
+        for (size_t i = 0; i < list.count; i++) {
+            if (list.codes[i] == 'A')
+                continue;
+            if (!header++)
+                printf("Changes not staged for commit:\n");
+            printf("  %s %s\n", list.codes[i] == 'M' ? "modified:" : "deleted: ",
+                   list.paths[i]);
+        }
+        int untracked = 0;
+        for (size_t i = 0; i < list.count; i++) {
+            if (list.codes[i] != 'A')
+                continue;
+            if (!untracked++)
+                printf("%sUntracked files:\n", header ? "\n" : "");
+            printf("  %s\n", list.paths[i]);
+        }
+    }
+
+    status_list_free(&list);
+    return err;
+}
+
+/* vault_status callback'i: takip edilen bir dosya değişmiş ya da silinmiş mi */
+static void status_dirty(const char *filepath, char status, void *ctx){
+    (void) filepath;
+    if (status != 'A')
+        *(int *)ctx = 1;
 }
 
 VaultError vault_cmd_checkout(const VaultArgs *args){
-    (void) args;
+    VaultError err = require_repo();
+    if (err != VAULT_OK)
+        return err;
+
+    VaultOid target;
+    if (args->target_cnt != 1 || strlen(args->targets[0]) != VAULT_HASH_HEX_SIZE - 1 ||
+        vault_oid_from_hex(args->targets[0], &target) != VAULT_OK) {
+        fprintf(stderr, "usage: vault checkout <commit>\n");
+        return VAULT_ERR_NOTFOUND;
+    }
+
+    VaultCommitGraph graph;
+    if (vault_graph_open(&graph) != VAULT_OK)
+        memset(&graph, 0, sizeof(graph));
+    VaultOid head, head_tree, target_tree;
+    vault_oid_clear(&head_tree);
+    err = commit_tree(&graph, &target, &target_tree);
+    if (err != VAULT_OK)
+        fprintf(stderr, "vault: '%s' is not a commit\n", args->targets[0]);
+    else if ((err = vault_head_read(&head)) == VAULT_OK && !vault_oid_is_null(&head))
+        err = commit_tree(&graph, &head, &head_tree);
+    vault_graph_close(&graph);
+    if (err != VAULT_OK)
+        return err;
+
+    VaultIndex idx;
+    if ((err = vault_index_load(&idx)) != VAULT_OK) {
+        fprintf(stderr, "vault: cannot read index: %s\n", error_text(err));
+        return err;
+    }
+
+    /* Kaydedilmemiş değişiklik: çalışma dizini ≠ index ya da index ≠ HEAD.
+     * İkincisi cache-tree sayesinde yalnızca kirli dizinleri hash'ler. */
+    int dirty = 0;
+    VaultOid staged;
+    vault_oid_clear(&staged);
+    err = vault_status(&idx, status_dirty, &dirty);
+    if (err == VAULT_OK && idx.count > 0)
+        err = vault_build_tree(&idx, &staged);
+    if (err == VAULT_OK && (dirty || !vault_oid_equal(&staged, &head_tree))) {
+        fprintf(stderr, "Error: uncommitted changes. Commit or discard them first.\n");
+        vault_index_free(&idx);
+        return VAULT_ERR_IO;
+    }
+
+    VaultCheckoutStats stats = { 0, 0 };
+    if (err == VAULT_OK)
+        err = vault_checkout_tree(&idx, &head_tree, &target_tree, args->jobs, &stats);
+
+    /* Kısmi bir checkout'ta da index diskteki duruma uyar */
+    VaultError save_err = vault_index_save(&idx);
+    vault_index_free(&idx);
+    if (err == VAULT_OK && (err = save_err) == VAULT_OK)
+        err = vault_head_write(&target);
+    if (err != VAULT_OK) {
+        fprintf(stderr, "vault: checkout failed: %s\n", error_text(err));
+        return err;
+    }
+
+    char hex[VAULT_HASH_HEX_SIZE];
+    vault_oid_to_hex(&target, hex);
+    printf("HEAD is now at %.7s (%zu file%s updated, %zu removed)\n", hex,
+           stats.written, stats.written == 1 ? "" : "s", stats.removed);
+    return VAULT_OK;
+}
+
+/* Çalışma dizinindeki dosyayı tamamen okur; dosya yoksa içerik boştur */
+static VaultError worktree_read(const char *path, char **out_data, size_t *out_size){
+    *out_data = NULL;
+    *out_size = 0;
+
+    FILE *fp = fopen(path, "rb");
+    if (!fp)
+        return errno == ENOENT ? VAULT_OK : VAULT_ERR_IO;
+
+    struct stat st;
+    if (fstat(fileno(fp), &st) != 0 || !S_ISREG(st.st_mode)) {
+        fclose(fp);
+        return VAULT_ERR_IO;
+    }
+
+    size_t size = (size_t)st.st_size;
+    char *data = malloc(size ? size : 1);
+    if (!data) {
+        fclose(fp);
+        return VAULT_ERR_NOMEM;
+    }
+    if (fread(data, 1, size, fp) != size) {
+        free(data);
+        fclose(fp);
+        return VAULT_ERR_IO;
+    }
+    fclose(fp);
+
+    *out_data = data;
+    *out_size = size;
     return VAULT_OK;
 }
 
+/* Index'teki blob ile çalışma dizinindeki dosyanın farkını yazdırır */
+static VaultError diff_entry(const IndexEntry *entry, VaultDiffAlgorithm algorithm){
+    VaultObjectView view;
+    VaultError err = vault_object_view(&entry->hash, &view);
+    if (err != VAULT_OK)
+        return err;
+    if (view.type != VAULT_OBJ_BLOB) {
+        vault_object_view_release(&view);
+        return VAULT_ERR_CORRUPT;
+    }
+
+    char *data = NULL;
+    size_t size = 0;
+    err = worktree_read(entry->filepath, &data, &size);
+
+    DiffResult result;
+    if (err == VAULT_OK &&
+        (err = vault_diff_compute_with((const char *)view.data, view.size, data, size,
+                                       algorithm, &result)) == VAULT_OK) {
+        vault_diff_print(&result, entry->filepath, entry->filepath);
+        vault_diff_free(&result);
+    }
+
+    free(data);
+    vault_object_view_release(&view);
+    return err;
+}
+
+/* 64 karakterlik hex: commit ya da tree → root tree */
+static VaultError resolve_tree(const VaultCommitGraph *graph, const char *hex,
+                               VaultOid *out_tree){
+    VaultOid oid;
+    if (strlen(hex) != VAULT_HASH_HEX_SIZE - 1 || vault_oid_from_hex(hex, &oid) != VAULT_OK)
+        return VAULT_ERR_NOTFOUND;
+
+    uint32_t pos;
+    VaultGraphCommit gc;
+    if (vault_graph_find(graph, &oid, &pos) && vault_graph_get(graph, pos, &gc) == VAULT_OK) {
+        *out_tree = gc.tree;
+        return VAULT_OK;
+    }
+
+    VaultObjectView view;
+    VaultError err = vault_object_view(&oid, &view);
+    if (err != VAULT_OK)
+        return err;
+    if (view.type == VAULT_OBJ_TREE) {
+        *out_tree = oid;
+    } else if (view.type == VAULT_OBJ_COMMIT) {
+        VaultCommit commit;
+        if ((err = vault_commit_deserialize(view.data, view.size, &commit)) == VAULT_OK)
+            *out_tree = commit.tree_hash;
+    } else {
+        err = VAULT_ERR_CORRUPT;
+    }
+    vault_object_view_release(&view);
+    return err;
+}
+
+static VaultError blob_view(const VaultTreeEntry *entry, VaultObjectView *view){
+    memset(view, 0, sizeof(*view));
+    if (!entry)
+        return VAULT_OK;
+    VaultError err = vault_object_view(&entry->hash, view);
+    if (err == VAULT_OK && view->type != VAULT_OBJ_BLOB) {
+        vault_object_view_release(view);
+        err = VAULT_ERR_CORRUPT;
+    }
+    return err;
+}
+
+/* vault_tree_diff callback'i: yalnızca değişen dosyaların blob'ları okunur */
+static VaultError diff_tree_change(const VaultTreeChange *change, void *ctx){
+    const VaultArgs *args = ctx;
+    VaultObjectView old_view, new_view;
+    VaultError err = blob_view(change->old_entry, &old_view);
+    if (err == VAULT_OK && (err = blob_view(change->new_entry, &new_view)) != VAULT_OK)
+        vault_object_view_release(&old_view);
+    if (err != VAULT_OK) {
+        fprintf(stderr, "vault: cannot read '%s': %s\n", change->path, error_text(err));
+        return err;
+    }
+
+    DiffResult result;
+    err = vault_diff_compute_with((const char *)old_view.data, old_view.size,
+                                  (const char *)new_view.data, new_view.size,
+                                  args->diff_algorithm, &result);
+    if (err == VAULT_OK) {
+        vault_diff_print(&result, change->path, change->path);
+        vault_diff_free(&result);
+    }
+    vault_object_view_release(&old_view);
+    vault_object_view_release(&new_view);
+    return err;
+}
+
+/* vault diff <hash1> <hash2>: iki tree'nin merge-walk'u */
+static VaultError diff_revisions(const VaultArgs *args){
+    VaultCommitGraph graph;
+    if (vault_graph_open(&graph) != VAULT_OK)
+        memset(&graph, 0, sizeof(graph));
+
+    VaultOid trees[2];
+    VaultError err = VAULT_OK;
+    for (int i = 0; err == VAULT_OK && i < 2; i++) {
+        if ((err = resolve_tree(&graph, args->targets[i], &trees[i])) != VAULT_OK)
+            fprintf(stderr, "vault: '%s' is not a commit or tree\n", args->targets[i]);
+    }
+    vault_graph_close(&graph);
+
+    if (err == VAULT_OK)
+        err = vault_tree_diff(&trees[0], &trees[1], diff_tree_change, (void *)args);
+    return err;
+}
+
+static int is_full_hex(const char *s){
+    VaultOid oid;
+    return strlen(s) == VAULT_HASH_HEX_SIZE - 1 && vault_oid_from_hex(s, &oid) == VAULT_OK;
+}
+
 VaultError vault_cmd_diff(const VaultArgs *args){
+    VaultError err = require_repo();
+    if (err != VAULT_OK)
+        return err;
+
+    if (args->target_cnt == 2 && is_full_hex(args->targets[0]) && is_full_hex(args->targets[1]))
+        return diff_revisions(args);
+
+    VaultIndex idx;
+    if ((err = vault_index_load(&idx)) != VAULT_OK) {
+        fprintf(stderr, "vault: cannot read index: %s\n", error_text(err));
+        return err;
+    }
+
+    /* Dosya verilmezse stat cache ile değişmiş olanlar bulunur */
+    StatusList list = { NULL, NULL, 0, 0, 0 };
+    if (args->target_cnt == 0) {
+        err = vault_status(&idx, status_collect, &list);
+        if (err == VAULT_OK && list.failed)
+            err = VAULT_ERR_NOMEM;
+        if (err != VAULT_OK)
+            fprintf(stderr, "vault: cannot read working tree: %s\n", error_text(err));
+    }
+
+    size_t total = args->target_cnt ? (size_t)args->target_cnt : list.count;
+    for (size_t i = 0; err == VAULT_OK && i < total; i++) {
+        const char *path = args->target_cnt ? args->targets[i] : list.paths[i];
+        if (!args->target_cnt && list.codes[i] == 'A')
+            continue;
+
+        int pos = vault_index_find(&idx, path);
+        if (pos < 0) {
+            fprintf(stderr, "vault: '%s' is not tracked\n", path);
+            err = VAULT_ERR_NOTFOUND;
+            break;
+        }
+        if ((err = diff_entry(&idx.entries[pos], args->diff_algorithm)) != VAULT_OK)
+            fprintf(stderr, "vault: cannot diff '%s': %s\n", path, error_text(err));
+    }
+
+    status_list_free(&list);
+    vault_index_free(&idx);
+    return err;
+}
+
+VaultError vault_cmd_repack(const VaultArgs *args){
     (void) args;
+
+    VaultError err = require_repo();
+    if (err != VAULT_OK)
+        return err;
+
+    size_t count = 0;
+    err = vault_repack(&count);
+    if (err != VAULT_OK) {
+        fprintf(stderr, "vault: repack failed: %s\n", error_text(err));
+        return err;
+    }
+
+    if (count == 0)
+        printf("nothing to pack\n");
+    else
+        printf("packed %zu objects\n", count);
     return VAULT_OK;
 }
 
+VaultError vault_cmd_fsmonitor(const VaultArgs *args){
+    VaultError err = require_repo();
+    if (err != VAULT_OK)
+        return err;
+
+    const char *action = args->target_cnt == 1 ? args->targets[0] : "";
+    if (strcmp(action, "start") == 0) {
+        if ((err = vault_fsmonitor_run(1)) == VAULT_OK)
+            printf("fsmonitor started\n");
+        else
+            fprintf(stderr, "vault: cannot start fsmonitor\n");
+    } else if (strcmp(action, "run") == 0) {
+        err = vault_fsmonitor_run(0);
+        if (err != VAULT_OK)
+            fprintf(stderr, "vault: fsmonitor failed: %s\n", error_text(err));
+    } else if (strcmp(action, "stop") == 0) {
+        err = vault_fsmonitor_stop();
+        if (err == VAULT_OK)
+            printf("fsmonitor stopped\n");
+        else if (err == VAULT_ERR_NOTFOUND)
+            fprintf(stderr, "vault: fsmonitor is not running\n");
+        else
+            fprintf(stderr, "vault: cannot stop fsmonitor: %s\n", error_text(err));
+    } else {
+        fprintf(stderr, "usage: vault fsmonitor start|stop|run\n");
+        err = VAULT_ERR_NOTFOUND;
+    }
+    return err;
+}
+
+/* ---- Yardımcı ----------------------------------------------------------- */
+
 void vault_cmd_help(void){
+    printf("usage: vault <command> [<args>]\n"
+           "\n"
+           "Commands:\n"
+           "  init       Create a new vault repository\n"
+           "  add        Stage files for commit\n"
+           "  commit     Record changes to the repository\n"
+           "  log        Show commit history\n"
+           "  status     Show working directory status\n"
+           "  checkout   Restore a previous commit\n"
+           "  diff       Show differences between versions\n"
+           "  repack     Pack loose objects into a single pack file\n"
+           "  fsmonitor  Start or stop the file system monitor daemon\n");
 }
 
 void vault_args_free(VaultArgs *args){
-    (void) args;
+    if (args->targets) {
+        for (int i = 0; i < args->target_cnt; i++)
+            free(args->targets[i]);
+        free(args->targets);
+    }
+    args->targets = NULL;
+    args->target_cnt = 0;
 }
 
+/* ---- Ana Dağıtıcı (Dispatcher) ----------------------------------------- */
+
 VaultError vault_dispatch(const VaultArgs *args){
-    (void) args;
-    return VAULT_OK;
+    switch (args->cmd) {
+    case VAULT_CMD_INIT:     return vault_cmd_init(args);
+    case VAULT_CMD_ADD:      return vault_cmd_add(args);
+    case VAULT_CMD_COMMIT:   return vault_cmd_commit(args);
+    case VAULT_CMD_LOG:      return vault_cmd_log(args);
+    case VAULT_CMD_STATUS:   return vault_cmd_status(args);
+    case VAULT_CMD_CHECKOUT: return vault_cmd_checkout(args);
+    case VAULT_CMD_DIFF:     return vault_cmd_diff(args);
+    case VAULT_CMD_REPACK:   return vault_cmd_repack(args);
+    case VAULT_CMD_FSMONITOR: return vault_cmd_fsmonitor(args);
+    case VAULT_CMD_HELP:
+        vault_cmd_help();
+        return VAULT_OK;
+    case VAULT_CMD_UNKNOWN:
+        break;
+    }
+
+    fprintf(stderr, "vault: unknown command. See 'vault help'.\n");
+    return VAULT_ERR_NOTFOUND;
 }
@@ -0,0 +1,341 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "../include/vault_compress.h"
+#include "../include/vault_config.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#include <zlib.h>
+#ifdef VAULT_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+/* ---- Ayarlar ------------------------------------------------------------ */
+
+static pthread_once_t settings_once = PTHREAD_ONCE_INIT;
+static VaultCompressSettings settings = { VAULT_CODEC_ZLIB, -1 };
+
+static void settings_load(void){
+    const char *codec = vault_config_get("core.codec");
+    if (codec && strcasecmp(codec, "zstd") == 0) {
+        if (vault_codec_available(VAULT_CODEC_ZSTD))
+            settings.codec = VAULT_CODEC_ZSTD;
+        else
+            fprintf(stderr, "vault: warning: built without zstd, using zlib\n");
+    } else if (codec && strcasecmp(codec, "none") == 0) {
+        settings.codec = VAULT_CODEC_NONE;
+    } else if (codec && strcasecmp(codec, "zlib") != 0) {
+        fprintf(stderr, "vault: warning: unknown core.codec '%s', using zlib\n", codec);
+    }
+
+    settings.level = vault_config_get_int("core.compression", -1);
+    if (settings.level == 0)
+        settings.codec = VAULT_CODEC_NONE;
+    if (settings.codec == VAULT_CODEC_ZLIB && settings.level > Z_BEST_COMPRESSION)
+        settings.level = Z_BEST_COMPRESSION;
+}
+
+void vault_compress_settings(VaultCompressSettings *out){
+    pthread_once(&settings_once, settings_load);
+    *out = settings;
+}
+
+int vault_codec_available(VaultCodec codec){
+    switch (codec) {
+    case VAULT_CODEC_NONE:
+    case VAULT_CODEC_ZLIB:
+        return 1;
+    case VAULT_CODEC_ZSTD:
+#ifdef VAULT_HAVE_ZSTD
+        return 1;
+#else
+        return 0;
+#endif
+    }
+    return 0;
+}
+
+/* ---- Sonda -------------------------------------------------------------- */
+
+int vault_compress_probe(const uint8_t *data, size_t size){
+    if (size < VAULT_COMPRESS_PROBE_MIN)
+        return 0;
+
+    /* Baş, orta, son: arşivlerin başlıkları tek başına yanıltmasın */
+    uint8_t sample[3 * VAULT_COMPRESS_PROBE_SLICE];
+    size_t slice = VAULT_COMPRESS_PROBE_SLICE;
+    size_t sample_len;
+    if (size <= sizeof(sample)) {
+        memcpy(sample, data, size);
+        sample_len = size;
+    } else {
+        memcpy(sample, data, slice);
+        memcpy(sample + slice, data + (size - slice) / 2, slice);
+        memcpy(sample + 2 * slice, data + size - slice, slice);
+        sample_len = sizeof(sample);
+    }
+
+    /* compressBound(n) < n + n/8 + 64 */
+    uint8_t packed[sizeof(sample) + sizeof(sample) / 8 + 64];
+    uLongf packed_len = sizeof(packed);
+    if (compress2(packed, &packed_len, sample, sample_len, Z_BEST_SPEED) != Z_OK)
+        return 0;
+    return packed_len * 100 > sample_len * (100 - VAULT_COMPRESS_MIN_GAIN);
+}
+
+/* ---- Sıkıştırma --------------------------------------------------------- */
+
+struct VaultCompressor {
+    VaultCodec         codec;
+    VaultCompressSink  sink;
+    void              *ctx;
+    z_stream           zs;
+#ifdef VAULT_HAVE_ZSTD
+    ZSTD_CCtx         *zstd;
+#endif
+    uint8_t            out[VAULT_STREAM_CHUNK];
+};
+
+VaultError vault_compressor_open(VaultCompressor **out, VaultCodec codec, int level,
+                                 VaultCompressSink sink, void *ctx){
+    VaultCompressor *c = calloc(1, sizeof(*c));
+    if (!c)
+        return VAULT_ERR_NOMEM;
+    c->codec = codec;
+    c->sink = sink;
+    c->ctx = ctx;
+
+    switch (codec) {
+    case VAULT_CODEC_NONE:
+        break;
+    case VAULT_CODEC_ZLIB:
+        if (deflateInit(&c->zs, level < 0 ? Z_DEFAULT_COMPRESSION : level) != Z_OK) {
+            free(c);
+            return VAULT_ERR_COMPRESS;
+        }
+        break;
+    case VAULT_CODEC_ZSTD:
+#ifdef VAULT_HAVE_ZSTD
+        c->zstd = ZSTD_createCCtx();
+        if (!c->zstd ||
+            ZSTD_isError(ZSTD_CCtx_setParameter(c->zstd, ZSTD_c_compressionLevel,
+                                                level < 0 ? ZSTD_CLEVEL_DEFAULT : level))) {
+            ZSTD_freeCCtx(c->zstd);
+            free(c);
+            return VAULT_ERR_COMPRESS;
+        }
+        break;
+#endif
+    default:
+        free(c);
+        return VAULT_ERR_COMPRESS;
+    }
+
+    *out = c;
+    return VAULT_OK;
+}
+
+static VaultError zlib_feed(VaultCompressor *c, const uint8_t *data, size_t size, int flush){
+    int zr;
+    do {
+        /* avail_in 32 bit: büyük parçaları bölerek ver */
+        if (c->zs.avail_in == 0 && size > 0) {
+            size_t chunk = size > VAULT_STREAM_CHUNK ? VAULT_STREAM_CHUNK : size;
+            c->zs.next_in  = (Bytef *)data;
+            c->zs.avail_in = (uInt)chunk;
+            data += chunk;
+            size -= chunk;
+        }
+        c->zs.next_out  = c->out;
+        c->zs.avail_out = sizeof(c->out);
+        zr = deflate(&c->zs, size > 0 ? Z_NO_FLUSH : flush);
+        if (zr == Z_STREAM_ERROR)
+            return VAULT_ERR_COMPRESS;
+
+        size_t have = sizeof(c->out) - c->zs.avail_out;
+        if (have) {
+            VaultError err = c->sink(c->out, have, c->ctx);
+            if (err != VAULT_OK)
+                return err;
+        }
+    } while (size > 0 || c->zs.avail_in > 0 || c->zs.avail_out == 0 ||
+             (flush == Z_FINISH && zr != Z_STREAM_END));
+    return VAULT_OK;
+}
+
+#ifdef VAULT_HAVE_ZSTD
+static VaultError zstd_feed(VaultCompressor *c, const uint8_t *data, size_t size,
+                            ZSTD_EndDirective mode){
+    ZSTD_inBuffer in = { data, size, 0 };
+    size_t left;
+    do {
+        ZSTD_outBuffer out = { c->out, sizeof(c->out), 0 };
+        left = ZSTD_compressStream2(c->zstd, &out, &in, mode);
+        if (ZSTD_isError(left))
+            return VAULT_ERR_COMPRESS;
+        if (out.pos) {
+            VaultError err = c->sink(c->out, out.pos, c->ctx);
+            if (err != VAULT_OK)
+                return err;
+        }
+    } while (mode == ZSTD_e_end ? left != 0 : in.pos < in.size);
+    return VAULT_OK;
+}
+#endif
+
+VaultError vault_compressor_write(VaultCompressor *c, const uint8_t *data, size_t size){
+    if (size == 0)
+        return VAULT_OK;
+    switch (c->codec) {
+    case VAULT_CODEC_ZLIB:
+        return zlib_feed(c, data, size, Z_NO_FLUSH);
+#ifdef VAULT_HAVE_ZSTD
+    case VAULT_CODEC_ZSTD:
+        return zstd_feed(c, data, size, ZSTD_e_continue);
+#endif
+    default:
+        return c->sink(data, size, c->ctx);
+    }
+}
+
+VaultError vault_compressor_finish(VaultCompressor *c){
+    switch (c->codec) {
+    case VAULT_CODEC_ZLIB:
+        return zlib_feed(c, NULL, 0, Z_FINISH);
+#ifdef VAULT_HAVE_ZSTD
+    case VAULT_CODEC_ZSTD:
+        return zstd_feed(c, NULL, 0, ZSTD_e_end);
+#endif
+    default:
+        return VAULT_OK;
+    }
+}
+
+void vault_compressor_free(VaultCompressor *c){
+    if (!c)
+        return;
+    if (c->codec == VAULT_CODEC_ZLIB)
+        deflateEnd(&c->zs);
+#ifdef VAULT_HAVE_ZSTD
+    ZSTD_freeCCtx(c->zstd);
+#endif
+    free(c);
+}
+
+/* ---- Açma --------------------------------------------------------------- */
+
+struct VaultDecompressor {
+    VaultCodec  codec;
+    z_stream    zs;
+#ifdef VAULT_HAVE_ZSTD
+    ZSTD_DCtx  *zstd;
+#endif
+};
+
+VaultError vault_decompressor_open(VaultDecompressor **out, VaultCodec codec){
+    VaultDecompressor *d = calloc(1, sizeof(*d));
+    if (!d)
+        return VAULT_ERR_NOMEM;
+    d->codec = codec;
+
+    switch (codec) {
+    case VAULT_CODEC_NONE:
+        break;
+    case VAULT_CODEC_ZLIB:
+        if (inflateInit(&d->zs) != Z_OK) {
+            free(d);
+            return VAULT_ERR_COMPRESS;
+        }
+        break;
+    case VAULT_CODEC_ZSTD:
+#ifdef VAULT_HAVE_ZSTD
+        if (!(d->zstd = ZSTD_createDCtx())) {
+            free(d);
+            return VAULT_ERR_NOMEM;
+        }
+        break;
+#endif
+    default:
+        /* Bilinmeyen ya da bu derlemede olmayan codec */
+        free(d);
+        return VAULT_ERR_COMPRESS;
+    }
+
+    *out = d;
+    return VAULT_OK;
+}
+
+VaultError vault_decompressor_run(VaultDecompressor *d,
+                                  const uint8_t **in, size_t *in_size,
+                                  uint8_t **out, size_t *out_size, int *done){
+    *done = 0;
+    switch (d->codec) {
+    case VAULT_CODEC_ZLIB: {
+        int zr;
+        do {
+            size_t in_chunk = *in_size > UINT32_MAX ? UINT32_MAX : *in_size;
+            size_t out_chunk = *out_size > UINT32_MAX ? UINT32_MAX : *out_size;
+            d->zs.next_in   = (Bytef *)*in;
+            d->zs.avail_in  = (uInt)in_chunk;
+            d->zs.next_out  = *out;
+            d->zs.avail_out = (uInt)out_chunk;
+            zr = inflate(&d->zs, Z_SYNC_FLUSH);
+            size_t used = in_chunk - d->zs.avail_in;
+            size_t made = out_chunk - d->zs.avail_out;
+            *in += used;
+            *in_size -= used;
+            *out += made;
+            *out_size -= made;
+            if (used == 0 && made == 0)
+                break;
+        } while (zr == Z_OK && *in_size > 0 && *out_size > 0);
+
+        if (zr == Z_STREAM_END)
+            *done = 1;
+        else if (zr != Z_OK && zr != Z_BUF_ERROR)
+            return VAULT_ERR_CORRUPT;
+        return VAULT_OK;
+    }
+#ifdef VAULT_HAVE_ZSTD
+    case VAULT_CODEC_ZSTD: {
+        ZSTD_inBuffer  src = { *in, *in_size, 0 };
+        ZSTD_outBuffer dst = { *out, *out_size, 0 };
+        size_t left = ZSTD_decompressStream(d->zstd, &dst, &src);
+        if (ZSTD_isError(left))
+            return VAULT_ERR_CORRUPT;
+        *in += src.pos;
+        *in_size -= src.pos;
+        *out += dst.pos;
+        *out_size -= dst.pos;
+        *done = (left == 0);
+        return VAULT_OK;
+    }
+#endif
+    default: {
+        /* Ham: girdinin tamamı akıştır; girdi bitince akış biter */
+        size_t n = *in_size < *out_size ? *in_size : *out_size;
+        memcpy(*out, *in, n);
+        *in += n;
+        *in_size -= n;
+        *out += n;
+        *out_size -= n;
+        *done = (*in_size == 0);
+        return VAULT_OK;
+    }
+    }
+}
+
+void vault_decompressor_free(VaultDecompressor *d){
+    if (!d)
+        return;
+    if (d->codec == VAULT_CODEC_ZLIB)
+        inflateEnd(&d->zs);
+#ifdef VAULT_HAVE_ZSTD
+    ZSTD_freeDCtx(d->zstd);
+#endif
+    free(d);
+}
@@ -0,0 +1,113 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "../include/vault_config.h"
+
+#include <ctype.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#define CONFIG_LINE_MAX  1024
+
+typedef struct {
+    char *key;                  /* "bölüm.isim" */
+    char *value;
+} ConfigItem;
+
+static pthread_once_t config_once = PTHREAD_ONCE_INIT;
+static ConfigItem *items;
+static size_t item_count;
+
+static char *trim(char *s){
+    while (isspace((unsigned char)*s))
+        s++;
+    char *end = s + strlen(s);
+    while (end > s && isspace((unsigned char)end[-1]))
+        *--end = '\0';
+    return s;
+}
+
+static void config_add(const char *section, const char *name, const char *value){
+    ConfigItem *grown = realloc(items, (item_count + 1) * sizeof(*items));
+    if (!grown)
+        return;
+    items = grown;
+
+    size_t len = strlen(section) + 1 + strlen(name) + 1;
+    char *key = malloc(len);
+    char *copy = strdup(value);
+    if (!key || !copy) {
+        free(key);
+        free(copy);
+        return;
+    }
+    snprintf(key, len, "%s.%s", section, name);
+    items[item_count].key = key;
+    items[item_count].value = copy;
+    item_count++;
+}
+
+static void config_load(void){
+    FILE *fp = fopen(VAULT_CONFIG_FILE, "r");
+    if (!fp)
+        return;
+
+    char line[CONFIG_LINE_MAX];
+    char section[CONFIG_LINE_MAX] = "";
+    while (fgets(line, sizeof(line), fp)) {
+        char *comment = strpbrk(line, "#;");
+        if (comment)
+            *comment = '\0';
+        char *s = trim(line);
+        if (*s == '\0')
+            continue;
+
+        if (*s == '[') {
+            char *close = strchr(s, ']');
+            if (close) {
+                *close = '\0';
+                snprintf(section, sizeof(section), "%s", trim(s + 1));
+            }
+            continue;
+        }
+
+        /* "isim = değer"; değersiz isim Git'teki gibi "true" sayılır */
+        char *eq = strchr(s, '=');
+        if (eq)
+            *eq = '\0';
+        config_add(section, trim(s), eq ? trim(eq + 1) : "true");
+    }
+    fclose(fp);
+}
+
+const char *vault_config_get(const char *key){
+    pthread_once(&config_once, config_load);
+    for (size_t i = item_count; i > 0; i--)
+        if (strcasecmp(items[i - 1].key, key) == 0)
+            return items[i - 1].value;
+    return NULL;
+}
+
+int vault_config_get_int(const char *key, int fallback){
+    const char *value = vault_config_get(key);
+    if (!value || !*value)
+        return fallback;
+    char *end = NULL;
+    long n = strtol(value, &end, 10);
+    return (*end == '\0') ? (int)n : fallback;
+}
+
+int vault_config_get_bool(const char *key, int fallback){
+    const char *value = vault_config_get(key);
+    if (!value || !*value)
+        return fallback;
+    if (strcasecmp(value, "true") == 0 || strcasecmp(value, "yes") == 0 ||
+        strcasecmp(value, "on") == 0 || strcmp(value, "1") == 0)
+        return 1;
+    if (strcasecmp(value, "false") == 0 || strcasecmp(value, "no") == 0 ||
+        strcasecmp(value, "off") == 0 || strcmp(value, "0") == 0)
+        return 0;
+    return fallback;
+}
@@ -0,0 +1,312 @@
+#include "../include/vault_delta.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define DELTA_BLOCK       16          /* base'in indekslendiği blok boyutu */
+#define DELTA_MAX_INSERT  127         /* tek EKLE talimatındaki en fazla byte */
+#define DELTA_MAX_COPY    0xffffffu   /* 3 uzunluk byte'ına sığan en büyük kopya */
+#define DELTA_MAX_PROBES  8           /* aynı blok hash'i için denenecek aday */
+
+/* ---- Çıktı buffer'ı ----------------------------------------------------- */
+
+typedef struct {
+    uint8_t *buf;
+    size_t   len;
+    size_t   cap;
+    size_t   limit;     /* 0 = sınırsız */
+} DeltaBuf;
+
+/* 0 = tamam, -1 = bellek yok, 1 = limit aşıldı */
+static int dbuf_put(DeltaBuf *d, const void *src, size_t n){
+    if (d->limit && d->len + n > d->limit)
+        return 1;
+    if (d->len + n > d->cap) {
+        size_t cap = d->cap ? d->cap : 256;
+        while (cap < d->len + n)
+            cap *= 2;
+        uint8_t *grown = realloc(d->buf, cap);
+        if (!grown)
+            return -1;
+        d->buf = grown;
+        d->cap = cap;
+    }
+    memcpy(d->buf + d->len, src, n);
+    d->len += n;
+    return 0;
+}
+
+static int dbuf_varint(DeltaBuf *d, size_t v){
+    uint8_t tmp[10];
+    size_t n = 0;
+    do {
+        uint8_t b = v & 0x7f;
+        v >>= 7;
+        tmp[n++] = b | (v ? 0x80 : 0);
+    } while (v);
+    return dbuf_put(d, tmp, n);
+}
+
+static int emit_insert(DeltaBuf *d, const uint8_t *src, size_t n){
+    while (n > 0) {
+        uint8_t chunk = (uint8_t)(n > DELTA_MAX_INSERT ? DELTA_MAX_INSERT : n);
+        int r = dbuf_put(d, &chunk, 1);
+        if (r == 0)
+            r = dbuf_put(d, src, chunk);
+        if (r != 0)
+            return r;
+        src += chunk;
+        n -= chunk;
+    }
+    return 0;
+}
+
+static int emit_copy(DeltaBuf *d, size_t off, size_t len){
+    while (len > 0) {
+        size_t chunk = len > DELTA_MAX_COPY ? DELTA_MAX_COPY : len;
+        uint8_t op[8];
+        size_t n = 1;
+        uint8_t cmd = 0x80;
+
+        for (int i = 0; i < 4; i++) {
+            uint8_t b = (uint8_t)(off >> (8 * i));
+            if (b) {
+                cmd |= (uint8_t)(1u << i);
+                op[n++] = b;
+            }
+        }
+        for (int i = 0; i < 3; i++) {
+            uint8_t b = (uint8_t)(chunk >> (8 * i));
+            if (b) {
+                cmd |= (uint8_t)(0x10u << i);
+                op[n++] = b;
+            }
+        }
+        op[0] = cmd;
+
+        int r = dbuf_put(d, op, n);
+        if (r != 0)
+            return r;
+        off += chunk;
+        len -= chunk;
+    }
+    return 0;
+}
+
+/* ---- Blok indeksi ------------------------------------------------------- */
+
+/*
+ * Rabin-Karp: h = Σ p[i] · B^(BLOCK-1-i) (mod 2^32). Hedefte bir byte
+ * ilerlerken çıkan byte'ın katkısı düşülüp giren eklenir; her offset'te
+ * bloğu baştan hash'lemek gerekmez. Slot, çarpımın üst bitlerinden seçilir
+ * (alt bitler yalnızca byte'ların alt bitlerine bağlıdır).
+ */
+#define DELTA_HASH_MULT  0x01000193u
+
+static uint32_t block_hash(const uint8_t *p){
+    uint32_t h = 0;
+    for (int i = 0; i < DELTA_BLOCK; i++)
+        h = h * DELTA_HASH_MULT + p[i];
+    return h;
+}
+
+/* B^(BLOCK-1): bloktan çıkan byte'ın ağırlığı */
+static uint32_t block_hash_out_weight(void){
+    uint32_t w = 1;
+    for (int i = 0; i < DELTA_BLOCK - 1; i++)
+        w *= DELTA_HASH_MULT;
+    return w;
+}
+
+static size_t block_slot(uint32_t h, unsigned bits){
+    return (size_t)((h * 0x9E3779B1u) >> (32 - bits));
+}
+
+/* ---- Delta üretme ------------------------------------------------------- */
+
+VaultError vault_delta_create(const uint8_t *base, size_t base_size,
+                              const uint8_t *target, size_t target_size,
+                              size_t max_size,
+                              uint8_t **out_delta, size_t *out_size){
+    /* Kopya offset'i 4 byte: 4 GB'tan büyük base'ler delta'lanmaz */
+    if (base_size < DELTA_BLOCK || base_size > 0xffffffffu)
+        return VAULT_ERR_NOTFOUND;
+
+    size_t blocks = base_size / DELTA_BLOCK;
+    unsigned bits = 4;
+    while (((size_t)1 << bits) < blocks * 2)
+        bits++;
+    size_t slots = (size_t)1 << bits;
+
+    /* slot değeri: blok başlangıcı + 1 (0 = boş) */
+    size_t *table = calloc(slots, sizeof(size_t));
+    if (!table)
+        return VAULT_ERR_NOMEM;
+
+    /*
+     * Arama yalnızca DELTA_MAX_PROBES slota baktığı için ekleme de o kadar
+     * ilerler; yer yoksa blok atlanır (git'teki HASH_LIMIT). Aksi halde
+     * tekrarlı bir base'in (ör. sıfırlarla dolu) aynı bloklarının hepsi tek
+     * bir kümeye düşer ve indeks kurmak blok sayısının karesi kadar sürer.
+     * Önce gelen blok tutulur: uzun kopyalar base'in başından başlar.
+     */
+    for (size_t i = 0; i < blocks; i++) {
+        size_t pos = i * DELTA_BLOCK;
+        size_t s = block_slot(block_hash(base + pos), bits);
+        for (int probe = 0; probe < DELTA_MAX_PROBES; probe++) {
+            if (!table[s]) {
+                table[s] = pos + 1;
+                break;
+            }
+            s = (s + 1) & (slots - 1);
+        }
+    }
+
+    DeltaBuf d = { NULL, 0, 0, max_size };
+    int r = dbuf_varint(&d, base_size);
+    if (r == 0)
+        r = dbuf_varint(&d, target_size);
+
+    const uint32_t out_weight = block_hash_out_weight();
+    size_t t = 0;
+    size_t ins_start = 0;
+    uint32_t h = target_size >= DELTA_BLOCK ? block_hash(target) : 0;
+    while (r == 0 && t + DELTA_BLOCK <= target_size) {
+        /* Bekleyen EKLE verisi de çıktıya girecek: sınırı aştıysa umut yok */
+        if (max_size && d.len + (t - ins_start) > max_size) {
+            r = 1;
+            break;
+        }
+
+        size_t best_off = 0, best_len = 0;
+        size_t s = block_slot(h, bits);
+
+        for (int probe = 0; probe < DELTA_MAX_PROBES && table[s]; probe++) {
+            size_t off = table[s] - 1;
+            s = (s + 1) & (slots - 1);
+            if (memcmp(base + off, target + t, DELTA_BLOCK) != 0)
+                continue;
+
+            size_t len = DELTA_BLOCK;
+            while (off + len < base_size && t + len < target_size &&
+                   base[off + len] == target[t + len])
+                len++;
+            if (len > best_len) {
+                best_len = len;
+                best_off = off;
+            }
+        }
+
+        if (best_len == 0) {
+            if (t + DELTA_BLOCK < target_size)
+                h = (h - target[t] * out_weight) * DELTA_HASH_MULT + target[t + DELTA_BLOCK];
+            t++;
+            continue;
+        }
+
+        /* Eşleşmeyi bekleyen EKLE verisinin içine doğru geri genişlet */
+        while (t > ins_start && best_off > 0 && base[best_off - 1] == target[t - 1]) {
+            t--;
+            best_off--;
+            best_len++;
+        }
+
+        r = emit_insert(&d, target + ins_start, t - ins_start);
+        if (r == 0)
+            r = emit_copy(&d, best_off, best_len);
+        t += best_len;
+        ins_start = t;
+        if (t + DELTA_BLOCK <= target_size)
+            h = block_hash(target + t);
+    }
+    if (r == 0)
+        r = emit_insert(&d, target + ins_start, target_size - ins_start);
+
+    free(table);
+    if (r != 0) {
+        free(d.buf);
+        return (r < 0) ? VAULT_ERR_NOMEM : VAULT_ERR_NOTFOUND;
+    }
+
+    *out_delta = d.buf;
+    *out_size = d.len;
+    return VAULT_OK;
+}
+
+/* ---- Delta uygulama ----------------------------------------------------- */
+
+static int read_varint(const uint8_t **p, const uint8_t *end, size_t *out){
+    size_t v = 0;
+    unsigned shift = 0;
+    while (*p < end && shift < 64) {
+        uint8_t b = *(*p)++;
+        v |= (size_t)(b & 0x7f) << shift;
+        if (!(b & 0x80)) {
+            *out = v;
+            return 0;
+        }
+        shift += 7;
+    }
+    return -1;
+}
+
+VaultError vault_delta_apply(const uint8_t *base, size_t base_size,
+                             const uint8_t *delta, size_t delta_size,
+                             uint8_t **out_data, size_t *out_size){
+    const uint8_t *p   = delta;
+    const uint8_t *end = delta + delta_size;
+    size_t src_size, dst_size;
+
+    if (read_varint(&p, end, &src_size) != 0 || src_size != base_size ||
+        read_varint(&p, end, &dst_size) != 0)
+        return VAULT_ERR_CORRUPT;
+
+    uint8_t *out = malloc(dst_size + 1);
+    if (!out)
+        return VAULT_ERR_NOMEM;
+
+    size_t len = 0;
+    while (p < end) {
+        uint8_t cmd = *p++;
+        if (cmd & 0x80) {
+            size_t off = 0, n = 0;
+            for (int i = 0; i < 4; i++)
+                if (cmd & (1u << i)) {
+                    if (p >= end)
+                        goto corrupt;
+                    off |= (size_t)*p++ << (8 * i);
+                }
+            for (int i = 0; i < 3; i++)
+                if (cmd & (0x10u << i)) {
+                    if (p >= end)
+                        goto corrupt;
+                    n |= (size_t)*p++ << (8 * i);
+                }
+            if (n == 0)
+                n = 0x10000;
+            if (off > base_size || n > base_size - off || n > dst_size - len)
+                goto corrupt;
+            memcpy(out + len, base + off, n);
+            len += n;
+        } else if (cmd) {
+            if (cmd > (size_t)(end - p) || cmd > dst_size - len)
+                goto corrupt;
+            memcpy(out + len, p, cmd);
+            p += cmd;
+            len += cmd;
+        } else {
+            goto corrupt;   /* 0 rezerve */
+        }
+    }
+    if (len != dst_size)
+        goto corrupt;
+
+    out[len] = '\0';
+    *out_data = out;
+    *out_size = len;
+    return VAULT_OK;
+
+corrupt:
+    free(out);
+    return VAULT_ERR_CORRUPT;
+}
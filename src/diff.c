@@ -1,23 +1,767 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include "../include/vault_cli.h"
 
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Myers O(ND) fark algoritması, doğrusal bellekli (divide & conquer) hali.
+ * Yapı GNU diff'in diffseq'ine dayanır: her adımda orta yılan (middle snake)
+ * ileri ve geri aramalarla bulunur, problem ikiye bölünür. Bellek O(N + M),
+ * zaman O((N + M) * D).
+ */
+
+/* ---- Tokenizer ---------------------------------------------------------- */
+
+/*
+ * Her girdi bir kez taranır ve satırlar kaynak tampona işaret eden dizilere
+ * (offset, uzunluk, hash, denklik id'si) ayrılır; satır metni kopyalanmaz.
+ * Aynı içerikli satırlar (iki girdi arasında da) aynı id'yi alır, bu yüzden
+ * fark çekirdeği yalnızca tamsayı karşılaştırır. hash ve id yalnızca ortak
+ * baş/son kırpıldıktan sonra kalan satırlar için doldurulur.
+ */
+typedef struct {
+    const char *base;
+    size_t      count;
+    size_t     *offset;
+    size_t     *length;         /* Varsa '\n' dahil */
+    uint64_t   *hash;
+    uint32_t   *id;
+} DiffTokens;
+
+/*
+ * Satır içeriği → id. Açık adresleme; slot'taki id 0 ise boş. ref, id'yi ilk
+ * alan satırdır: üst bit hangi girdi olduğunu, kalanı satır numarasını tutar.
+ */
+typedef struct {
+    uint64_t hash;
+    uint32_t id;
+    uint32_t ref;
+} InternSlot;
+
+#define INTERN_REF_NEW  0x80000000u
+
+typedef struct {
+    InternSlot       *slots;
+    size_t            mask;
+    uint32_t          next_id;
+    const DiffTokens *sides[2];
+} InternTable;
+
+/* FNV-1a, 8 byte'lık adımlarla: her kelime tek çarpmayla karıştırılır */
+static uint64_t line_hash(const char *text, size_t len){
+    uint64_t h = 0xcbf29ce484222325ull ^ len;
+    size_t i = 0;
+    for (; i + 8 <= len; i += 8) {
+        uint64_t w;
+        memcpy(&w, text + i, 8);
+        h = (h ^ w) * 0x100000001b3ull;
+        h ^= h >> 29;
+    }
+    for (; i < len; i++)
+        h = (h ^ (uint8_t)text[i]) * 0x100000001b3ull;
+    return h ^ (h >> 32);
+}
+
+static VaultError tokens_init(DiffTokens *tok, const char *text, size_t size){
+    memset(tok, 0, sizeof(*tok));
+    tok->base = text;
+
+    /* Satır sayısı: memchr libc'de vektörize newline taramasıdır */
+    size_t count = 0;
+    for (const char *p = text, *end = text + size;
+         p < end && (p = memchr(p, '\n', (size_t)(end - p))) != NULL; p++)
+        count++;
+    if (size > 0 && text[size - 1] != '\n')
+        count++;
+    if (count > INT_MAX)
+        return VAULT_ERR_CORRUPT;
+
+    size_t n = count ? count : 1;
+    tok->offset = malloc(n * sizeof(*tok->offset));
+    tok->length = malloc(n * sizeof(*tok->length));
+    tok->hash   = malloc(n * sizeof(*tok->hash));
+    tok->id     = malloc(n * sizeof(*tok->id));
+    if (!tok->offset || !tok->length || !tok->hash || !tok->id)
+        return VAULT_ERR_NOMEM;
+
+    size_t start = 0;
+    for (size_t i = 0; i < count; i++) {
+        const char *nl = memchr(text + start, '\n', size - start);
+        size_t stop = nl ? (size_t)(nl - text) + 1 : size;
+        tok->offset[i] = start;
+        tok->length[i] = stop - start;
+        start = stop;
+    }
+    tok->count = count;
+    return VAULT_OK;
+}
+
+static void tokens_free(DiffTokens *tok){
+    free(tok->offset);
+    free(tok->length);
+    free(tok->hash);
+    free(tok->id);
+}
+
+static int tokens_equal(const DiffTokens *a, size_t i, const DiffTokens *b, size_t j){
+    return a->length[i] == b->length[j] &&
+           memcmp(a->base + a->offset[i], b->base + b->offset[j], a->length[i]) == 0;
+}
+
+/* [begin, end) aralığındaki satırları hash'leyip id verir */
+static void tokens_intern(InternTable *table, DiffTokens *tok, size_t begin, size_t end,
+                          uint32_t side){
+    for (size_t i = begin; i < end; i++) {
+        const char *text = tok->base + tok->offset[i];
+        size_t len = tok->length[i];
+        tok->hash[i] = line_hash(text, len);
+        size_t pos = (size_t)tok->hash[i] & table->mask;
+        for (;;) {
+            InternSlot *slot = &table->slots[pos];
+            if (slot->id == 0) {
+                slot->hash = tok->hash[i];
+                slot->id   = table->next_id++;
+                slot->ref  = (uint32_t)i | side;
+                tok->id[i] = slot->id;
+                break;
+            }
+            if (slot->hash == tok->hash[i]) {
+                const DiffTokens *other = table->sides[slot->ref >> 31];
+                size_t line = slot->ref & ~INTERN_REF_NEW;
+                if (other->length[line] == len &&
+                    memcmp(other->base + other->offset[line], text, len) == 0) {
+                    tok->id[i] = slot->id;
+                    break;
+                }
+            }
+            pos = (pos + 1) & table->mask;
+        }
+    }
+}
+
+/* ---- Orta yılan --------------------------------------------------------- */
+
+typedef struct {
+    const uint32_t *old_ids;
+    const uint32_t *new_ids;
+    char       *old_changed;    /* old_changed[i] = 1 → eski satır silindi */
+    char       *new_changed;    /* new_changed[j] = 1 → yeni satır eklendi */
+    long       *fdiag;          /* İleri arama: köşegen k için en uzak x */
+    long       *bdiag;          /* Geri arama: köşegen k için en yakın x */
+    long        too_expensive;  /* Maliyet tavanı */
+
+    /* Patience / histogram için id ile indekslenen geçici diziler. Her çağrı
+     * kullandığı girişleri dönmeden (ve alt problemlere inmeden) sıfırlar. */
+    uint32_t   *old_count;
+    uint32_t   *new_count;
+    uint32_t   *old_pos;        /* Histogram: id zincirinin başı (son görülen x) */
+    uint32_t   *new_pos;        /* Patience: id'nin yeni taraftaki konumu */
+    uint32_t   *chain;          /* Histogram: x → aynı id'nin önceki konumu */
+} DiffContext;
+
+typedef struct {
+    long xmid, ymid;
+    int  lo_minimal;            /* Sol yarı tam (minimal) aranmalı mı */
+    int  hi_minimal;
+} DiffPartition;
+
+#define XY_EQUAL(ctx, x, y) ((ctx)->old_ids[x] == (ctx)->new_ids[y])
+
+/*
+ * [xoff, xlim) x [yoff, ylim) için orta yılanı bulur. Maliyet tavanı aşılırsa
+ * ve find_minimal 0 ise o ana kadar en ileri gidilen köşegende bölünür;
+ * sonuç minimal olmayabilir ama hâlâ geçerli bir farktır.
+ */
+static void diff_split(DiffContext *ctx, long xoff, long xlim, long yoff, long ylim,
+                       int find_minimal, DiffPartition *part){
+    long *const fd = ctx->fdiag;
+    long *const bd = ctx->bdiag;
+    const long dmin = xoff - ylim;
+    const long dmax = xlim - yoff;
+    const long fmid = xoff - yoff;
+    const long bmid = xlim - ylim;
+    long fmin = fmid, fmax = fmid;
+    long bmin = bmid, bmax = bmid;
+    const int odd = (fmid - bmid) & 1;
+
+    fd[fmid] = xoff;
+    bd[bmid] = xlim;
+
+    for (long c = 1;; c++) {
+        long d;
+
+        /* İleri arama */
+        if (fmin > dmin)
+            fd[--fmin - 1] = -1;
+        else
+            ++fmin;
+        if (fmax < dmax)
+            fd[++fmax + 1] = -1;
+        else
+            --fmax;
+        for (d = fmax; d >= fmin; d -= 2) {
+            long tlo = fd[d - 1], thi = fd[d + 1];
+            long x = tlo >= thi ? tlo + 1 : thi;
+            long y = x - d;
+            while (x < xlim && y < ylim && XY_EQUAL(ctx, x, y)) {
+                x++;
+                y++;
+            }
+            fd[d] = x;
+            if (odd && bmin <= d && d <= bmax && bd[d] <= x) {
+                part->xmid = x;
+                part->ymid = y;
+                part->lo_minimal = part->hi_minimal = 1;
+                return;
+            }
+        }
+
+        /* Geri arama */
+        if (bmin > dmin)
+            bd[--bmin - 1] = LONG_MAX;
+        else
+            ++bmin;
+        if (bmax < dmax)
+            bd[++bmax + 1] = LONG_MAX;
+        else
+            --bmax;
+        for (d = bmax; d >= bmin; d -= 2) {
+            long tlo = bd[d - 1], thi = bd[d + 1];
+            long x = tlo < thi ? tlo : thi - 1;
+            long y = x - d;
+            while (xoff < x && yoff < y && XY_EQUAL(ctx, x - 1, y - 1)) {
+                x--;
+                y--;
+            }
+            bd[d] = x;
+            if (!odd && fmin <= d && d <= fmax && x <= fd[d]) {
+                part->xmid = x;
+                part->ymid = y;
+                part->lo_minimal = part->hi_minimal = 1;
+                return;
+            }
+        }
+
+        if (find_minimal || c < ctx->too_expensive)
+            continue;
+
+        /* Tavan aşıldı: ileri ve geri aramanın en çok ilerlediği noktayı seç */
+        long fxybest = -1, fxbest = 0;
+        for (d = fmax; d >= fmin; d -= 2) {
+            long x = fd[d] < xlim ? fd[d] : xlim;
+            long y = x - d;
+            if (ylim < y) {
+                x = ylim + d;
+                y = ylim;
+            }
+            if (fxybest < x + y) {
+                fxybest = x + y;
+                fxbest = x;
+            }
+        }
+        long bxybest = LONG_MAX, bxbest = 0;
+        for (d = bmax; d >= bmin; d -= 2) {
+            long x = bd[d] > xoff ? bd[d] : xoff;
+            long y = x - d;
+            if (y < yoff) {
+                x = yoff + d;
+                y = yoff;
+            }
+            if (x + y < bxybest) {
+                bxybest = x + y;
+                bxbest = x;
+            }
+        }
+
+        if ((xlim + ylim) - bxybest < fxybest - (xoff + yoff)) {
+            part->xmid = fxbest;
+            part->ymid = fxybest - fxbest;
+            part->lo_minimal = 1;
+            part->hi_minimal = 0;
+        } else {
+            part->xmid = bxbest;
+            part->ymid = bxybest - bxbest;
+            part->lo_minimal = 0;
+            part->hi_minimal = 1;
+        }
+        return;
+    }
+}
+
+/* Ortak baş/son kırpılır, kalan orta yılanla bölünür. Sağ yarı döngüyle. */
+static void diff_compare(DiffContext *ctx, long xoff, long xlim, long yoff, long ylim,
+                         int find_minimal){
+    for (;;) {
+        while (xoff < xlim && yoff < ylim && XY_EQUAL(ctx, xoff, yoff)) {
+            xoff++;
+            yoff++;
+        }
+        while (xoff < xlim && yoff < ylim && XY_EQUAL(ctx, xlim - 1, ylim - 1)) {
+            xlim--;
+            ylim--;
+        }
+
+        if (xoff == xlim) {
+            while (yoff < ylim)
+                ctx->new_changed[yoff++] = 1;
+            return;
+        }
+        if (yoff == ylim) {
+            while (xoff < xlim)
+                ctx->old_changed[xoff++] = 1;
+            return;
+        }
+
+        DiffPartition part;
+        diff_split(ctx, xoff, xlim, yoff, ylim, find_minimal, &part);
+        diff_compare(ctx, xoff, part.xmid, yoff, part.ymid, part.lo_minimal);
+        xoff = part.xmid;
+        yoff = part.ymid;
+        find_minimal = part.hi_minimal;
+    }
+}
+
+/* ---- Patience ----------------------------------------------------------- */
+
+/*
+ * Patience diff: iki tarafta da tam bir kez geçen satırlar çapa adayıdır.
+ * Adaylar eski sırada dizilir ve yeni taraftaki konumlarının en uzun artan
+ * alt dizisi (patience sorting, O(k log k)) çapa olarak seçilir. Çapalar
+ * problemi bağımsız küçük parçalara böler; her parça aynı yolla çözülür.
+ * Çapa yoksa parça Myers ile çözülür.
+ */
+typedef struct {
+    uint32_t x, y;
+} DiffAnchor;
+
+static void mark_range(DiffContext *ctx, long xoff, long xlim, long yoff, long ylim){
+    while (xoff < xlim)
+        ctx->old_changed[xoff++] = 1;
+    while (yoff < ylim)
+        ctx->new_changed[yoff++] = 1;
+}
+
+static VaultError diff_patience(DiffContext *ctx, long xoff, long xlim, long yoff, long ylim){
+    while (xoff < xlim && yoff < ylim && XY_EQUAL(ctx, xoff, yoff)) {
+        xoff++;
+        yoff++;
+    }
+    while (xoff < xlim && yoff < ylim && XY_EQUAL(ctx, xlim - 1, ylim - 1)) {
+        xlim--;
+        ylim--;
+    }
+    if (xoff == xlim || yoff == ylim) {
+        mark_range(ctx, xoff, xlim, yoff, ylim);
+        return VAULT_OK;
+    }
+
+    /* Tekil satırlar */
+    for (long x = xoff; x < xlim; x++)
+        ctx->old_count[ctx->old_ids[x]]++;
+    for (long y = yoff; y < ylim; y++) {
+        ctx->new_count[ctx->new_ids[y]]++;
+        ctx->new_pos[ctx->new_ids[y]] = (uint32_t)y;
+    }
+
+    size_t span = (size_t)(xlim - xoff);
+    DiffAnchor *cand = malloc(span * sizeof(*cand));
+    uint32_t *tails = malloc(span * sizeof(*tails));
+    uint32_t *prev = malloc(span * sizeof(*prev));
+    size_t k = 0, piles = 0;
+    if (cand && tails && prev) {
+        for (long x = xoff; x < xlim; x++) {
+            uint32_t id = ctx->old_ids[x];
+            if (ctx->old_count[id] == 1 && ctx->new_count[id] == 1) {
+                cand[k].x = (uint32_t)x;
+                cand[k++].y = ctx->new_pos[id];
+            }
+        }
+    }
+    for (long x = xoff; x < xlim; x++)
+        ctx->old_count[ctx->old_ids[x]] = 0;
+    for (long y = yoff; y < ylim; y++)
+        ctx->new_count[ctx->new_ids[y]] = 0;
+
+    if (!cand || !tails || !prev) {
+        free(cand);
+        free(tails);
+        free(prev);
+        return VAULT_ERR_NOMEM;
+    }
+
+    /* En uzun artan alt dizi: tails[p] = uzunluğu p + 1 olan dizinin son adayı */
+    for (size_t i = 0; i < k; i++) {
+        size_t lo = 0, hi = piles;
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (cand[tails[mid]].y < cand[i].y)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        prev[i] = lo > 0 ? tails[lo - 1] : UINT32_MAX;
+        tails[lo] = (uint32_t)i;
+        if (lo == piles)
+            piles++;
+    }
+
+    VaultError err = VAULT_OK;
+    if (piles == 0) {
+        diff_compare(ctx, xoff, xlim, yoff, ylim, 0);
+    } else {
+        /* Zinciri sondan geri izle; çapaları cand'ın başına sırayla yerleştir */
+        size_t n = piles;
+        for (uint32_t i = tails[piles - 1]; i != UINT32_MAX; i = prev[i])
+            tails[--n] = i;
+        for (size_t i = 0; i < piles; i++)
+            cand[i] = cand[tails[i]];
+
+        long x = xoff, y = yoff;
+        for (size_t i = 0; err == VAULT_OK && i <= piles; i++) {
+            long ax = i < piles ? (long)cand[i].x : xlim;
+            long ay = i < piles ? (long)cand[i].y : ylim;
+            err = diff_patience(ctx, x, ax, y, ay);
+            x = ax + 1;
+            y = ay + 1;
+        }
+    }
+
+    free(cand);
+    free(tails);
+    free(prev);
+    return err;
+}
+
+/* ---- Histogram ---------------------------------------------------------- */
+
+/*
+ * Histogram diff (JGit / git xhistogram): eski taraftaki her id'nin geçiş
+ * sayısı tutulur. Yeni taraf taranır ve eşleşen her satırdan iki yöne
+ * genişletilen ortak bölgelerden, içindeki en seyrek satırı en seyrek olan
+ * (eşitlikte en uzun) seçilir. Problem bu bölgenin iki yanına bölünür.
+ * Bir satır VAULT_DIFF_HISTOGRAM_MAX_CHAIN'den sık geçiyorsa aday sayılmaz;
+ * hiç aday kalmazsa parça Myers ile çözülür.
+ */
+static VaultError diff_histogram(DiffContext *ctx, long xoff, long xlim, long yoff, long ylim){
+    for (;;) {
+        while (xoff < xlim && yoff < ylim && XY_EQUAL(ctx, xoff, yoff)) {
+            xoff++;
+            yoff++;
+        }
+        while (xoff < xlim && yoff < ylim && XY_EQUAL(ctx, xlim - 1, ylim - 1)) {
+            xlim--;
+            ylim--;
+        }
+        if (xoff == xlim || yoff == ylim) {
+            mark_range(ctx, xoff, xlim, yoff, ylim);
+            return VAULT_OK;
+        }
+
+        /* Histogram: old_pos[id] zincirin başı, chain[x] bir önceki geçiş */
+        for (long x = xoff; x < xlim; x++) {
+            uint32_t id = ctx->old_ids[x];
+            ctx->chain[x] = ctx->old_count[id] ? ctx->old_pos[id] : UINT32_MAX;
+            ctx->old_pos[id] = (uint32_t)x;
+            ctx->old_count[id]++;
+        }
+
+        long bx = 0, by = 0, blen = 0;
+        uint32_t best = VAULT_DIFF_HISTOGRAM_MAX_CHAIN + 1;
+        int common = 0;
+        for (long y = yoff; y < ylim; ) {
+            uint32_t id = ctx->new_ids[y];
+            uint32_t cnt = ctx->old_count[id];
+            long next_y = y + 1;
+            if (cnt == 0) {
+                y = next_y;
+                continue;
+            }
+            common = 1;
+            if (cnt > best) {
+                y = next_y;
+                continue;
+            }
+
+            for (uint32_t x = ctx->old_pos[id]; x != UINT32_MAX; x = ctx->chain[x]) {
+                long as = (long)x, bs = y, ae = (long)x + 1, be = y + 1;
+                uint32_t rc = cnt;
+                while (as > xoff && bs > yoff && XY_EQUAL(ctx, as - 1, bs - 1)) {
+                    as--;
+                    bs--;
+                    if (rc > ctx->old_count[ctx->old_ids[as]])
+                        rc = ctx->old_count[ctx->old_ids[as]];
+                }
+                while (ae < xlim && be < ylim && XY_EQUAL(ctx, ae, be)) {
+                    if (rc > ctx->old_count[ctx->old_ids[ae]])
+                        rc = ctx->old_count[ctx->old_ids[ae]];
+                    ae++;
+                    be++;
+                }
+                if (next_y < be)
+                    next_y = be;
+                if (rc < best || (rc == best && ae - as > blen)) {
+                    best = rc;
+                    bx = as;
+                    by = bs;
+                    blen = ae - as;
+                }
+            }
+            y = next_y;
+        }
+
+        for (long x = xoff; x < xlim; x++)
+            ctx->old_count[ctx->old_ids[x]] = 0;
+
+        if (blen == 0) {
+            if (common)
+                diff_compare(ctx, xoff, xlim, yoff, ylim, 0);
+            else
+                mark_range(ctx, xoff, xlim, yoff, ylim);
+            return VAULT_OK;
+        }
+
+        /* Küçük yarı özyinelemeyle, büyük yarı döngüyle: derinlik O(log n) */
+        long lx = bx, ly = by;
+        long rx = bx + blen, ry = by + blen;
+        VaultError err;
+        if ((lx - xoff) + (ly - yoff) < (xlim - rx) + (ylim - ry)) {
+            err = diff_histogram(ctx, xoff, lx, yoff, ly);
+            xoff = rx;
+            yoff = ry;
+        } else {
+            err = diff_histogram(ctx, rx, xlim, ry, ylim);
+            xlim = lx;
+            ylim = ly;
+        }
+        if (err != VAULT_OK)
+            return err;
+    }
+}
+
+/* ---- Sonuç -------------------------------------------------------------- */
+
+static VaultError result_push(DiffResult *result, char op, const DiffTokens *tok,
+                              size_t line, int line_old, int line_new){
+    if (result->count == result->capacity) {
+        size_t cap = result->capacity ? result->capacity * 2 : 64;
+        DiffLine *grown = realloc(result->lines, cap * sizeof(*grown));
+        if (!grown)
+            return VAULT_ERR_NOMEM;
+        result->lines = grown;
+        result->capacity = cap;
+    }
+
+    const char *text = tok->base + tok->offset[line];
+    size_t len = tok->length[line];
+    if (len > 0 && text[len - 1] == '\n')
+        len--;
+
+    DiffLine *dl = &result->lines[result->count++];
+    dl->op = op;
+    dl->text = text;
+    dl->len = len;
+    dl->line_old = line_old;
+    dl->line_new = line_new;
+    return VAULT_OK;
+}
+
 VaultError vault_diff_compute(const char *old_text, size_t old_size,
                               const char *new_text, size_t new_size,
                               DiffResult *result){
-    (void) old_text;
-    (void) old_size;
-    (void) new_text;
-    (void) new_size;
-    (void) result;
-    return VAULT_OK;
+    return vault_diff_compute_with(old_text, old_size, new_text, new_size,
+                                   VAULT_DIFF_MYERS, result);
+}
+
+VaultError vault_diff_compute_with(const char *old_text, size_t old_size,
+                                   const char *new_text, size_t new_size,
+                                   VaultDiffAlgorithm algorithm,
+                                   DiffResult *result){
+    memset(result, 0, sizeof(*result));
+
+    DiffTokens a, b;
+    InternTable table = { NULL, 0, 1, { &a, &b } };
+    DiffContext ctx = { 0 };
+    VaultError err = tokens_init(&a, old_text, old_size);
+    if (err == VAULT_OK)
+        err = tokens_init(&b, new_text, new_size);
+    else
+        memset(&b, 0, sizeof(b));
+    if (err != VAULT_OK)
+        goto done;
+
+    size_t n = a.count, m = b.count;
+
+    /* Ortak baş ve son doğrudan karşılaştırılır: hash'leme, id tablosu ve
+     * köşegen dizileri yalnızca ortadaki bölge için yapılır */
+    size_t pre = 0;
+    while (pre < n && pre < m && tokens_equal(&a, pre, &b, pre))
+        pre++;
+    size_t suf = 0;
+    while (suf < n - pre && suf < m - pre && tokens_equal(&a, n - 1 - suf, &b, m - 1 - suf))
+        suf++;
+
+    size_t mid_n = n - pre - suf, mid_m = m - pre - suf;
+
+    /* Tablo en az %50 boş kalır */
+    size_t cap = 16;
+    while (cap < 2 * (mid_n + mid_m))
+        cap <<= 1;
+    if (!(table.slots = calloc(cap, sizeof(*table.slots)))) {
+        err = VAULT_ERR_NOMEM;
+        goto done;
+    }
+    table.mask = cap - 1;
+    tokens_intern(&table, &a, pre, pre + mid_n, 0);
+    tokens_intern(&table, &b, pre, pre + mid_m, INTERN_REF_NEW);
+    free(table.slots);
+    size_t ids = table.next_id;
+
+    size_t diags = mid_n + mid_m + 3;
+    ctx.old_ids     = a.id + pre;
+    ctx.new_ids     = b.id + pre;
+    ctx.old_changed = calloc(mid_n + 1, 1);
+    ctx.new_changed = calloc(mid_m + 1, 1);
+    ctx.fdiag       = malloc(diags * sizeof(long));
+    ctx.bdiag       = malloc(diags * sizeof(long));
+    if (!ctx.old_changed || !ctx.new_changed || !ctx.fdiag || !ctx.bdiag) {
+        err = VAULT_ERR_NOMEM;
+        goto done;
+    }
+
+    /* Tavan yaklaşık sqrt(N + M) ile ölçeklenir, VAULT_DIFF_COST_MIN altına inmez */
+    ctx.too_expensive = 1;
+    for (size_t d = diags; d != 0; d >>= 2)
+        ctx.too_expensive <<= 1;
+    if (ctx.too_expensive < VAULT_DIFF_COST_MIN)
+        ctx.too_expensive = VAULT_DIFF_COST_MIN;
+
+    /* Köşegen k = x - y, aralık [-(M + 1), N + 1] */
+    long *fbase = ctx.fdiag, *bbase = ctx.bdiag;
+    ctx.fdiag += mid_m + 1;
+    ctx.bdiag += mid_m + 1;
+    if (algorithm == VAULT_DIFF_MYERS) {
+        diff_compare(&ctx, 0, (long)mid_n, 0, (long)mid_m, 0);
+    } else {
+        ctx.old_count = calloc(ids, sizeof(uint32_t));
+        ctx.new_count = calloc(ids, sizeof(uint32_t));
+        ctx.old_pos   = malloc(ids * sizeof(uint32_t));
+        ctx.new_pos   = malloc(ids * sizeof(uint32_t));
+        ctx.chain     = malloc((mid_n + 1) * sizeof(uint32_t));
+        if (!ctx.old_count || !ctx.new_count || !ctx.old_pos || !ctx.new_pos || !ctx.chain)
+            err = VAULT_ERR_NOMEM;
+        else if (algorithm == VAULT_DIFF_PATIENCE)
+            err = diff_patience(&ctx, 0, (long)mid_n, 0, (long)mid_m);
+        else
+            err = diff_histogram(&ctx, 0, (long)mid_n, 0, (long)mid_m);
+    }
+    ctx.fdiag = fbase;
+    ctx.bdiag = bbase;
+
+    /* Hizalama: değişen bloklarda önce silinenler, sonra eklenenler */
+    size_t i = 0, j = 0;
+    while (err == VAULT_OK && (i < n || j < m)) {
+        int in_mid_old = i >= pre && i < pre + mid_n;
+        int in_mid_new = j >= pre && j < pre + mid_m;
+        if (i < n && in_mid_old && ctx.old_changed[i - pre]) {
+            err = result_push(result, '-', &a, i, (int)i + 1, -1);
+            i++;
+        } else if (j < m && in_mid_new && ctx.new_changed[j - pre]) {
+            err = result_push(result, '+', &b, j, -1, (int)j + 1);
+            j++;
+        } else {
+            err = result_push(result, ' ', &a, i, (int)i + 1, (int)j + 1);
+            i++;
+            j++;
+        }
+    }
+
+done:
+    free(ctx.old_count);
+    free(ctx.new_count);
+    free(ctx.old_pos);
+    free(ctx.new_pos);
+    free(ctx.chain);
+    free(ctx.old_changed);
+    free(ctx.new_changed);
+    free(ctx.fdiag);
+    free(ctx.bdiag);
+    tokens_free(&a);
+    tokens_free(&b);
+    if (err != VAULT_OK)
+        vault_diff_free(result);
+    return err;
 }
 
+/* ---- Yazdırma ----------------------------------------------------------- */
+
 void vault_diff_print(const DiffResult *result,
                       const char *old_path, const char *new_path){
-    (void) result;
-    (void) old_path;
-    (void) new_path;
+    const DiffLine *lines = result->lines;
+    size_t count = result->count;
+    int old_line = 0, new_line = 0;     /* Hunk'tan önceki son satır numaraları */
+    int header = 0;
+
+    size_t i = 0;
+    while (i < count) {
+        /* Sonraki değişikliği bul */
+        size_t first = i;
+        while (first < count && lines[first].op == ' ')
+            first++;
+        if (first == count)
+            break;
+
+        /* Hunk: aralarında 2 * context'ten az ortak satır olan değişiklikler */
+        size_t start = first > VAULT_DIFF_CONTEXT ? first - VAULT_DIFF_CONTEXT : 0;
+        if (start < i)
+            start = i;
+        size_t end = first, last = first;
+        while (end < count) {
+            if (lines[end].op != ' ') {
+                last = end++;
+                continue;
+            }
+            if (end - last > 2 * VAULT_DIFF_CONTEXT)
+                break;
+            end++;
+        }
+        if (end > last + 1 + VAULT_DIFF_CONTEXT)
+            end = last + 1 + VAULT_DIFF_CONTEXT;
+
+        for (size_t k = i; k < start; k++) {
+            old_line++;
+            new_line++;
+        }
+
+        int old_count = 0, new_count = 0;
+        for (size_t k = start; k < end; k++) {
+            if (lines[k].op != '+')
+                old_count++;
+            if (lines[k].op != '-')
+                new_count++;
+        }
+
+        if (!header++) {
+            printf("--- a/%s\n", old_path);
+            printf("+++ b/%s\n", new_path);
+        }
+        printf("@@ -%d,%d +%d,%d @@\n",
+               old_count ? old_line + 1 : old_line, old_count,
+               new_count ? new_line + 1 : new_line, new_count);
+        for (size_t k = start; k < end; k++)
+            printf("%c%.*s\n", lines[k].op, (int)lines[k].len, lines[k].text);
+
+        old_line += old_count;
+        new_line += new_count;
+        i = end;
+    }
 }
 
 void vault_diff_free(DiffResult *result){
-    (void) result;
+    free(result->lines);
+    memset(result, 0, sizeof(*result));
 }
@@ -0,0 +1,700 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "../include/vault_fsmonitor.h"
+#include "../include/vault_config.h"
+#include "../include/vault_index.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <dirent.h>
+#include <sys/inotify.h>
+#endif
+
+#define REQUEST_MAX      (16 + VAULT_FSMONITOR_TOKEN_MAX)
+#define COOKIE_PREFIX    "fsmonitor-cookie-"
+#define START_WAIT_MS    10000
+
+/* ---- Ortak -------------------------------------------------------------- */
+
+static void socket_timeouts(int fd){
+    struct timeval tv = { VAULT_FSMONITOR_TIMEOUT_MS / 1000,
+                          (VAULT_FSMONITOR_TIMEOUT_MS % 1000) * 1000 };
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+}
+
+static void socket_address(struct sockaddr_un *addr){
+    memset(addr, 0, sizeof(*addr));
+    addr->sun_family = AF_UNIX;
+    snprintf(addr->sun_path, sizeof(addr->sun_path), "%s", VAULT_FSMONITOR_SOCKET);
+}
+
+/* Daemon'a bağlanır; yoksa -1 */
+static int socket_connect(void){
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+        return -1;
+    struct sockaddr_un addr;
+    socket_address(&addr);
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+    socket_timeouts(fd);
+    return fd;
+}
+
+static int send_all(int fd, const char *buf, size_t len){
+    while (len > 0) {
+        ssize_t n = send(fd, buf, len, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return -1;
+        buf += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+/* İsteği gönderir, cevabı karşı taraf kapatana kadar okur (sonuna NUL) */
+static VaultError fsmonitor_request(const char *request, char **out, size_t *out_len){
+    int fd = socket_connect();
+    if (fd < 0)
+        return VAULT_ERR_NOTFOUND;
+    if (send_all(fd, request, strlen(request)) != 0) {
+        close(fd);
+        return VAULT_ERR_IO;
+    }
+    shutdown(fd, SHUT_WR);
+
+    char *buf = NULL;
+    size_t len = 0, cap = 0;
+    VaultError err = VAULT_OK;
+    for (;;) {
+        if (len + 1 >= cap) {
+            size_t grown_cap = cap ? cap * 2 : 4096;
+            char *grown = realloc(buf, grown_cap);
+            if (!grown) {
+                err = VAULT_ERR_NOMEM;
+                break;
+            }
+            buf = grown;
+            cap = grown_cap;
+        }
+        ssize_t n = recv(fd, buf + len, cap - len - 1, 0);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n < 0) {
+            err = VAULT_ERR_IO;     /* zaman aşımı dahil */
+            break;
+        }
+        if (n == 0)
+            break;
+        len += (size_t)n;
+    }
+    close(fd);
+
+    if (err != VAULT_OK) {
+        free(buf);
+        return err;
+    }
+    buf[len] = '\0';
+    *out = buf;
+    *out_len = len;
+    return VAULT_OK;
+}
+
+/* ---- İstemci ------------------------------------------------------------ */
+
+VaultError vault_fsmonitor_query(const char *since, VaultFsmonitorChanges *out){
+    memset(out, 0, sizeof(*out));
+    if (!vault_config_get_bool("core.fsmonitor", 1))
+        return VAULT_ERR_NOTFOUND;
+    if (strlen(since) >= VAULT_FSMONITOR_TOKEN_MAX)
+        since = "";
+
+    char request[REQUEST_MAX];
+    snprintf(request, sizeof(request), "query %s\n", since);
+    char *reply;
+    size_t len;
+    VaultError err = fsmonitor_request(request, &reply, &len);
+    if (err != VAULT_OK)
+        return err;
+
+    /* "ok <token>\n" yol\0yol\0...  ya da  "full <token>\n" */
+    char *nl = memchr(reply, '\n', len);
+    const char *token = NULL;
+    if (nl) {
+        *nl = '\0';
+        if (strncmp(reply, "ok ", 3) == 0) {
+            token = reply + 3;
+        } else if (strncmp(reply, "full ", 5) == 0) {
+            token = reply + 5;
+            out->full = 1;
+        }
+    }
+    char *p = nl ? nl + 1 : NULL, *end = reply + len;
+    if (!token || token[0] == '\0' || strlen(token) >= VAULT_FSMONITOR_TOKEN_MAX ||
+        (out->full && p != end) || (p < end && end[-1] != '\0')) {
+        free(reply);
+        return VAULT_ERR_IO;
+    }
+    memcpy(out->token, token, strlen(token) + 1);
+
+    for (char *q = p; q < end; q++)
+        if (*q == '\0')
+            out->count++;
+    out->paths = malloc((out->count ? out->count : 1) * sizeof(*out->paths));
+    if (!out->paths) {
+        free(reply);
+        return VAULT_ERR_NOMEM;
+    }
+    for (size_t i = 0; i < out->count; i++) {
+        out->paths[i] = p;
+        p += strlen(p) + 1;
+    }
+    out->buf = reply;
+    return VAULT_OK;
+}
+
+void vault_fsmonitor_changes_free(VaultFsmonitorChanges *changes){
+    free(changes->paths);
+    free(changes->buf);
+    memset(changes, 0, sizeof(*changes));
+}
+
+VaultError vault_fsmonitor_stop(void){
+    char *reply;
+    size_t len;
+    VaultError err = fsmonitor_request("stop\n", &reply, &len);
+    if (err != VAULT_OK)
+        return err;
+    err = strcmp(reply, "ok\n") == 0 ? VAULT_OK : VAULT_ERR_IO;
+    free(reply);
+    return err;
+}
+
+/* ---- Daemon ------------------------------------------------------------- */
+
+#ifdef __linux__
+
+#define WATCH_MASK  (IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB | \
+                     IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF |     \
+                     IN_ONLYDIR)
+
+/* Değişen bir yol ve onu gören ilk token'ın sırası */
+typedef struct {
+    char     *path;             /* NULL = boş slot */
+    uint64_t  seq;
+} DirtyPath;
+
+typedef struct {
+    int        ifd;             /* inotify */
+    int        lfd;             /* dinleyen soket */
+    char     **wds;             /* wd → dizin yolu ("" = kök), NULL = boş */
+    size_t     wd_cap;
+    int        root_wd;
+    int        vault_wd;        /* .vault: yalnızca cookie'ler için */
+    DirtyPath *dirty;           /* Açık adresli tablo */
+    size_t     dirty_count;
+    size_t     dirty_cap;       /* 2'nin kuvveti ya da 0 */
+    uint64_t   seq;             /* Son verilen token'ın sırası */
+    int        marked;          /* Son token'dan beri işaretlenen yol var */
+    uint64_t   epoch;           /* Taşmada artar: eski token'lar "full" alır */
+    char       instance[32];    /* "<pid>.<başlangıç>" */
+    int        broken;          /* İzleme eksik: her cevap "full" */
+    unsigned   cookie_next;
+    unsigned   cookie_seen;
+    int        stop;
+} Daemon;
+
+static volatile sig_atomic_t stop_signal;
+
+static void on_signal(int sig){
+    (void) sig;
+    stop_signal = 1;
+}
+
+static size_t path_hash(const char *path){
+    uint64_t h = 1469598103934665603ull;      /* FNV-1a */
+    for (; *path; path++)
+        h = (h ^ (uint8_t)*path) * 1099511628211ull;
+    return (size_t)h;
+}
+
+static DirtyPath *dirty_slot(DirtyPath *table, size_t cap, const char *path){
+    size_t i = path_hash(path) & (cap - 1);
+    while (table[i].path && strcmp(table[i].path, path) != 0)
+        i = (i + 1) & (cap - 1);
+    return &table[i];
+}
+
+/* Dönemi kapatır: biriken yollar atılır, eski token'lar artık "full" alır */
+static void dirty_overflow(Daemon *d){
+    for (size_t i = 0; i < d->dirty_cap; i++)
+        free(d->dirty[i].path);
+    free(d->dirty);
+    d->dirty = NULL;
+    d->dirty_count = d->dirty_cap = 0;
+    d->epoch++;
+    d->marked = 1;
+}
+
+static int dirty_grow(Daemon *d){
+    size_t cap = d->dirty_cap ? d->dirty_cap * 2 : 1024;
+    DirtyPath *table = calloc(cap, sizeof(*table));
+    if (!table)
+        return -1;
+    for (size_t i = 0; i < d->dirty_cap; i++)
+        if (d->dirty[i].path)
+            *dirty_slot(table, cap, d->dirty[i].path) = d->dirty[i];
+    free(d->dirty);
+    d->dirty = table;
+    d->dirty_cap = cap;
+    return 0;
+}
+
+static void dirty_mark(Daemon *d, const char *path){
+    d->marked = 1;
+    if ((d->dirty_count + 1) * 2 > d->dirty_cap) {
+        if (d->dirty_count >= VAULT_FSMONITOR_MAX_PATHS || dirty_grow(d) != 0) {
+            dirty_overflow(d);
+            return;
+        }
+    }
+    DirtyPath *slot = dirty_slot(d->dirty, d->dirty_cap, path);
+    if (!slot->path) {
+        if (!(slot->path = strdup(path))) {
+            dirty_overflow(d);
+            return;
+        }
+        d->dirty_count++;
+    }
+    slot->seq = d->seq + 1;
+}
+
+/* ---- İzlemeler ---------------------------------------------------------- */
+
+static void watch_dir(Daemon *d, const char *rel){
+    int wd = inotify_add_watch(d->ifd, rel[0] ? rel : ".", WATCH_MASK);
+    if (wd < 0) {
+        /* Dizin bu arada silindiyse olayı zaten gelecek; diğer hatalarda
+         * (ör. max_user_watches) bu dizindeki değişiklikler görünmez */
+        if (errno != ENOENT && errno != ENOTDIR)
+            d->broken = 1;
+        return;
+    }
+    if ((size_t)wd >= d->wd_cap) {
+        size_t cap = d->wd_cap ? d->wd_cap : 256;
+        while (cap <= (size_t)wd)
+            cap *= 2;
+        char **grown = realloc(d->wds, cap * sizeof(*grown));
+        if (!grown) {
+            d->broken = 1;
+            return;
+        }
+        memset(grown + d->wd_cap, 0, (cap - d->wd_cap) * sizeof(*grown));
+        d->wds = grown;
+        d->wd_cap = cap;
+    }
+    /* Aynı dizin yeniden eklendiyse (taşındı) aynı wd döner: yol güncellenir */
+    free(d->wds[wd]);
+    if (!(d->wds[wd] = strdup(rel)))
+        d->broken = 1;
+    if (rel[0] == '\0')
+        d->root_wd = wd;
+}
+
+/* Dizini ve tüm alt dizinlerini izlemeye alır; path VAULT_MAX_PATH'lik tampon */
+static void watch_tree(Daemon *d, char *path, size_t len){
+    watch_dir(d, path);
+
+    DIR *dir = opendir(len ? path : ".");
+    if (!dir)
+        return;
+    struct dirent *de;
+    while ((de = readdir(dir)) != NULL) {
+        size_t name_len = strlen(de->d_name);
+        if (strcmp(de->d_name, ".") == 0 || strcmp(de->d_name, "..") == 0 ||
+            (len == 0 && strcmp(de->d_name, VAULT_DIR) == 0) ||
+            len + name_len + 2 > VAULT_MAX_PATH)
+            continue;   /* VAULT_MAX_PATH'e sığmayan yollar index'e de giremez */
+
+        if (len)
+            path[len] = '/';
+        memcpy(path + len + (len ? 1 : 0), de->d_name, name_len + 1);
+        struct stat st;
+        if (lstat(path, &st) == 0 && S_ISDIR(st.st_mode))
+            watch_tree(d, path, len + (len ? 1 : 0) + name_len);
+        path[len] = '\0';
+    }
+    closedir(dir);
+}
+
+/* Silinen / taşınan dizinin ve altındakilerin izlemelerini bırakır */
+static void unwatch_tree(Daemon *d, const char *path){
+    size_t len = strlen(path);
+    for (size_t wd = 0; wd < d->wd_cap; wd++) {
+        const char *p = d->wds[wd];
+        if (p && strncmp(p, path, len) == 0 && (p[len] == '\0' || p[len] == '/')) {
+            inotify_rm_watch(d->ifd, (int)wd);
+            free(d->wds[wd]);
+            d->wds[wd] = NULL;
+        }
+    }
+}
+
+static void handle_event(Daemon *d, const struct inotify_event *ev){
+    if (ev->mask & IN_Q_OVERFLOW) {
+        dirty_overflow(d);
+        return;
+    }
+    if (ev->wd == d->vault_wd) {
+        if (ev->mask & IN_IGNORED)
+            d->stop = 1;    /* repo silindi */
+        else if (ev->len && strncmp(ev->name, COOKIE_PREFIX, strlen(COOKIE_PREFIX)) == 0)
+            d->cookie_seen = (unsigned)strtoul(ev->name + strlen(COOKIE_PREFIX), NULL, 10);
+        return;
+    }
+    if (ev->wd < 0 || (size_t)ev->wd >= d->wd_cap || !d->wds[ev->wd])
+        return;
+
+    const char *dir = d->wds[ev->wd];
+    if (ev->mask & (IN_IGNORED | IN_DELETE_SELF | IN_MOVE_SELF)) {
+        /* Alt dizinler için üst dizinin olayı yeter; kök giderse izleme biter */
+        if (ev->wd == d->root_wd)
+            d->broken = 1;
+        if (ev->mask & IN_IGNORED) {
+            free(d->wds[ev->wd]);
+            d->wds[ev->wd] = NULL;
+        }
+        return;
+    }
+    if (ev->len == 0 || (dir[0] == '\0' && strcmp(ev->name, VAULT_DIR) == 0))
+        return;
+
+    /* Dizinler için sonda '/' eklenecek yer kalsın */
+    char path[VAULT_MAX_PATH];
+    int n = snprintf(path, sizeof(path) - 1, "%s%s%s", dir, dir[0] ? "/" : "", ev->name);
+    if (n < 0 || (size_t)n >= sizeof(path) - 1)
+        return;
+    dirty_mark(d, path);
+
+    if ((ev->mask & IN_ISDIR) &&
+        (ev->mask & (IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO))) {
+        if (ev->mask & (IN_DELETE | IN_MOVED_FROM))
+            unwatch_tree(d, path);
+        else
+            watch_tree(d, path, (size_t)n);
+        /* İçerik olay üretmeden değişti (ya da izlenmeden önce yazıldı) */
+        path[n] = '/';
+        path[n + 1] = '\0';
+        dirty_mark(d, path);
+    }
+}
+
+static void drain_events(Daemon *d){
+    _Alignas(struct inotify_event) char buf[64 * 1024];
+    for (;;) {
+        ssize_t n = read(d->ifd, buf, sizeof(buf));
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return;
+        for (char *p = buf; p < buf + n; ) {
+            const struct inotify_event *ev = (const struct inotify_event *)p;
+            handle_event(d, ev);
+            p += sizeof(*ev) + ev->len;
+        }
+    }
+}
+
+/*
+ * Sorgudan önce yapılmış değişikliklerin olayları henüz okunmamış olabilir:
+ * .vault'ta bir cookie dosyası yaratılır ve onun olayı görülene kadar kuyruk
+ * işlenir. Kuyruk sıralı olduğundan o noktaya kadarki her olay işlenmiştir.
+ */
+static int sync_cookie(Daemon *d){
+    unsigned id = ++d->cookie_next;
+    char name[64];
+    snprintf(name, sizeof(name), "%s/%s%u", VAULT_DIR, COOKIE_PREFIX, id);
+    int fd = open(name, O_WRONLY | O_CREAT | O_EXCL, 0600);
+    if (fd < 0)
+        return -1;
+    close(fd);
+
+    struct timespec start, now;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (;;) {
+        drain_events(d);
+        if (d->cookie_seen == id)
+            break;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        long elapsed = (now.tv_sec - start.tv_sec) * 1000 +
+                       (now.tv_nsec - start.tv_nsec) / 1000000;
+        if (elapsed >= VAULT_FSMONITOR_TIMEOUT_MS / 2)
+            break;
+        struct pollfd pfd = { d->ifd, POLLIN, 0 };
+        poll(&pfd, 1, (int)(VAULT_FSMONITOR_TIMEOUT_MS / 2 - elapsed));
+    }
+    unlink(name);
+    return d->cookie_seen == id ? 0 : -1;
+}
+
+/* ---- Sorgular ----------------------------------------------------------- */
+
+/* "<örnek>.<dönem>" */
+static void token_prefix(const Daemon *d, char *out, size_t size){
+    snprintf(out, size, "%s.%llu", d->instance, (unsigned long long)d->epoch);
+}
+
+/* Token bu örneğin bu dönemine ait ve geçerli bir sıra taşıyorsa 1 */
+static int token_parse(const Daemon *d, const char *token, uint64_t *seq){
+    char prefix[VAULT_FSMONITOR_TOKEN_MAX];
+    token_prefix(d, prefix, sizeof(prefix));
+    size_t len = strlen(prefix);
+    if (strncmp(token, prefix, len) != 0 || token[len] != ':' || token[len + 1] == '\0')
+        return 0;
+    char *end;
+    errno = 0;
+    unsigned long long v = strtoull(token + len + 1, &end, 10);
+    if (errno != 0 || *end != '\0' || v > d->seq)
+        return 0;
+    *seq = v;
+    return 1;
+}
+
+typedef struct {
+    char   *data;
+    size_t  len;
+    size_t  cap;
+    int     failed;
+} ReplyBuf;
+
+static void reply_append(ReplyBuf *b, const char *s, size_t len){
+    if (b->failed)
+        return;
+    if (b->len + len > b->cap) {
+        size_t cap = b->cap ? b->cap : 4096;
+        while (cap < b->len + len)
+            cap *= 2;
+        char *grown = realloc(b->data, cap);
+        if (!grown) {
+            b->failed = 1;
+            return;
+        }
+        b->data = grown;
+        b->cap = cap;
+    }
+    memcpy(b->data + b->len, s, len);
+    b->len += len;
+}
+
+static void answer_query(Daemon *d, int fd, const char *since){
+    uint64_t since_seq = 0;
+    int full = sync_cookie(d) != 0 || d->broken || !token_parse(d, since, &since_seq);
+
+    /* Yeni token yalnızca yeni bir değişiklik olduysa verilir: boşta duran
+     * bir repoda status index'i yeniden yazmak zorunda kalmaz */
+    if (d->marked) {
+        d->seq++;
+        d->marked = 0;
+    }
+    char prefix[VAULT_FSMONITOR_TOKEN_MAX], header[2 * VAULT_FSMONITOR_TOKEN_MAX];
+    token_prefix(d, prefix, sizeof(prefix));
+
+    ReplyBuf b = { NULL, 0, 0, 0 };
+    if (!full) {
+        int n = snprintf(header, sizeof(header), "ok %s:%llu\n", prefix,
+                         (unsigned long long)d->seq);
+        reply_append(&b, header, (size_t)n);
+        for (size_t i = 0; i < d->dirty_cap; i++)
+            if (d->dirty[i].path && d->dirty[i].seq > since_seq)
+                reply_append(&b, d->dirty[i].path, strlen(d->dirty[i].path) + 1);
+    }
+    if (full || b.failed) {
+        int n = snprintf(header, sizeof(header), "full %s:%llu\n", prefix,
+                         (unsigned long long)d->seq);
+        send_all(fd, header, (size_t)n);
+    } else {
+        send_all(fd, b.data, b.len);
+    }
+    free(b.data);
+}
+
+static void serve_client(Daemon *d, int fd){
+    socket_timeouts(fd);
+    char request[REQUEST_MAX];
+    size_t len = 0;
+    while (len < sizeof(request) - 1) {
+        ssize_t n = recv(fd, request + len, sizeof(request) - 1 - len, 0);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            break;
+        len += (size_t)n;
+        if (memchr(request, '\n', len))
+            break;
+    }
+    request[len] = '\0';
+    char *nl = strchr(request, '\n');
+    if (!nl)
+        return;
+    *nl = '\0';
+
+    if (strcmp(request, "stop") == 0) {
+        send_all(fd, "ok\n", 3);
+        d->stop = 1;
+    } else if (strncmp(request, "query ", 6) == 0) {
+        answer_query(d, fd, request + 6);
+    }
+}
+
+/* Soketi açar; başka bir daemon cevap veriyorsa -1 */
+static int socket_listen(void){
+    int probe = socket_connect();
+    if (probe >= 0) {
+        close(probe);
+        return -1;
+    }
+    unlink(VAULT_FSMONITOR_SOCKET);     /* önceki daemon'dan kalmış olabilir */
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+        return -1;
+    struct sockaddr_un addr;
+    socket_address(&addr);
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(fd, 16) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static void daemon_free(Daemon *d){
+    for (size_t i = 0; i < d->wd_cap; i++)
+        free(d->wds[i]);
+    free(d->wds);
+    for (size_t i = 0; i < d->dirty_cap; i++)
+        free(d->dirty[i].path);
+    free(d->dirty);
+    if (d->ifd >= 0)
+        close(d->ifd);
+    if (d->lfd >= 0)
+        close(d->lfd);
+}
+
+static VaultError daemon_main(void){
+    Daemon d;
+    memset(&d, 0, sizeof(d));
+    d.lfd = d.root_wd = d.vault_wd = -1;
+    snprintf(d.instance, sizeof(d.instance), "%ld.%ld", (long)getpid(), (long)time(NULL));
+
+    if ((d.ifd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC)) < 0)
+        return VAULT_ERR_IO;
+    d.vault_wd = inotify_add_watch(d.ifd, VAULT_DIR, IN_CREATE | IN_ONLYDIR);
+
+    /* İzlemeler kurulmadan soket açılmaz: ilk cevap da eksiksiz olur */
+    char path[VAULT_MAX_PATH] = "";
+    if (d.vault_wd >= 0)
+        watch_tree(&d, path, 0);
+    if (d.vault_wd < 0 || d.root_wd < 0 || (d.lfd = socket_listen()) < 0) {
+        daemon_free(&d);
+        return VAULT_ERR_IO;
+    }
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = on_signal;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    struct pollfd fds[2] = { { d.ifd, POLLIN, 0 }, { d.lfd, POLLIN, 0 } };
+    while (!d.stop && !stop_signal) {
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+        if (fds[0].revents)
+            drain_events(&d);
+        if (fds[1].revents & POLLIN) {
+            int fd = accept(d.lfd, NULL, NULL);
+            if (fd >= 0) {
+                serve_client(&d, fd);
+                close(fd);
+            }
+        }
+    }
+
+    unlink(VAULT_FSMONITOR_SOCKET);
+    daemon_free(&d);
+    return VAULT_OK;
+}
+
+/* Arka plandaki daemon soketi açana (ya da ölene) kadar bekler */
+static VaultError wait_ready(pid_t pid){
+    struct timespec step = { 0, 50 * 1000000L };
+    for (int waited = 0; waited < START_WAIT_MS; waited += 50) {
+        int fd = socket_connect();
+        if (fd >= 0) {
+            close(fd);
+            return VAULT_OK;
+        }
+        if (waitpid(pid, NULL, WNOHANG) == pid)
+            return VAULT_ERR_IO;
+        nanosleep(&step, NULL);
+    }
+    return VAULT_ERR_IO;
+}
+
+#endif /* __linux__ */
+
+VaultError vault_fsmonitor_run(int detach){
+#ifdef __linux__
+    int probe = socket_connect();
+    if (probe >= 0) {
+        close(probe);
+        fprintf(stderr, "vault: fsmonitor is already running\n");
+        return VAULT_ERR_IO;
+    }
+    if (!detach)
+        return daemon_main();
+
+    fflush(NULL);
+    pid_t pid = fork();
+    if (pid < 0)
+        return VAULT_ERR_IO;
+    if (pid > 0)
+        return wait_ready(pid);
+
+    setsid();
+    int null = open("/dev/null", O_RDWR);
+    if (null >= 0) {
+        dup2(null, STDIN_FILENO);
+        dup2(null, STDOUT_FILENO);
+        dup2(null, STDERR_FILENO);
+        if (null > STDERR_FILENO)
+            close(null);
+    }
+    _exit(daemon_main() == VAULT_OK ? 0 : 1);
+#else
+    (void) detach;
+    fprintf(stderr, "vault: fsmonitor is only supported on Linux\n");
+    return VAULT_ERR_IO;
+#endif
+}
@@ -0,0 +1,556 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "../include/vault_graph.h"
+#include "../include/vault_fsync.h"
+#include "../include/vault_sha256.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define GRAPH_MAGIC        "VGPH"
+#define GRAPH_HEADER_SIZE  12
+#define GRAPH_FANOUT_SIZE  (256 * 4)
+#define GRAPH_DATA_SIZE    (VAULT_HASH_RAW_SIZE + 4 + 4 + 8)   /* tree + parent + gen + zaman */
+#define TIP_MAGIC          "VGTP"
+#define TIP_HEADER_SIZE    (8 + VAULT_HASH_RAW_SIZE)            /* magic + versiyon + taban checksum'ı */
+#define TIP_RECORD_SIZE    (VAULT_HASH_RAW_SIZE + GRAPH_DATA_SIZE)
+
+/* ---- Big-endian yardımcılar --------------------------------------------- */
+
+static uint32_t get_be32(const uint8_t *p){
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+           ((uint32_t)p[2] << 8)  |  (uint32_t)p[3];
+}
+
+static uint64_t get_be64(const uint8_t *p){
+    return ((uint64_t)get_be32(p) << 32) | get_be32(p + 4);
+}
+
+static void put_be32(uint8_t *p, uint32_t v){
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+static void put_be64(uint8_t *p, uint64_t v){
+    put_be32(p, (uint32_t)(v >> 32));
+    put_be32(p + 4, (uint32_t)v);
+}
+
+/* ---- Okuma -------------------------------------------------------------- */
+
+static VaultError map_file(const char *path, const uint8_t **out_map, size_t *out_size){
+    *out_map = NULL;
+    *out_size = 0;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return (errno == ENOENT) ? VAULT_OK : VAULT_ERR_IO;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return VAULT_ERR_IO;
+    }
+    if (st.st_size == 0) {
+        close(fd);
+        return VAULT_OK;
+    }
+
+    size_t size = (size_t)st.st_size;
+    void *map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return VAULT_ERR_IO;
+    *out_map = map;
+    *out_size = size;
+    return VAULT_OK;
+}
+
+/* Tabanın sondaki checksum'ı; taban yoksa sıfırlar (uç başlığındaki bağ) */
+static void base_checksum(const VaultCommitGraph *graph, uint8_t out[VAULT_HASH_RAW_SIZE]){
+    if (graph->map)
+        memcpy(out, graph->map + graph->map_size - VAULT_HASH_RAW_SIZE, VAULT_HASH_RAW_SIZE);
+    else
+        memset(out, 0, VAULT_HASH_RAW_SIZE);
+}
+
+static int tip_ptr_cmp(const void *a, const void *b){
+    return memcmp(*(const uint8_t * const *)a, *(const uint8_t * const *)b,
+                  VAULT_HASH_RAW_SIZE);
+}
+
+/*
+ * Uç katmanı yükler. Tabanla eşleşmiyorsa, bozuksa ya da sıralama için
+ * bellek yoksa grafik yalnızca tabandan oluşur.
+ */
+static void tip_open(VaultCommitGraph *graph){
+    const uint8_t *m;
+    size_t size;
+    if (map_file(VAULT_GRAPH_TIP_FILE, &m, &size) != VAULT_OK || !m)
+        return;
+
+    uint8_t bound[VAULT_HASH_RAW_SIZE];
+    base_checksum(graph, bound);
+    uint64_t n = size < TIP_HEADER_SIZE ? 0 : (size - TIP_HEADER_SIZE) / TIP_RECORD_SIZE;
+    if (size < TIP_HEADER_SIZE || memcmp(m, TIP_MAGIC, 4) != 0 ||
+        get_be32(m + 4) != VAULT_GRAPH_VERSION ||
+        memcmp(m + 8, bound, VAULT_HASH_RAW_SIZE) != 0 ||
+        (uint64_t)graph->base_count + n >= VAULT_GRAPH_NO_PARENT) {
+        munmap((void *)m, size);
+        return;
+    }
+
+    const uint8_t **sorted = malloc((n ? (size_t)n : 1) * sizeof(*sorted));
+    if (!sorted) {
+        munmap((void *)m, size);
+        return;
+    }
+    for (size_t i = 0; i < n; i++)
+        sorted[i] = m + TIP_HEADER_SIZE + i * TIP_RECORD_SIZE;
+    qsort(sorted, (size_t)n, sizeof(*sorted), tip_ptr_cmp);
+
+    graph->tip_map      = m;
+    graph->tip_map_size = size;
+    graph->tip          = m + TIP_HEADER_SIZE;
+    graph->tip_sorted   = sorted;
+    graph->count        = graph->base_count + (uint32_t)n;
+}
+
+VaultError vault_graph_open(VaultCommitGraph *graph){
+    memset(graph, 0, sizeof(*graph));
+
+    const uint8_t *m;
+    size_t size;
+    VaultError err = map_file(VAULT_GRAPH_FILE, &m, &size);
+    if (err != VAULT_OK)
+        return err;
+    if (m) {
+        graph->map = m;
+        graph->map_size = size;
+        if (size < GRAPH_HEADER_SIZE + GRAPH_FANOUT_SIZE + VAULT_HASH_RAW_SIZE ||
+            memcmp(m, GRAPH_MAGIC, 4) != 0 ||
+            get_be32(m + 4) != VAULT_GRAPH_VERSION)
+            goto corrupt;
+
+        graph->base_count = get_be32(m + 8);
+        graph->fanout = m + GRAPH_HEADER_SIZE;
+        graph->oids   = graph->fanout + GRAPH_FANOUT_SIZE;
+        graph->data   = graph->oids + (size_t)graph->base_count * VAULT_HASH_RAW_SIZE;
+
+        uint64_t expected = GRAPH_HEADER_SIZE + GRAPH_FANOUT_SIZE
+                          + (uint64_t)graph->base_count * (VAULT_HASH_RAW_SIZE + GRAPH_DATA_SIZE)
+                          + VAULT_HASH_RAW_SIZE;
+        if (expected != size || get_be32(graph->fanout + 255 * 4) != graph->base_count)
+            goto corrupt;
+    }
+    graph->count = graph->base_count;
+    tip_open(graph);
+    return VAULT_OK;
+
+corrupt:
+    vault_graph_close(graph);
+    return VAULT_ERR_CORRUPT;
+}
+
+int vault_graph_find(const VaultCommitGraph *graph, const VaultOid *oid,
+                     uint32_t *out_pos){
+    const uint8_t *raw = oid->id;
+    if (graph->base_count > 0) {
+        uint32_t lo = raw[0] ? get_be32(graph->fanout + (raw[0] - 1) * 4) : 0;
+        uint32_t hi = get_be32(graph->fanout + raw[0] * 4);
+        if (hi > graph->base_count)
+            hi = lo;
+
+        while (lo < hi) {
+            uint32_t mid = lo + (hi - lo) / 2;
+            int cmp = memcmp(graph->oids + (size_t)mid * VAULT_HASH_RAW_SIZE, raw,
+                             VAULT_HASH_RAW_SIZE);
+            if (cmp == 0) {
+                *out_pos = mid;
+                return 1;
+            }
+            if (cmp < 0)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+    }
+
+    uint32_t tip_count = graph->count - graph->base_count;
+    if (tip_count == 0)
+        return 0;
+    const uint8_t **hit = bsearch(&raw, graph->tip_sorted, tip_count,
+                                  sizeof(*graph->tip_sorted), tip_ptr_cmp);
+    if (!hit)
+        return 0;
+    *out_pos = graph->base_count + (uint32_t)((size_t)(*hit - graph->tip) / TIP_RECORD_SIZE);
+    return 1;
+}
+
+VaultError vault_graph_get(const VaultCommitGraph *graph, uint32_t pos,
+                           VaultGraphCommit *out_commit){
+    if (pos >= graph->count)
+        return VAULT_ERR_CORRUPT;
+
+    const uint8_t *oid, *d;
+    uint32_t parent_limit;
+    if (pos < graph->base_count) {
+        oid = graph->oids + (size_t)pos * VAULT_HASH_RAW_SIZE;
+        d   = graph->data + (size_t)pos * GRAPH_DATA_SIZE;
+        parent_limit = graph->base_count;   /* taban uca bağlanamaz */
+    } else {
+        oid = graph->tip + (size_t)(pos - graph->base_count) * TIP_RECORD_SIZE;
+        d   = oid + VAULT_HASH_RAW_SIZE;
+        parent_limit = pos;                 /* parent'lar önce eklenir */
+    }
+    memcpy(out_commit->oid.id, oid, VAULT_HASH_RAW_SIZE);
+    memcpy(out_commit->tree.id, d, VAULT_HASH_RAW_SIZE);
+    out_commit->parent     = get_be32(d + VAULT_HASH_RAW_SIZE);
+    out_commit->generation = get_be32(d + VAULT_HASH_RAW_SIZE + 4);
+    out_commit->timestamp  = (long)(int64_t)get_be64(d + VAULT_HASH_RAW_SIZE + 8);
+
+    if (out_commit->parent != VAULT_GRAPH_NO_PARENT && out_commit->parent >= parent_limit)
+        return VAULT_ERR_CORRUPT;
+    return VAULT_OK;
+}
+
+void vault_graph_close(VaultCommitGraph *graph){
+    if (graph->map)
+        munmap((void *)graph->map, graph->map_size);
+    if (graph->tip_map)
+        munmap((void *)graph->tip_map, graph->tip_map_size);
+    free(graph->tip_sorted);
+    memset(graph, 0, sizeof(*graph));
+}
+
+/* ---- Yazma -------------------------------------------------------------- */
+
+static int graph_checksum_ok(const VaultCommitGraph *graph){
+    uint8_t digest[VAULT_SHA256_DIGEST_SIZE];
+    size_t body = graph->map_size - VAULT_HASH_RAW_SIZE;
+    vault_sha256(graph->map, body, digest);
+    return memcmp(digest, graph->map + body, VAULT_HASH_RAW_SIZE) == 0;
+}
+
+/* tree + parent + generation + zaman; taban ve uç kayıtlarında aynı */
+static void graph_data_put(uint8_t *p, const VaultGraphCommit *c){
+    memcpy(p, c->tree.id, VAULT_HASH_RAW_SIZE);
+    put_be32(p + VAULT_HASH_RAW_SIZE, c->parent);
+    put_be32(p + VAULT_HASH_RAW_SIZE + 4, c->generation);
+    put_be64(p + VAULT_HASH_RAW_SIZE + 8, (uint64_t)(int64_t)c->timestamp);
+}
+
+static VaultError new_commit_read(const VaultOid *oid, VaultCommit *out){
+    VaultObjectView view;
+    VaultError err = vault_object_view(oid, &view);
+    if (err != VAULT_OK)
+        return err;
+
+    if (view.type != VAULT_OBJ_COMMIT)
+        err = VAULT_ERR_CORRUPT;
+    else
+        err = vault_commit_deserialize(view.data, view.size, out);
+    vault_object_view_release(&view);
+    return err;
+}
+
+/*
+ * Grafikte olmayan commit'leri HEAD'den geriye doğru toplar ve eklenme
+ * sırasında (eskiden yeniye) döner: her birinin konumu graph->count + i,
+ * parent'ı bir öncekidir; en eskisinin parent'ı grafikte ya da yoktur.
+ */
+static VaultError graph_collect(const VaultCommitGraph *graph, const VaultOid *commit_oid,
+                                VaultGraphCommit **out, size_t *out_count){
+    VaultGraphCommit *fresh = NULL;
+    size_t count = 0, cap = 0;
+    VaultError err = VAULT_OK;
+    VaultOid cur = *commit_oid;
+    uint32_t pos;
+
+    *out = NULL;
+    *out_count = 0;
+    while (!vault_oid_is_null(&cur) && !vault_graph_find(graph, &cur, &pos)) {
+        if ((uint64_t)graph->count + count >= VAULT_GRAPH_NO_PARENT) {
+            err = VAULT_ERR_CORRUPT;
+            break;
+        }
+        if (count == cap) {
+            cap = cap ? cap * 2 : 16;
+            VaultGraphCommit *grown = realloc(fresh, cap * sizeof(*grown));
+            if (!grown) {
+                err = VAULT_ERR_NOMEM;
+                break;
+            }
+            fresh = grown;
+        }
+        VaultCommit commit;
+        if ((err = new_commit_read(&cur, &commit)) != VAULT_OK)
+            break;
+        fresh[count].oid       = cur;
+        fresh[count].tree      = commit.tree_hash;
+        fresh[count].timestamp = commit.timestamp;
+        count++;
+        cur = commit.parent_hash;
+    }
+    if (err != VAULT_OK || count == 0) {
+        free(fresh);
+        return err;
+    }
+
+    /* Eskiden yeniye çevir, parent konumlarını ve generation'ları doldur */
+    for (size_t i = 0, j = count - 1; i < j; i++, j--) {
+        VaultGraphCommit t = fresh[i];
+        fresh[i] = fresh[j];
+        fresh[j] = t;
+    }
+    uint32_t parent = VAULT_GRAPH_NO_PARENT, generation = 0;
+    if (!vault_oid_is_null(&cur)) {
+        VaultGraphCommit gc;
+        if ((err = vault_graph_get(graph, pos, &gc)) != VAULT_OK) {
+            free(fresh);
+            return err;
+        }
+        parent = pos;
+        generation = gc.generation;
+    }
+    for (size_t i = 0; i < count; i++) {
+        fresh[i].parent     = parent;
+        fresh[i].generation = ++generation;
+        parent = graph->count + (uint32_t)i;
+    }
+    *out = fresh;
+    *out_count = count;
+    return VAULT_OK;
+}
+
+static int write_all(int fd, const uint8_t *buf, size_t len){
+    while (len > 0) {
+        ssize_t n = write(fd, buf, len);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            return -1;
+        }
+        buf += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+/*
+ * Yeni kayıtları uç katmanın sonuna ekler. Geçerli bir uç yoksa (ilk kez
+ * ya da tabanla eşleşmeyen eski bir uç) başlıkla birlikte yeniden
+ * oluşturulur. Sonda yarım kalmış bir kayıt varsa önce kesilir.
+ */
+static VaultError tip_append(const VaultCommitGraph *graph,
+                             const VaultGraphCommit *fresh, size_t count){
+    size_t len = count * TIP_RECORD_SIZE;
+    uint8_t *buf = malloc(TIP_HEADER_SIZE + len);
+    if (!buf)
+        return VAULT_ERR_NOMEM;
+    uint8_t *p = buf + TIP_HEADER_SIZE;
+    for (size_t i = 0; i < count; i++, p += TIP_RECORD_SIZE) {
+        memcpy(p, fresh[i].oid.id, VAULT_HASH_RAW_SIZE);
+        graph_data_put(p + VAULT_HASH_RAW_SIZE, &fresh[i]);
+    }
+
+    VaultError err = VAULT_OK;
+    if (graph->tip_map) {
+        off_t end = (off_t)TIP_HEADER_SIZE
+                  + (off_t)(graph->count - graph->base_count) * TIP_RECORD_SIZE;
+        int fd = open(VAULT_GRAPH_TIP_FILE, O_WRONLY);
+        if (fd < 0 || ftruncate(fd, end) != 0 || lseek(fd, end, SEEK_SET) != end ||
+            write_all(fd, buf + TIP_HEADER_SIZE, len) != 0 ||
+            vault_fsync_file(fd) != VAULT_OK)
+            err = VAULT_ERR_IO;
+        if (fd >= 0 && close(fd) != 0)
+            err = VAULT_ERR_IO;
+        free(buf);
+        return err;
+    }
+
+    memcpy(buf, TIP_MAGIC, 4);
+    put_be32(buf + 4, VAULT_GRAPH_VERSION);
+    base_checksum(graph, buf + 8);
+
+    char tmp[] = ".vault/commit-graph-tip_XXXXXX";
+    int fd = mkstemp(tmp);
+    if (fd < 0) {
+        free(buf);
+        return VAULT_ERR_IO;
+    }
+    fchmod(fd, 0644);
+    if (write_all(fd, buf, TIP_HEADER_SIZE + len) != 0 || vault_fsync_file(fd) != VAULT_OK)
+        err = VAULT_ERR_IO;
+    if (close(fd) != 0)
+        err = VAULT_ERR_IO;
+    free(buf);
+    if (err == VAULT_OK && rename(tmp, VAULT_GRAPH_TIP_FILE) != 0)
+        err = VAULT_ERR_IO;
+    if (err != VAULT_OK) {
+        unlink(tmp);
+        return err;
+    }
+    return vault_fsync_dir(VAULT_DIR);
+}
+
+/* Yazılan her byte checksum'a da girer */
+static int graph_emit(FILE *fp, VaultSha256 *md, const void *buf, size_t len){
+    vault_sha256_update(md, buf, len);
+    return fwrite(buf, 1, len, fp) == len ? 0 : -1;
+}
+
+static VaultError graph_write(const VaultGraphCommit *all, uint32_t count){
+    char tmp[] = ".vault/commit-graph_XXXXXX";
+    int fd = mkstemp(tmp);
+    if (fd < 0)
+        return VAULT_ERR_IO;
+    fchmod(fd, 0644);
+
+    FILE *fp = fdopen(fd, "wb");
+    if (!fp) {
+        close(fd);
+        unlink(tmp);
+        return VAULT_ERR_IO;
+    }
+    VaultSha256 md;
+    vault_sha256_init(&md);
+
+    uint8_t buf[GRAPH_FANOUT_SIZE];
+    memcpy(buf, GRAPH_MAGIC, 4);
+    put_be32(buf + 4, VAULT_GRAPH_VERSION);
+    put_be32(buf + 8, count);
+    int ok = graph_emit(fp, &md, buf, GRAPH_HEADER_SIZE) == 0;
+
+    uint32_t j = 0;
+    for (int b = 0; b < 256; b++) {
+        while (j < count && all[j].oid.id[0] == b)
+            j++;
+        put_be32(buf + b * 4, j);
+    }
+    ok = ok && graph_emit(fp, &md, buf, GRAPH_FANOUT_SIZE) == 0;
+
+    for (uint32_t i = 0; ok && i < count; i++)
+        ok = graph_emit(fp, &md, all[i].oid.id, VAULT_HASH_RAW_SIZE) == 0;
+    for (uint32_t i = 0; ok && i < count; i++) {
+        graph_data_put(buf, &all[i]);
+        ok = graph_emit(fp, &md, buf, GRAPH_DATA_SIZE) == 0;
+    }
+
+    uint8_t digest[VAULT_SHA256_DIGEST_SIZE];
+    vault_sha256_final(&md, digest);
+    ok = ok && fwrite(digest, 1, VAULT_HASH_RAW_SIZE, fp) == VAULT_HASH_RAW_SIZE;
+    ok = ok && fflush(fp) == 0 && vault_fsync_file(fileno(fp)) == VAULT_OK;
+
+    if (fclose(fp) != 0 || !ok || rename(tmp, VAULT_GRAPH_FILE) != 0) {
+        unlink(tmp);
+        return VAULT_ERR_IO;
+    }
+    return vault_fsync_dir(VAULT_DIR);
+}
+
+/* Birleştirme sırasında: girişin birleştirmeden önceki konumu */
+typedef struct {
+    VaultGraphCommit commit;
+    uint32_t         old;
+} MergeEntry;
+
+static int merge_entry_cmp(const void *a, const void *b){
+    return vault_oid_cmp(&((const MergeEntry *)a)->commit.oid,
+                         &((const MergeEntry *)b)->commit.oid);
+}
+
+/*
+ * Taban + uç + yeni commit'leri oid sırasında tek bir tabana yazar ve ucu
+ * siler. Uç tabanın eski checksum'ına bağlı olduğundan, silinemeden kesilse
+ * bile yeni tabanla birlikte okunmaz.
+ */
+static VaultError graph_merge(VaultCommitGraph *graph,
+                              const VaultGraphCommit *fresh, size_t fresh_count){
+    uint32_t total = graph->count + (uint32_t)fresh_count;
+    MergeEntry *entries = malloc(((size_t)total ? total : 1) * sizeof(*entries));
+    uint32_t *remap = malloc(((size_t)total ? total : 1) * sizeof(*remap));
+    VaultGraphCommit *all = malloc(((size_t)total ? total : 1) * sizeof(*all));
+    VaultError err = VAULT_OK;
+    if (!entries || !remap || !all) {
+        err = VAULT_ERR_NOMEM;
+        goto done;
+    }
+
+    for (uint32_t i = 0; i < total; i++) {
+        if (i < graph->count)
+            err = vault_graph_get(graph, i, &entries[i].commit);
+        else
+            entries[i].commit = fresh[i - graph->count];
+        if (err != VAULT_OK)
+            goto done;
+        entries[i].old = i;
+    }
+    qsort(entries, total, sizeof(*entries), merge_entry_cmp);
+    for (uint32_t i = 0; i < total; i++)
+        remap[entries[i].old] = i;
+    for (uint32_t i = 0; i < total; i++) {
+        all[i] = entries[i].commit;
+        if (all[i].parent != VAULT_GRAPH_NO_PARENT)
+            all[i].parent = remap[all[i].parent];
+    }
+
+    /* Eski mmap'ler rename'den önce kapatılır */
+    vault_graph_close(graph);
+    err = graph_write(all, total);
+    if (err == VAULT_OK && unlink(VAULT_GRAPH_TIP_FILE) != 0 && errno != ENOENT)
+        err = VAULT_ERR_IO;
+
+done:
+    free(all);
+    free(remap);
+    free(entries);
+    return err;
+}
+
+VaultError vault_graph_add(const VaultOid *commit_oid){
+    VaultCommitGraph graph;
+    int rebuild = vault_graph_open(&graph) != VAULT_OK;   /* bozuk: baştan oluştur */
+
+    VaultGraphCommit *fresh;
+    size_t fresh_count;
+    VaultError err = graph_collect(&graph, commit_oid, &fresh, &fresh_count);
+    if (err != VAULT_OK || fresh_count == 0) {
+        vault_graph_close(&graph);
+        return err;
+    }
+
+    /* Uç küçükse yalnızca yeni kayıtlar eklenir */
+    uint64_t tip_count = (uint64_t)graph.count - graph.base_count + fresh_count;
+    if (!rebuild && (tip_count < VAULT_GRAPH_TIP_MIN ||
+                     tip_count * VAULT_GRAPH_TIP_RATIO < graph.base_count)) {
+        err = tip_append(&graph, fresh, fresh_count);
+        free(fresh);
+        vault_graph_close(&graph);
+        return err;
+    }
+
+    /* Birleştirme tabanı baştan yazar: checksum'ı tutmuyorsa tüm geçmiş
+     * nesnelerden yeniden toplanır */
+    if (graph.map && !graph_checksum_ok(&graph)) {
+        free(fresh);
+        vault_graph_close(&graph);
+        err = graph_collect(&graph, commit_oid, &fresh, &fresh_count);
+        if (err != VAULT_OK || fresh_count == 0) {
+            vault_graph_close(&graph);
+            return err;
+        }
+    }
+    err = graph_merge(&graph, fresh, fresh_count);
+    free(fresh);
+    vault_graph_close(&graph);
+    return err;
+}
@@ -0,0 +1,338 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "../include/vault_ignore.h"
+#include "../include/vault_index.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Kuralın türü (derleme sırasında belirlenir):
+ *   LITERAL → joker yok: strcmp
+ *   SUFFIX  → "*<sabit>" ve çapasız: ad bu sabitle bitiyor mu
+ *   GLOB    → genel durum; prefix_len kadar sabit önek önce karşılaştırılır
+ */
+typedef enum {
+    RULE_LITERAL,
+    RULE_SUFFIX,
+    RULE_GLOB,
+} RuleKind;
+
+typedef struct {
+    char    *pattern;       /* '!', baştaki ve sondaki '/' atılmış */
+    size_t   len;
+    size_t   prefix_len;    /* GLOB: ilk jokerden önceki sabit kısım */
+    RuleKind kind;
+    int      negated;       /* "!kalıp" */
+    int      dir_only;      /* "kalıp/" */
+    int      anchored;      /* '/' içeriyor: dosyanın dizinine göre tüm yol */
+} IgnoreRule;
+
+struct VaultIgnore {
+    char       *base;       /* "src/" ya da "" */
+    size_t      base_len;
+    IgnoreRule *rules;
+    size_t      count;
+};
+
+/* ---- Glob --------------------------------------------------------------- */
+
+/* "[...]" sınıfı; *p '[' üzerinde. Eşleşirse 1, değilse 0, bozuksa -1.
+ * Başarıda *p sınıfı kapatan ']' üzerinde kalır. */
+static int class_match(const char **p, char c){
+    const char *q = *p + 1;
+    int negate = (*q == '!' || *q == '^');
+    if (negate)
+        q++;
+    int matched = 0;
+    const char *first = q;
+    for (; *q && (*q != ']' || q == first); q++) {
+        char lo = *q;
+        if (lo == '\\' && q[1])
+            lo = *++q;
+        if (q[1] == '-' && q[2] && q[2] != ']') {
+            char hi = q[2];
+            q += 2;
+            if (hi == '\\' && q[1])
+                hi = *++q;
+            if (c >= lo && c <= hi)
+                matched = 1;
+        } else if (c == lo) {
+            matched = 1;
+        }
+    }
+    if (*q != ']')
+        return -1;
+    *p = q;
+    return matched != negate;
+}
+
+/*
+ * '*', '?' ve sınıflar '/' ile eşleşmez. "**" yalnızca '/' ile sınırlıysa
+ * özeldir: ardından '/' geliyorsa sıfır ya da daha çok dizinle, kalıbın
+ * sonundaysa geri kalan her şeyle eşleşir.
+ */
+static int glob_match(const char *start, const char *p, const char *text){
+    for (; *p; p++, text++) {
+        switch (*p) {
+        case '\\':
+            if (p[1])
+                p++;
+            if (*text != *p)
+                return 0;
+            break;
+        case '?':
+            if (!*text || *text == '/')
+                return 0;
+            break;
+        case '[': {
+            if (!*text || *text == '/')
+                return 0;
+            const char *q = p;
+            int r = class_match(&q, *text);
+            if (r < 0) {
+                if (*text != '[')   /* bozuk sınıf: düz '[' */
+                    return 0;
+                break;
+            }
+            if (!r)
+                return 0;
+            p = q;
+            break;
+        }
+        case '*': {
+            const char *q = p;
+            while (*q == '*')
+                q++;
+            if (q - p >= 2 && (p == start || p[-1] == '/') && (*q == '\0' || *q == '/')) {
+                if (*q == '\0')
+                    return 1;
+                /* Kalan kalıp buradan ya da sonraki her '/'dan sonra eşleşebilir */
+                for (const char *t = text;; t++) {
+                    if (glob_match(start, q + 1, t))
+                        return 1;
+                    t = strchr(t, '/');
+                    if (!t)
+                        return 0;
+                }
+            }
+            if (*q == '\0')
+                return strchr(text, '/') == NULL;
+            for (const char *t = text;; t++) {
+                if (glob_match(start, q, t))
+                    return 1;
+                if (*t == '\0' || *t == '/')
+                    return 0;
+            }
+        }
+        default:
+            if (*text != *p)
+                return 0;
+        }
+    }
+    return *text == '\0';
+}
+
+/* ---- Derleme ------------------------------------------------------------ */
+
+static int has_wildcard(const char *s, size_t len){
+    for (size_t i = 0; i < len; i++)
+        if (s[i] == '*' || s[i] == '?' || s[i] == '[' || s[i] == '\\')
+            return 1;
+    return 0;
+}
+
+/* Tek bir satırı derler; satır kural değilse 0, kural eklendiyse 1 */
+static int rule_compile(char *line, size_t len, IgnoreRule *r){
+    if (len > 0 && line[len - 1] == '\r')
+        len--;
+    /* Sondaki kaçışsız boşluklar atılır */
+    while (len > 0 && line[len - 1] == ' ' && !(len > 1 && line[len - 2] == '\\'))
+        len--;
+    if (len == 0 || line[0] == '#')
+        return 0;
+
+    memset(r, 0, sizeof(*r));
+    if (line[0] == '!') {
+        r->negated = 1;
+        line++;
+        len--;
+    } else if (line[0] == '\\' && len > 1 && (line[1] == '!' || line[1] == '#')) {
+        line++;
+        len--;
+    }
+    if (len > 0 && line[len - 1] == '/') {
+        r->dir_only = 1;
+        len--;
+    }
+    if (len > 0 && line[0] == '/') {
+        r->anchored = 1;
+        line++;
+        len--;
+    }
+    if (len == 0)
+        return 0;
+    if (memchr(line, '/', len))
+        r->anchored = 1;
+
+    r->pattern = line;
+    r->len = len;
+    size_t i = 0;
+    while (i < len && line[i] != '*' && line[i] != '?' && line[i] != '[' && line[i] != '\\')
+        i++;
+    r->prefix_len = i;
+    if (i == len)
+        r->kind = RULE_LITERAL;
+    else if (!r->anchored && i == 0 && line[0] == '*' && len > 1 &&
+             !has_wildcard(line + 1, len - 1))
+        r->kind = RULE_SUFFIX;
+    else
+        r->kind = RULE_GLOB;
+    return 1;
+}
+
+VaultError vault_ignore_parse(const char *base, const char *text, size_t len,
+                              VaultIgnore **out){
+    *out = NULL;
+    VaultIgnore *ig = calloc(1, sizeof(*ig));
+    if (!ig || !(ig->base = strdup(base))) {
+        free(ig);
+        return VAULT_ERR_NOMEM;
+    }
+    ig->base_len = strlen(base);
+
+    size_t cap = 0;
+    for (size_t pos = 0; pos < len; ) {
+        const char *nl = memchr(text + pos, '\n', len - pos);
+        size_t line_len = nl ? (size_t)(nl - (text + pos)) : len - pos;
+        char *line = malloc(line_len + 1);
+        if (!line) {
+            vault_ignore_free(ig);
+            return VAULT_ERR_NOMEM;
+        }
+        memcpy(line, text + pos, line_len);
+        line[line_len] = '\0';
+        pos += line_len + 1;
+
+        IgnoreRule rule;
+        if (!rule_compile(line, line_len, &rule)) {
+            free(line);
+            continue;
+        }
+        /* Kalıp satırın içini gösteriyor: kendi kopyasına taşı */
+        memmove(line, rule.pattern, rule.len);
+        line[rule.len] = '\0';
+        rule.pattern = line;
+
+        if (ig->count == cap) {
+            cap = cap ? cap * 2 : 16;
+            IgnoreRule *grown = realloc(ig->rules, cap * sizeof(*grown));
+            if (!grown) {
+                free(line);
+                vault_ignore_free(ig);
+                return VAULT_ERR_NOMEM;
+            }
+            ig->rules = grown;
+        }
+        ig->rules[ig->count++] = rule;
+    }
+
+    if (ig->count == 0) {
+        vault_ignore_free(ig);
+        return VAULT_OK;
+    }
+    *out = ig;
+    return VAULT_OK;
+}
+
+VaultError vault_ignore_load(const char *base, VaultIgnore **out){
+    *out = NULL;
+    char path[VAULT_MAX_PATH];
+    if ((size_t)snprintf(path, sizeof(path), "%s%s", base, VAULT_IGNORE_FILE) >= sizeof(path))
+        return VAULT_OK;
+
+    FILE *fp = fopen(path, "rb");
+    if (!fp)
+        return (errno == ENOENT || errno == ENOTDIR) ? VAULT_OK : VAULT_ERR_IO;
+
+    char *text = NULL;
+    size_t len = 0, cap = 0;
+    VaultError err = VAULT_OK;
+    for (;;) {
+        if (len == cap) {
+            cap = cap ? cap * 2 : 4096;
+            char *grown = realloc(text, cap);
+            if (!grown) {
+                err = VAULT_ERR_NOMEM;
+                break;
+            }
+            text = grown;
+        }
+        size_t n = fread(text + len, 1, cap - len, fp);
+        len += n;
+        if (n == 0)
+            break;
+    }
+    if (err == VAULT_OK && ferror(fp))
+        err = VAULT_ERR_IO;
+    fclose(fp);
+
+    if (err == VAULT_OK)
+        err = vault_ignore_parse(base, text, len, out);
+    free(text);
+    return err;
+}
+
+void vault_ignore_free(VaultIgnore *ig){
+    if (!ig)
+        return;
+    for (size_t i = 0; i < ig->count; i++)
+        free(ig->rules[i].pattern);
+    free(ig->rules);
+    free(ig->base);
+    free(ig);
+}
+
+/* ---- Eşleme ------------------------------------------------------------- */
+
+static int rule_match(const IgnoreRule *r, const char *rel, const char *name,
+                      size_t name_len){
+    /* Çapasız kurallar yalnızca son bileşene bakar */
+    const char *subject = r->anchored ? rel : name;
+    switch (r->kind) {
+    case RULE_LITERAL:
+        return strcmp(subject, r->pattern) == 0;
+    case RULE_SUFFIX: {
+        size_t suffix = r->len - 1;
+        return name_len >= suffix &&
+               memcmp(name + name_len - suffix, r->pattern + 1, suffix) == 0;
+    }
+    case RULE_GLOB:
+        return strncmp(subject, r->pattern, r->prefix_len) == 0 &&
+               glob_match(r->pattern, r->pattern, subject);
+    }
+    return 0;
+}
+
+int vault_ignore_match(const VaultIgnoreStack *stack, const char *path, int is_dir){
+    const char *slash = strrchr(path, '/');
+    const char *name = slash ? slash + 1 : path;
+    size_t name_len = strlen(name);
+
+    for (; stack; stack = stack->parent) {
+        const VaultIgnore *ig = stack->rules;
+        if (!ig || strncmp(path, ig->base, ig->base_len) != 0)
+            continue;
+        const char *rel = path + ig->base_len;
+        for (size_t i = ig->count; i > 0; i--) {
+            const IgnoreRule *r = &ig->rules[i - 1];
+            if (r->dir_only && !is_dir)
+                continue;
+            if (rule_match(r, rel, name, name_len))
+                return !r->negated;
+        }
+    }
+    return 0;
+}
@@ -1,58 +1,1875 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include "../include/vault_index.h"
+#include "../include/vault_config.h"
+#include "../include/vault_fsync.h"
+#include "../include/vault_graph.h"
+#include "../include/vault_ignore.h"
+#include "../include/vault_sha256.h"
+#include "../include/vault_walk.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define INDEX_HEADER_SIZE  12
+#define INDEX_STAT_FIELDS  7     /* mtime, mtime_nsec, ctime, ctime_nsec, size, ino, dev */
+#define INDEX_PATH_LEN_OFF (VAULT_HASH_RAW_SIZE + INDEX_STAT_FIELDS * 8)
+#define INDEX_ENTRY_FIXED  (INDEX_PATH_LEN_OFF + 2)         /* hash + stat + yol uzunluğu */
+
+/* ---- Dahili yardımcılar ------------------------------------------------- */
+
+/* "./src/main.c" → "src/main.c" */
+static const char *normalize_path(const char *path){
+    while (path[0] == '.' && path[1] == '/')
+        path += 2;
+    return path;
+}
+
+static uint32_t get_be32(const uint8_t *p){
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+           ((uint32_t)p[2] << 8)  |  (uint32_t)p[3];
+}
+
+static uint64_t get_be64(const uint8_t *p){
+    return ((uint64_t)get_be32(p) << 32) | get_be32(p + 4);
+}
+
+static void put_be32(uint8_t *p, uint32_t v){
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+static void put_be64(uint8_t *p, uint64_t v){
+    put_be32(p, (uint32_t)(v >> 32));
+    put_be32(p + 4, (uint32_t)v);
+}
+
+/* Yol mmap'in içindeyse index'e ait değildir, free edilmez */
+static int path_is_mapped(const VaultIndex *idx, const char *path){
+    uintptr_t p = (uintptr_t)path, base = (uintptr_t)idx->map;
+    return idx->map && p >= base && p < base + idx->map_size;
+}
+
+static void entry_release(const VaultIndex *idx, IndexEntry *e){
+    if (!path_is_mapped(idx, e->filepath))
+        free((char *)e->filepath);
+    e->filepath = NULL;
+}
+
+static int entry_cmp(const void *a, const void *b){
+    return strcmp(((const IndexEntry *)a)->filepath, ((const IndexEntry *)b)->filepath);
+}
+
+/* Yolun sıralı dizideki yeri: bulunursa *found = 1 */
+static size_t index_lower_bound(const IndexEntry *entries, size_t count,
+                                const char *filepath, int *found){
+    size_t lo = 0, hi = count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        int cmp = strcmp(entries[mid].filepath, filepath);
+        if (cmp == 0) {
+            *found = 1;
+            return mid;
+        }
+        if (cmp < 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    *found = 0;
+    return lo;
+}
+
+static void entry_set_stat(IndexEntry *e, const struct stat *st){
+    e->mtime      = (long)st->st_mtim.tv_sec;
+    e->mtime_nsec = (long)st->st_mtim.tv_nsec;
+    e->ctime      = (long)st->st_ctim.tv_sec;
+    e->ctime_nsec = (long)st->st_ctim.tv_nsec;
+    e->size       = (uint64_t)st->st_size;
+    e->ino        = (uint64_t)st->st_ino;
+    e->dev        = (uint64_t)st->st_dev;
+    e->fsmonitor_valid = 0;
+}
+
+static int entry_stat_matches(const IndexEntry *e, const struct stat *st){
+    return e->size       == (uint64_t)st->st_size &&
+           e->mtime      == (long)st->st_mtim.tv_sec &&
+           e->mtime_nsec == (long)st->st_mtim.tv_nsec &&
+           e->ctime      == (long)st->st_ctim.tv_sec &&
+           e->ctime_nsec == (long)st->st_ctim.tv_nsec &&
+           e->ino        == (uint64_t)st->st_ino &&
+           e->dev        == (uint64_t)st->st_dev;
+}
+
+/* mtime, verilen andan (index'in yazıldığı an) eski değilse kayıt "racy"dir */
+static int entry_is_racy(const IndexEntry *e, long sec, long nsec){
+    return e->mtime > sec || (e->mtime == sec && e->mtime_nsec >= nsec);
+}
+
+static VaultError index_reserve(VaultIndex *idx, size_t need){
+    if (need <= idx->capacity)
+        return VAULT_OK;
+    size_t cap = idx->capacity ? idx->capacity * 2 : 16;
+    while (cap < need)
+        cap *= 2;
+    IndexEntry *grown = realloc(idx->entries, cap * sizeof(*grown));
+    if (!grown)
+        return VAULT_ERR_NOMEM;
+    idx->entries  = grown;
+    idx->capacity = cap;
+    return VAULT_OK;
+}
+
+/* ---- Cache-tree --------------------------------------------------------- */
+
+/* path'in ilk len byte'ı ('/' ile biten dizin yolu) için düğüm; yoksa NULL */
+static IndexTreeNode *tree_node_find(IndexTreeNode *nodes, size_t count,
+                                     const char *path, size_t len){
+    size_t lo = 0, hi = count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        int cmp = strncmp(nodes[mid].path, path, len);
+        if (cmp == 0 && nodes[mid].path[len] != '\0')
+            cmp = 1;
+        if (cmp == 0)
+            return &nodes[mid];
+        if (cmp < 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return NULL;
+}
+
+/* Dosyanın yolu üzerindeki tüm dizinleri (kök dahil) geçersiz kılar */
+static void tree_cache_invalidate(VaultIndex *idx, const char *filepath){
+    size_t len = 0;
+    while (idx->tree_count > 0) {
+        IndexTreeNode *node = tree_node_find(idx->tree_nodes, idx->tree_count, filepath, len);
+        if (node)
+            node->valid = 0;
+        const char *slash = strchr(filepath + len, '/');
+        if (!slash)
+            break;
+        len = (size_t)(slash - filepath) + 1;
+    }
+}
+
+static void tree_nodes_free(IndexTreeNode *nodes, size_t count){
+    for (size_t i = 0; i < count; i++)
+        free(nodes[i].path);
+    free(nodes);
+}
+
+/* "TREE" eklentisi: düğüm sayısı, sonra her düğüm yol uzunluğu | yol | hash */
+static VaultError tree_cache_read(VaultIndex *idx, const uint8_t *p, size_t len){
+    if (len < 4)
+        return VAULT_ERR_CORRUPT;
+    const uint8_t *end = p + len;
+    uint32_t count = get_be32(p);
+    p += 4;
+    if ((size_t)count > (len - 4) / (2 + VAULT_HASH_RAW_SIZE))
+        return VAULT_ERR_CORRUPT;
+
+    idx->tree_nodes = calloc(count ? count : 1, sizeof(*idx->tree_nodes));
+    if (!idx->tree_nodes)
+        return VAULT_ERR_NOMEM;
+
+    for (uint32_t i = 0; i < count; i++) {
+        if (end - p < 2)
+            return VAULT_ERR_CORRUPT;
+        size_t path_len = ((size_t)p[0] << 8) | p[1];
+        p += 2;
+        if ((size_t)(end - p) < path_len + VAULT_HASH_RAW_SIZE || path_len >= VAULT_MAX_PATH ||
+            (path_len > 0 && p[path_len - 1] != '/'))
+            return VAULT_ERR_CORRUPT;
+
+        IndexTreeNode *node = &idx->tree_nodes[idx->tree_count];
+        if (!(node->path = malloc(path_len + 1)))
+            return VAULT_ERR_NOMEM;
+        idx->tree_count++;
+        memcpy(node->path, p, path_len);
+        node->path[path_len] = '\0';
+        memcpy(node->oid.id, p + path_len, VAULT_HASH_RAW_SIZE);
+        node->valid = 1;
+        p += path_len + VAULT_HASH_RAW_SIZE;
+
+        if (i > 0 && strcmp(idx->tree_nodes[i - 1].path, node->path) >= 0)
+            return VAULT_ERR_CORRUPT;
+    }
+    return VAULT_OK;
+}
+
+/* "FSMN" eklentisi: token uzunluğu | token | kayıt başına bir bit */
+static VaultError fsmonitor_read(VaultIndex *idx, const uint8_t *p, size_t len){
+    if (len < 2)
+        return VAULT_ERR_CORRUPT;
+    size_t token_len = ((size_t)p[0] << 8) | p[1];
+    if (token_len == 0 || token_len >= VAULT_FSMONITOR_TOKEN_MAX ||
+        len != 2 + token_len + (idx->count + 7) / 8)
+        return VAULT_ERR_CORRUPT;
+    memcpy(idx->fsmonitor_token, p + 2, token_len);
+    idx->fsmonitor_token[token_len] = '\0';
+
+    const uint8_t *bits = p + 2 + token_len;
+    for (size_t i = 0; i < idx->count; i++)
+        idx->entries[i].fsmonitor_valid = (bits[i >> 3] >> (i & 7)) & 1;
+    return VAULT_OK;
+}
+
+/* ---- Untracked cache ---------------------------------------------------- */
+
+#define UNTRACKED_STAT_FIELDS  6    /* mtime, mtime_nsec, ctime, ctime_nsec, ino, dev */
+
+static void untracked_dirs_free(IndexUntrackedDir *dirs, size_t count){
+    for (size_t i = 0; i < count; i++) {
+        free(dirs[i].path);
+        free(dirs[i].names);
+    }
+    free(dirs);
+}
+
+/* path ('/' ile biten dizin yolu, "" = kök) için düğüm; yoksa NULL */
+static IndexUntrackedDir *untracked_dir_find(IndexUntrackedDir *dirs, size_t count,
+                                             const char *path){
+    size_t lo = 0, hi = count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        int cmp = strcmp(dirs[mid].path, path);
+        if (cmp == 0)
+            return &dirs[mid];
+        if (cmp < 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return NULL;
+}
+
+/* Index'ten çıkan dosya diskte kalmış olabilir: dizini önbellekte ona
+ * "izleniyor" diye yer vermemişti, yeniden okunmalı */
+static void untracked_cache_invalidate(VaultIndex *idx, const char *filepath){
+    const char *slash = strrchr(filepath, '/');
+    size_t len = slash ? (size_t)(slash - filepath) + 1 : 0;
+    char dir[VAULT_MAX_PATH];
+    if (idx->untracked_count == 0 || len >= sizeof(dir))
+        return;
+    memcpy(dir, filepath, len);
+    dir[len] = '\0';
+    IndexUntrackedDir *node = untracked_dir_find(idx->untracked_dirs, idx->untracked_count, dir);
+    if (node)
+        node->valid = 0;
+}
+
+static int untracked_dir_matches(const IndexUntrackedDir *d, const struct stat *st){
+    return d->mtime      == (long)st->st_mtim.tv_sec &&
+           d->mtime_nsec == (long)st->st_mtim.tv_nsec &&
+           d->ctime      == (long)st->st_ctim.tv_sec &&
+           d->ctime_nsec == (long)st->st_ctim.tv_nsec &&
+           d->ino        == (uint64_t)st->st_ino &&
+           d->dev        == (uint64_t)st->st_dev;
+}
+
+/* Geçersiz kılınmış ya da yazma anıyla aynı zaman diliminde değişmiş
+ * (racy) dizinler önbelleğe yazılmaz */
+static int untracked_dir_writable(const IndexUntrackedDir *d, const struct stat *now){
+    return d->valid && (d->mtime < (long)now->st_mtim.tv_sec ||
+                        (d->mtime == (long)now->st_mtim.tv_sec &&
+                         d->mtime_nsec < (long)now->st_mtim.tv_nsec));
+}
+
+/* "UNTR" eklentisi: dizin sayısı, sonra her dizin yol | stat | adlar */
+static VaultError untracked_cache_read(VaultIndex *idx, const uint8_t *p, size_t len){
+    if (len < 4)
+        return VAULT_ERR_CORRUPT;
+    const uint8_t *end = p + len;
+    uint32_t count = get_be32(p);
+    p += 4;
+    if ((size_t)count > (len - 4) / (2 + UNTRACKED_STAT_FIELDS * 8 + 4))
+        return VAULT_ERR_CORRUPT;
+
+    idx->untracked_dirs = calloc(count ? count : 1, sizeof(*idx->untracked_dirs));
+    if (!idx->untracked_dirs)
+        return VAULT_ERR_NOMEM;
+
+    for (uint32_t i = 0; i < count; i++) {
+        if (end - p < 2)
+            return VAULT_ERR_CORRUPT;
+        size_t path_len = ((size_t)p[0] << 8) | p[1];
+        p += 2;
+        if ((size_t)(end - p) < path_len + UNTRACKED_STAT_FIELDS * 8 + 4 ||
+            path_len >= VAULT_MAX_PATH || (path_len > 0 && p[path_len - 1] != '/'))
+            return VAULT_ERR_CORRUPT;
+
+        IndexUntrackedDir *d = &idx->untracked_dirs[idx->untracked_count];
+        if (!(d->path = malloc(path_len + 1)))
+            return VAULT_ERR_NOMEM;
+        idx->untracked_count++;
+        memcpy(d->path, p, path_len);
+        d->path[path_len] = '\0';
+        p += path_len;
+
+        d->mtime      = (long)(int64_t)get_be64(p);
+        d->mtime_nsec = (long)(int64_t)get_be64(p + 8);
+        d->ctime      = (long)(int64_t)get_be64(p + 16);
+        d->ctime_nsec = (long)(int64_t)get_be64(p + 24);
+        d->ino        = get_be64(p + 32);
+        d->dev        = get_be64(p + 40);
+        size_t names_len = get_be32(p + 48);
+        p += UNTRACKED_STAT_FIELDS * 8 + 4;
+        if ((size_t)(end - p) < names_len || (names_len > 0 && p[names_len - 1] != '\0'))
+            return VAULT_ERR_CORRUPT;
+        if (names_len > 0) {
+            if (!(d->names = malloc(names_len)))
+                return VAULT_ERR_NOMEM;
+            memcpy(d->names, p, names_len);
+        }
+        d->names_len = names_len;
+        d->valid = 1;
+        p += names_len;
+
+        if (i > 0 && strcmp(idx->untracked_dirs[i - 1].path, d->path) >= 0)
+            return VAULT_ERR_CORRUPT;
+    }
+    return VAULT_OK;
+}
+
+/* Kayıtlardan sonraki eklentiler: imza | uzunluk | veri */
+static VaultError index_read_extensions(VaultIndex *idx, const uint8_t *m,
+                                        size_t pos, size_t body){
+    while (pos < body) {
+        if (body - pos < 8)
+            return VAULT_ERR_CORRUPT;
+        size_t len = get_be32(m + pos + 4);
+        if (len > body - pos - 8)
+            return VAULT_ERR_CORRUPT;
+        if (memcmp(m + pos, "TREE", 4) == 0 && idx->tree_nodes == NULL) {
+            VaultError err = tree_cache_read(idx, m + pos + 8, len);
+            if (err != VAULT_OK)
+                return err;
+        } else if (memcmp(m + pos, "FSMN", 4) == 0 && idx->fsmonitor_token[0] == '\0') {
+            VaultError err = fsmonitor_read(idx, m + pos + 8, len);
+            if (err != VAULT_OK)
+                return err;
+        } else if (memcmp(m + pos, "UNTR", 4) == 0 && !idx->untracked_dirs) {
+            VaultError err = untracked_cache_read(idx, m + pos + 8, len);
+            if (err != VAULT_OK)
+                return err;
+        }
+        pos += 8 + len;
+    }
+    return VAULT_OK;
+}
+
+/* Küçük dosya: tek parça oku, vault_blob_write ile yaz */
+static VaultError blob_from_buffer(const char *path, size_t size, VaultOid *out_oid){
+    FILE *fp = fopen(path, "rb");
+    if (!fp)
+        return VAULT_ERR_IO;
+
+    VaultBlob blob;
+    blob.size = size;
+    blob.data = malloc(size ? size : 1);
+    if (!blob.data) {
+        fclose(fp);
+        return VAULT_ERR_NOMEM;
+    }
+
+    VaultError err = VAULT_OK;
+    if (size && fread(blob.data, 1, size, fp) != size)
+        err = VAULT_ERR_IO;
+    fclose(fp);
+
+    if (err == VAULT_OK)
+        err = vault_blob_write(&blob, out_oid);
+    free(blob.data);
+    return err;
+}
+
+/* Büyük dosya: VAULT_STREAM_CHUNK'lık parçalarla akış olarak yaz */
+static VaultError blob_from_stream(const char *path, size_t size, VaultOid *out_oid){
+    FILE *fp = fopen(path, "rb");
+    if (!fp)
+        return VAULT_ERR_IO;
+
+    uint8_t *buf = malloc(VAULT_STREAM_CHUNK);
+    if (!buf) {
+        fclose(fp);
+        return VAULT_ERR_NOMEM;
+    }
+
+    VaultObjectStream *st;
+    VaultError err = vault_object_stream_open(&st, VAULT_OBJ_BLOB, size);
+    if (err != VAULT_OK) {
+        free(buf);
+        fclose(fp);
+        return err;
+    }
+
+    size_t n;
+    while (err == VAULT_OK && (n = fread(buf, 1, VAULT_STREAM_CHUNK, fp)) > 0)
+        err = vault_object_stream_write(st, buf, n);
+    if (err == VAULT_OK && ferror(fp))
+        err = VAULT_ERR_IO;
+    fclose(fp);
+    free(buf);
+
+    if (err != VAULT_OK) {
+        vault_object_stream_abort(st);
+        return err;
+    }
+    /* Dosya okuma sırasında büyüdü/küçüldüyse finish CORRUPT döner */
+    return vault_object_stream_finish(st, out_oid);
+}
+
+/* ---- Index (Staging Area) Fonksiyonları --------------------------------- */
 
 VaultError vault_index_load(VaultIndex *idx){
-    (void)idx;
+    memset(idx, 0, sizeof(*idx));
+
+    int fd = open(VAULT_INDEX_FILE, O_RDONLY);
+    if (fd < 0)
+        return (errno == ENOENT) ? VAULT_OK : VAULT_ERR_IO;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return VAULT_ERR_IO;
+    }
+    if (st.st_size == 0) {      /* "vault init" boş dosya bırakır */
+        close(fd);
+        return VAULT_OK;
+    }
+
+    size_t size = (size_t)st.st_size;
+    void *map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return VAULT_ERR_IO;
+    idx->map = map;
+    idx->map_size = size;
+    idx->timestamp      = (long)st.st_mtim.tv_sec;
+    idx->timestamp_nsec = (long)st.st_mtim.tv_nsec;
+
+    const uint8_t *m = map;
+    if (size < INDEX_HEADER_SIZE + VAULT_HASH_RAW_SIZE ||
+        memcmp(m, VAULT_INDEX_MAGIC, 4) != 0 ||
+        get_be32(m + 4) != VAULT_INDEX_VERSION)
+        goto corrupt;
+
+    /* Sondaki checksum */
+    uint8_t digest[VAULT_SHA256_DIGEST_SIZE];
+    size_t body = size - VAULT_HASH_RAW_SIZE;
+    vault_sha256(m, body, digest);
+    if (memcmp(digest, m + body, VAULT_HASH_RAW_SIZE) != 0)
+        goto corrupt;
+
+    uint32_t count = get_be32(m + 8);
+    if ((size_t)count > (body - INDEX_HEADER_SIZE) / (4 + INDEX_ENTRY_FIXED + 2))
+        goto corrupt;
+    if (index_reserve(idx, count) != VAULT_OK) {
+        vault_index_free(idx);
+        return VAULT_ERR_NOMEM;
+    }
+
+    const uint8_t *offsets = m + INDEX_HEADER_SIZE;
+    size_t records_end = INDEX_HEADER_SIZE + (size_t)count * 4;
+    for (uint32_t i = 0; i < count; i++) {
+        size_t off = get_be32(offsets + (size_t)i * 4);
+        if (off < INDEX_HEADER_SIZE + (size_t)count * 4 || off + INDEX_ENTRY_FIXED > body)
+            goto corrupt;
+
+        const uint8_t *rec = m + off;
+        size_t path_len = ((size_t)rec[INDEX_PATH_LEN_OFF] << 8) | rec[INDEX_PATH_LEN_OFF + 1];
+        if (path_len == 0 || path_len >= VAULT_MAX_PATH ||
+            off + INDEX_ENTRY_FIXED + path_len + 1 > body ||
+            rec[INDEX_ENTRY_FIXED + path_len] != '\0')
+            goto corrupt;
+
+        IndexEntry *e = &idx->entries[idx->count++];
+        memcpy(e->hash.id, rec, VAULT_HASH_RAW_SIZE);
+        const uint8_t *f = rec + VAULT_HASH_RAW_SIZE;
+        e->mtime      = (long)(int64_t)get_be64(f);
+        e->mtime_nsec = (long)(int64_t)get_be64(f + 8);
+        e->ctime      = (long)(int64_t)get_be64(f + 16);
+        e->ctime_nsec = (long)(int64_t)get_be64(f + 24);
+        e->size       = get_be64(f + 32);
+        e->ino        = get_be64(f + 40);
+        e->dev        = get_be64(f + 48);
+        e->fsmonitor_valid = 0;
+        e->filepath = (const char *)rec + INDEX_ENTRY_FIXED;
+
+        if (i > 0 && strcmp(idx->entries[i - 1].filepath, e->filepath) >= 0)
+            goto corrupt;
+        if (off + INDEX_ENTRY_FIXED + path_len + 1 > records_end)
+            records_end = off + INDEX_ENTRY_FIXED + path_len + 1;
+    }
+
+    VaultError err = index_read_extensions(idx, m, records_end, body);
+    if (err == VAULT_ERR_NOMEM) {
+        vault_index_free(idx);
+        return err;
+    }
+    if (err != VAULT_OK)
+        goto corrupt;
     return VAULT_OK;
+
+corrupt:
+    vault_index_free(idx);
+    return VAULT_ERR_CORRUPT;
+}
+
+/* Yazılan her byte checksum'a da girer */
+static int index_emit(FILE *fp, VaultSha256 *md, const void *buf, size_t len){
+    vault_sha256_update(md, buf, len);
+    return fwrite(buf, 1, len, fp) == len ? 0 : -1;
 }
 
 VaultError vault_index_save(const VaultIndex *idx){
-    (void)idx;
+    /* Offset'ler 32 bit: toplam boyutu önceden kontrol et */
+    uint64_t total = INDEX_HEADER_SIZE + (uint64_t)idx->count * 4;
+    for (size_t i = 0; i < idx->count; i++)
+        total += INDEX_ENTRY_FIXED + strlen(idx->entries[i].filepath) + 1;
+    if (total > UINT32_MAX)
+        return VAULT_ERR_IO;
+
+    /* Cache-tree: yalnızca geçerli düğümler yazılır */
+    uint64_t tree_len = 4;
+    uint32_t tree_valid = 0;
+    for (size_t i = 0; i < idx->tree_count; i++)
+        if (idx->tree_nodes[i].valid) {
+            tree_len += 2 + strlen(idx->tree_nodes[i].path) + VAULT_HASH_RAW_SIZE;
+            tree_valid++;
+        }
+    if (tree_len > UINT32_MAX)
+        tree_valid = 0;
+
+    /* Index'teki blob'lar index'ten önce kalıcı olmalı */
+    VaultError err = vault_fsync_barrier();
+    if (err != VAULT_OK)
+        return err;
+
+    char tmp[] = ".vault/index_XXXXXX";
+    int fd = mkstemp(tmp);
+    if (fd < 0)
+        return VAULT_ERR_IO;
+    fchmod(fd, 0644);
+
+    /* Yeni index'in zaman damgası bu andan eski olamaz: racy kayıtları
+     * tespit etmek için dosya sisteminin kendi saatini kullan. */
+    struct stat now;
+    if (fstat(fd, &now) != 0) {
+        close(fd);
+        unlink(tmp);
+        return VAULT_ERR_IO;
+    }
+
+    FILE *fp = fdopen(fd, "wb");
+    if (!fp) {
+        close(fd);
+        unlink(tmp);
+        return VAULT_ERR_IO;
+    }
+    VaultSha256 md;
+    vault_sha256_init(&md);
+
+    uint8_t buf[INDEX_ENTRY_FIXED];
+    memcpy(buf, VAULT_INDEX_MAGIC, 4);
+    put_be32(buf + 4, VAULT_INDEX_VERSION);
+    put_be32(buf + 8, (uint32_t)idx->count);
+    int ok = index_emit(fp, &md, buf, INDEX_HEADER_SIZE) == 0;
+
+    uint32_t off = INDEX_HEADER_SIZE + (uint32_t)idx->count * 4;
+    for (size_t i = 0; ok && i < idx->count; i++) {
+        put_be32(buf, off);
+        ok = index_emit(fp, &md, buf, 4) == 0;
+        off += INDEX_ENTRY_FIXED + (uint32_t)strlen(idx->entries[i].filepath) + 1;
+    }
+
+    for (size_t i = 0; ok && i < idx->count; i++) {
+        const IndexEntry *e = &idx->entries[i];
+        size_t path_len = strlen(e->filepath);
+        memcpy(buf, e->hash.id, VAULT_HASH_RAW_SIZE);
+        /* Racy kayıt: size 0 yazılır, sonraki status stat'a güvenmez */
+        int racy = entry_is_racy(e, (long)now.st_mtim.tv_sec, (long)now.st_mtim.tv_nsec);
+        uint8_t *f = buf + VAULT_HASH_RAW_SIZE;
+        put_be64(f,      (uint64_t)(int64_t)e->mtime);
+        put_be64(f + 8,  (uint64_t)(int64_t)e->mtime_nsec);
+        put_be64(f + 16, (uint64_t)(int64_t)e->ctime);
+        put_be64(f + 24, (uint64_t)(int64_t)e->ctime_nsec);
+        put_be64(f + 32, racy ? 0 : e->size);
+        put_be64(f + 40, e->ino);
+        put_be64(f + 48, e->dev);
+        buf[INDEX_PATH_LEN_OFF]     = (uint8_t)(path_len >> 8);
+        buf[INDEX_PATH_LEN_OFF + 1] = (uint8_t)path_len;
+        ok = ok && index_emit(fp, &md, buf, INDEX_ENTRY_FIXED) == 0 &&
+             index_emit(fp, &md, e->filepath, path_len + 1) == 0;
+    }
+
+    size_t token_len = strlen(idx->fsmonitor_token);
+    if (ok && token_len > 0) {
+        memcpy(buf, "FSMN", 4);
+        put_be32(buf + 4, (uint32_t)(2 + token_len + (idx->count + 7) / 8));
+        buf[8] = (uint8_t)(token_len >> 8);
+        buf[9] = (uint8_t)token_len;
+        ok = index_emit(fp, &md, buf, 10) == 0 &&
+             index_emit(fp, &md, idx->fsmonitor_token, token_len) == 0;
+        for (size_t i = 0; ok && i < idx->count; i += 8) {
+            uint8_t byte = 0;
+            for (size_t j = i; j < i + 8 && j < idx->count; j++)
+                byte |= (uint8_t)((idx->entries[j].fsmonitor_valid ? 1 : 0) << (j - i));
+            ok = index_emit(fp, &md, &byte, 1) == 0;
+        }
+    }
+
+    uint64_t untracked_len = 4;
+    uint32_t untracked_kept = 0;
+    for (size_t i = 0; i < idx->untracked_count; i++)
+        if (untracked_dir_writable(&idx->untracked_dirs[i], &now)) {
+            untracked_len += 2 + strlen(idx->untracked_dirs[i].path) +
+                             UNTRACKED_STAT_FIELDS * 8 + 4 + idx->untracked_dirs[i].names_len;
+            untracked_kept++;
+        }
+    if (ok && untracked_kept > 0 && untracked_len <= UINT32_MAX) {
+        memcpy(buf, "UNTR", 4);
+        put_be32(buf + 4, (uint32_t)untracked_len);
+        put_be32(buf + 8, untracked_kept);
+        ok = index_emit(fp, &md, buf, 12) == 0;
+        for (size_t i = 0; ok && i < idx->untracked_count; i++) {
+            const IndexUntrackedDir *d = &idx->untracked_dirs[i];
+            if (!untracked_dir_writable(d, &now))
+                continue;
+            size_t path_len = strlen(d->path);
+            buf[0] = (uint8_t)(path_len >> 8);
+            buf[1] = (uint8_t)path_len;
+            uint8_t *f = buf + 2;
+            put_be64(f,      (uint64_t)(int64_t)d->mtime);
+            put_be64(f + 8,  (uint64_t)(int64_t)d->mtime_nsec);
+            put_be64(f + 16, (uint64_t)(int64_t)d->ctime);
+            put_be64(f + 24, (uint64_t)(int64_t)d->ctime_nsec);
+            put_be64(f + 32, d->ino);
+            put_be64(f + 40, d->dev);
+            put_be32(f + 48, (uint32_t)d->names_len);
+            ok = index_emit(fp, &md, buf, 2) == 0 &&
+                 index_emit(fp, &md, d->path, path_len) == 0 &&
+                 index_emit(fp, &md, f, UNTRACKED_STAT_FIELDS * 8 + 4) == 0 &&
+                 (d->names_len == 0 || index_emit(fp, &md, d->names, d->names_len) == 0);
+        }
+    }
+
+    if (ok && tree_valid > 0) {
+        memcpy(buf, "TREE", 4);
+        put_be32(buf + 4, (uint32_t)tree_len);
+        put_be32(buf + 8, tree_valid);
+        ok = index_emit(fp, &md, buf, 12) == 0;
+        for (size_t i = 0; ok && i < idx->tree_count; i++) {
+            const IndexTreeNode *node = &idx->tree_nodes[i];
+            if (!node->valid)
+                continue;
+            size_t path_len = strlen(node->path);
+            buf[0] = (uint8_t)(path_len >> 8);
+            buf[1] = (uint8_t)path_len;
+            ok = index_emit(fp, &md, buf, 2) == 0 &&
+                 index_emit(fp, &md, node->path, path_len) == 0 &&
+                 index_emit(fp, &md, node->oid.id, VAULT_HASH_RAW_SIZE) == 0;
+        }
+    }
+
+    uint8_t digest[VAULT_SHA256_DIGEST_SIZE];
+    vault_sha256_final(&md, digest);
+    ok = ok && fwrite(digest, 1, VAULT_HASH_RAW_SIZE, fp) == VAULT_HASH_RAW_SIZE;
+    ok = ok && fflush(fp) == 0 && vault_fsync_file(fileno(fp)) == VAULT_OK;
+
+    if (fclose(fp) != 0 || !ok || rename(tmp, VAULT_INDEX_FILE) != 0) {
+        unlink(tmp);
+        return VAULT_ERR_IO;
+    }
+    return vault_fsync_dir(VAULT_DIR);
+}
+
+/* Bir dosyanın blob'unu yazıp index'e girecek bilgileri hazırlar.
+ * Index'e dokunmaz; iş parçacıklarından güvenle çağrılabilir. */
+typedef struct {
+    VaultOid    hash;
+    struct stat st;
+    VaultError  err;
+} PreparedEntry;
+
+static void prepare_entry(const char *filepath, PreparedEntry *out){
+    struct stat *st = &out->st;
+
+    if (strlen(filepath) >= VAULT_MAX_PATH) {
+        out->err = VAULT_ERR_IO;
+        return;
+    }
+    if (stat(filepath, st) != 0) {
+        out->err = VAULT_ERR_NOTFOUND;
+        return;
+    }
+    if (!S_ISREG(st->st_mode)) {
+        out->err = VAULT_ERR_IO;
+        return;
+    }
+
+    size_t size = (size_t)st->st_size;
+    out->err = (size >= VAULT_INDEX_STREAM_THRESHOLD)
+             ? blob_from_stream(filepath, size, &out->hash)
+             : blob_from_buffer(filepath, size, &out->hash);
+}
+
+/* Sıralı konuma tek kayıt ekler ya da mevcut kaydı günceller */
+static VaultError apply_entry(VaultIndex *idx, const char *filepath,
+                              const PreparedEntry *prep){
+    int found;
+    size_t pos = index_lower_bound(idx->entries, idx->count, filepath, &found);
+    if (!found) {
+        char *copy = strdup(filepath);
+        if (!copy || index_reserve(idx, idx->count + 1) != VAULT_OK) {
+            free(copy);
+            return VAULT_ERR_NOMEM;
+        }
+        memmove(&idx->entries[pos + 1], &idx->entries[pos],
+                (idx->count - pos) * sizeof(*idx->entries));
+        idx->count++;
+        idx->entries[pos].filepath = copy;
+        tree_cache_invalidate(idx, filepath);
+    } else if (!vault_oid_equal(&idx->entries[pos].hash, &prep->hash)) {
+        tree_cache_invalidate(idx, filepath);
+    }
+    idx->entries[pos].hash = prep->hash;
+    entry_set_stat(&idx->entries[pos], &prep->st);
     return VAULT_OK;
 }
 
 VaultError vault_index_add(VaultIndex *idx, const char *filepath){
-    (void)idx;
-    (void)filepath;
+    PreparedEntry prep;
+    filepath = normalize_path(filepath);
+    prepare_entry(filepath, &prep);
+    if (prep.err != VAULT_OK)
+        return prep.err;
+    return apply_entry(idx, filepath, &prep);
+}
+
+VaultError vault_index_update(VaultIndex *idx, const char *filepath, const VaultOid *oid){
+    PreparedEntry prep;
+    filepath = normalize_path(filepath);
+    if (strlen(filepath) >= VAULT_MAX_PATH)
+        return VAULT_ERR_IO;
+    if (stat(filepath, &prep.st) != 0)
+        return VAULT_ERR_NOTFOUND;
+    prep.hash = *oid;
+    return apply_entry(idx, filepath, &prep);
+}
+
+/* ---- Paralel ekleme ----------------------------------------------------- */
+
+/*
+ * entries[0, sorted) sıralı, entries[sorted, count) sırasız yeni kayıtlar.
+ * Yenileri sıralar, aynı yol iki kez verildiyse tekini atar ve iki sıralı
+ * diziyi birleştirir.
+ */
+static VaultError index_merge_tail(VaultIndex *idx, size_t sorted){
+    IndexEntry *tail = idx->entries + sorted;
+    size_t tail_count = idx->count - sorted;
+    qsort(tail, tail_count, sizeof(*tail), entry_cmp);
+
+    size_t uniq = 0;
+    for (size_t i = 0; i < tail_count; i++) {
+        if (uniq > 0 && strcmp(tail[uniq - 1].filepath, tail[i].filepath) == 0) {
+            free((char *)tail[uniq - 1].filepath);
+            tail[uniq - 1] = tail[i];
+            continue;
+        }
+        tail[uniq++] = tail[i];
+    }
+    tail_count = uniq;
+
+    IndexEntry *merged = malloc((sorted + tail_count) * sizeof(*merged));
+    if (!merged)
+        return VAULT_ERR_NOMEM;
+
+    size_t i = 0, j = 0, k = 0;
+    while (i < sorted && j < tail_count)
+        merged[k++] = (strcmp(idx->entries[i].filepath, tail[j].filepath) < 0)
+                    ? idx->entries[i++] : tail[j++];
+    while (i < sorted)
+        merged[k++] = idx->entries[i++];
+    while (j < tail_count)
+        merged[k++] = tail[j++];
+
+    free(idx->entries);
+    idx->entries  = merged;
+    idx->count    = k;
+    idx->capacity = k;
     return VAULT_OK;
 }
 
+typedef struct {
+    char *const     *paths;
+    PreparedEntry   *prepared;
+    size_t           count;
+    size_t           next;      /* Sıradaki alınacak iş */
+    pthread_mutex_t  lock;
+} AddPool;
+
+static void *add_worker(void *arg){
+    AddPool *pool = arg;
+    for (;;) {
+        pthread_mutex_lock(&pool->lock);
+        size_t i = pool->next++;
+        pthread_mutex_unlock(&pool->lock);
+        if (i >= pool->count)
+            break;
+        prepare_entry(normalize_path(pool->paths[i]), &pool->prepared[i]);
+    }
+    return NULL;
+}
+
+static int default_jobs(void){
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+}
+
+VaultError vault_index_add_batch(VaultIndex *idx, char *const *filepaths,
+                                 size_t count, int jobs, VaultError *results){
+    if (count == 0)
+        return VAULT_OK;
+
+    AddPool pool = { filepaths, NULL, count, 0, PTHREAD_MUTEX_INITIALIZER };
+    pool.prepared = calloc(count, sizeof(*pool.prepared));
+    if (!pool.prepared)
+        return VAULT_ERR_NOMEM;
+
+    if (jobs <= 0)
+        jobs = default_jobs();
+    if ((size_t)jobs > count)
+        jobs = (int)count;
+
+    /* Ana iş parçacığı da çalışır; jobs - 1 ek iş parçacığı yeter */
+    pthread_t *threads = calloc((size_t)jobs, sizeof(*threads));
+    int started = 0;
+    if (threads)
+        while (started < jobs - 1 &&
+               pthread_create(&threads[started], NULL, add_worker, &pool) == 0)
+            started++;
+    add_worker(&pool);
+    for (int i = 0; i < started; i++)
+        pthread_join(threads[i], NULL);
+    free(threads);
+
+    /*
+     * Birleştirme tek iş parçacığında yapılır → deterministik index.
+     * Var olan kayıtlar yerinde güncellenir; yeniler sona eklenir, sonra
+     * kendi aralarında sıralanıp mevcut dizi ile tek geçişte birleştirilir
+     * (her ekleme için memmove yapmak binlerce dosyada O(n²) olurdu).
+     */
+    VaultError first = VAULT_OK;
+    size_t sorted = idx->count;
+    for (size_t i = 0; i < count; i++) {
+        const char *path = normalize_path(filepaths[i]);
+        VaultError err = pool.prepared[i].err;
+
+        if (err == VAULT_OK) {
+            int found;
+            size_t pos = index_lower_bound(idx->entries, sorted, path, &found);
+            if (!found) {
+                char *copy = strdup(path);
+                if (!copy || index_reserve(idx, idx->count + 1) != VAULT_OK) {
+                    free(copy);
+                    err = VAULT_ERR_NOMEM;
+                } else {
+                    pos = idx->count++;
+                    idx->entries[pos].filepath = copy;
+                    tree_cache_invalidate(idx, path);
+                }
+            } else if (!vault_oid_equal(&idx->entries[pos].hash, &pool.prepared[i].hash)) {
+                tree_cache_invalidate(idx, path);
+            }
+            if (err == VAULT_OK) {
+                idx->entries[pos].hash = pool.prepared[i].hash;
+                entry_set_stat(&idx->entries[pos], &pool.prepared[i].st);
+            }
+        }
+
+        if (results)
+            results[i] = err;
+        if (err != VAULT_OK && first == VAULT_OK)
+            first = err;
+    }
+    free(pool.prepared);
+
+    if (idx->count > sorted) {
+        VaultError err = index_merge_tail(idx, sorted);
+        if (err != VAULT_OK && first == VAULT_OK)
+            first = err;
+    }
+    return first;
+}
+
 VaultError vault_index_remove(VaultIndex *idx, const char *filepath){
-    (void)idx;
-    (void)filepath;
+    int pos = vault_index_find(idx, filepath);
+    if (pos < 0)
+        return VAULT_ERR_NOTFOUND;
+
+    tree_cache_invalidate(idx, idx->entries[pos].filepath);
+    untracked_cache_invalidate(idx, idx->entries[pos].filepath);
+    entry_release(idx, &idx->entries[pos]);
+    memmove(&idx->entries[pos], &idx->entries[pos + 1],
+            (idx->count - (size_t)pos - 1) * sizeof(*idx->entries));
+    idx->count--;
     return VAULT_OK;
 }
 
 int vault_index_find(const VaultIndex *idx, const char *filepath){
-    (void)idx;
-    (void)filepath;
+    int found;
+    size_t pos = index_lower_bound(idx->entries, idx->count,
+                                   normalize_path(filepath), &found);
+    return found ? (int)pos : -1;
+}
+
+/* ---- Tree / Commit ------------------------------------------------------ */
+
+static VaultError tree_push(VaultTree *tree, const char *mode, const char *name,
+                            size_t name_len, const VaultOid *oid){
+    if (name_len == 0 || name_len >= sizeof(tree->entries[0].name))
+        return VAULT_ERR_CORRUPT;
+    if (tree->count == tree->capacity) {
+        size_t cap = tree->capacity ? tree->capacity * 2 : 16;
+        VaultTreeEntry *grown = realloc(tree->entries, cap * sizeof(*grown));
+        if (!grown)
+            return VAULT_ERR_NOMEM;
+        tree->entries  = grown;
+        tree->capacity = cap;
+    }
+    VaultTreeEntry *e = &tree->entries[tree->count++];
+    snprintf(e->mode, sizeof(e->mode), "%s", mode);
+    memcpy(e->name, name, name_len);
+    e->name[name_len] = '\0';
+    e->hash = *oid;
+    return VAULT_OK;
+}
+
+/*
+ * Cache-tree'yi yeniden kuran geçiş: eski düğümler (old) yalnızca okunur,
+ * yeni liste (out) ağacın pre-order sırasında, yani path sırasında doldurulur.
+ * Artık olmayan dizinlerin düğümleri yeni listeye geçmez.
+ */
+typedef struct {
+    IndexTreeNode *old;
+    size_t         old_count;
+    IndexTreeNode *out;
+    size_t         count;
+    size_t         capacity;
+} TreeBuild;
+
+static IndexTreeNode *tree_build_push(TreeBuild *tb){
+    if (tb->count == tb->capacity) {
+        size_t cap = tb->capacity ? tb->capacity * 2 : 64;
+        IndexTreeNode *grown = realloc(tb->out, cap * sizeof(*grown));
+        if (!grown)
+            return NULL;
+        tb->out = grown;
+        tb->capacity = cap;
+    }
+    IndexTreeNode *node = &tb->out[tb->count++];
+    memset(node, 0, sizeof(*node));
+    return node;
+}
+
+/*
+ * entries[begin, end) aynı dizindedir ve yollarının ilk prefix_len byte'ı
+ * ortaktır. Index sıralı olduğu için bir alt dizinin tüm dosyaları ardışıktır.
+ */
+static VaultError build_tree_level(const IndexEntry *entries, size_t begin, size_t end,
+                                   size_t prefix_len, TreeBuild *tb, VaultOid *out_oid){
+    const char *dir = (begin < end) ? entries[begin].filepath : "";
+
+    /* Geçerli düğüm: hash'i ve (ardışık duran) alt düğümleri aynen taşınır */
+    IndexTreeNode *cached = tree_node_find(tb->old, tb->old_count, dir, prefix_len);
+    if (cached && cached->valid) {
+        *out_oid = cached->oid;
+        size_t j = (size_t)(cached - tb->old);
+        do {
+            IndexTreeNode *node = tree_build_push(tb);
+            if (!node)
+                return VAULT_ERR_NOMEM;
+            *node = tb->old[j];
+            if (!(node->path = strdup(tb->old[j].path))) {
+                tb->count--;
+                return VAULT_ERR_NOMEM;
+            }
+            j++;
+        } while (j < tb->old_count && strncmp(tb->old[j].path, dir, prefix_len) == 0);
+        return VAULT_OK;
+    }
+
+    /* Kirli dizin: düğümün yeri şimdi ayrılır, hash'i en sonda yazılır */
+    size_t slot = tb->count;
+    IndexTreeNode *node = tree_build_push(tb);
+    if (!node)
+        return VAULT_ERR_NOMEM;
+    if (!(node->path = strndup(dir, prefix_len))) {
+        tb->count--;
+        return VAULT_ERR_NOMEM;
+    }
+
+    VaultTree tree = { NULL, 0, 0 };
+    VaultError err = VAULT_OK;
+
+    size_t i = begin;
+    while (err == VAULT_OK && i < end) {
+        const char *name = entries[i].filepath + prefix_len;
+        const char *slash = strchr(name, '/');
+        if (!slash) {
+            err = tree_push(&tree, "100644", name, strlen(name), &entries[i].hash);
+            i++;
+            continue;
+        }
+
+        size_t dir_len = (size_t)(slash - name) + 1;   /* "src/" */
+        size_t j = i + 1;
+        while (j < end && strncmp(entries[j].filepath + prefix_len, name, dir_len) == 0)
+            j++;
+
+        VaultOid sub;
+        err = build_tree_level(entries, i, j, prefix_len + dir_len, tb, &sub);
+        if (err == VAULT_OK)
+            err = tree_push(&tree, "040000", name, dir_len - 1, &sub);
+        i = j;
+    }
+
+    if (err == VAULT_OK) {
+        uint8_t *data = NULL;
+        size_t size = 0;
+        err = vault_tree_serialize(&tree, &data, &size);
+        if (err == VAULT_OK)
+            err = vault_object_write(VAULT_OBJ_TREE, data, size, out_oid);
+        free(data);
+    }
+    vault_tree_free(&tree);
+
+    if (err == VAULT_OK) {
+        tb->out[slot].oid = *out_oid;
+        tb->out[slot].valid = 1;
+    }
+    return err;
+}
+
+VaultError vault_build_tree(VaultIndex *idx,VaultOid *out_tree_oid){
+    TreeBuild tb = { idx->tree_nodes, idx->tree_count, NULL, 0, 0 };
+    VaultError err = build_tree_level(idx->entries, 0, idx->count, 0, &tb, out_tree_oid);
+
+    /* Eski düğümlerin yerini yeni liste alır. Hata olursa cache-tree
+     * tamamen bırakılır; bir sonraki commit baştan kurar. */
+    tree_nodes_free(tb.old, tb.old_count);
+    if (err != VAULT_OK) {
+        tree_nodes_free(tb.out, tb.count);
+        tb.out = NULL;
+        tb.count = 0;
+    }
+    idx->tree_nodes = tb.out;
+    idx->tree_count = tb.count;
+    return err;
+}
+
+VaultError vault_head_read(VaultOid *out_oid){
+    vault_oid_clear(out_oid);
+
+    FILE *fp = fopen(VAULT_HEAD_FILE, "rb");
+    if (!fp)
+        return (errno == ENOENT) ? VAULT_OK : VAULT_ERR_IO;
+
+    char buf[VAULT_HASH_HEX_SIZE + 2];
+    size_t n = fread(buf, 1, sizeof(buf), fp);
+    fclose(fp);
+
+    /* Boş HEAD: henüz commit yok */
+    while (n > 0 && (buf[n - 1] == '\n' || buf[n - 1] == '\r'))
+        n--;
+    if (n == 0)
+        return VAULT_OK;
+    if (n != VAULT_HASH_HEX_SIZE - 1)
+        return VAULT_ERR_CORRUPT;
+    return vault_oid_from_hex(buf, out_oid);
+}
+
+VaultError vault_head_write(const VaultOid *oid){
+    char hex[VAULT_HASH_HEX_SIZE];
+    vault_oid_to_hex(oid, hex);
+    hex[VAULT_HASH_HEX_SIZE - 1] = '\n';
+
+    /* HEAD en son yazılır: işaret ettiği nesneler önce kalıcı olmalı */
+    VaultError err = vault_fsync_barrier();
+    if (err != VAULT_OK)
+        return err;
+
+    char tmp[] = ".vault/HEAD_XXXXXX";
+    int fd = mkstemp(tmp);
+    if (fd < 0)
+        return VAULT_ERR_IO;
+    fchmod(fd, 0644);
+
+    int ok = write(fd, hex, sizeof(hex)) == (ssize_t)sizeof(hex) &&
+             vault_fsync_file(fd) == VAULT_OK;
+    if (close(fd) != 0 || !ok || rename(tmp, VAULT_HEAD_FILE) != 0) {
+        unlink(tmp);
+        return VAULT_ERR_IO;
+    }
+    if ((err = vault_fsync_dir(VAULT_DIR)) != VAULT_OK)
+        return err;
+    return vault_fsync_barrier();
+}
+
+VaultError vault_create_commit(VaultIndex *idx,
+                               const char *author,
+                               const char *message,
+                               VaultOid *out_oid){
+    VaultCommit commit;
+    memset(&commit, 0, sizeof(commit));
+
+    VaultError err = vault_build_tree(idx, &commit.tree_hash);
+    if (err == VAULT_OK)
+        err = vault_head_read(&commit.parent_hash);
+    if (err != VAULT_OK)
+        return err;
+
+    snprintf(commit.author, sizeof(commit.author), "%s", author);
+    snprintf(commit.message, sizeof(commit.message), "%s", message);
+    commit.timestamp = (long)time(NULL);
+
+    uint8_t *data = NULL;
+    size_t size = 0;
+    err = vault_commit_serialize(&commit, &data, &size);
+    if (err == VAULT_OK)
+        err = vault_object_write(VAULT_OBJ_COMMIT, data, size, out_oid);
+    free(data);
+    if (err != VAULT_OK)
+        return err;
+
+    /* Grafik yalnızca hızlandırıcı: güncellenemezse okuyucular nesnelere
+     * düşer, commit yine de geçerlidir */
+    if (vault_graph_add(out_oid) != VAULT_OK)
+        fprintf(stderr, "vault: warning: could not update %s\n", VAULT_GRAPH_FILE);
+
+    return vault_head_write(out_oid);
+}
+
+/* ---- Değişiklik Tespiti ------------------------------------------------- */
+
+/* Stat'a bakarak: 0 = aynı, 1 = kesin değişmiş, -1 = içerik hash'lenmeli */
+static int entry_stat_check(const VaultIndex *idx, const IndexEntry *e,
+                            const struct stat *st){
+    /* Stat cache: stat aynı ve kayıt racy değilse içeriği okumaya gerek yok */
+    if (entry_stat_matches(e, st) &&
+        !entry_is_racy(e, idx->timestamp, idx->timestamp_nsec))
+        return 0;
+    if (e->size != 0 && e->size != (uint64_t)st->st_size)
+        return 1;   /* boyut farklı: hash'lemeden kesin değişmiş */
+    return -1;
+}
+
+/*
+ * Hash'lenmesi gereken küçük dosyalar birikir, sonra birlikte okunup
+ * vault_hash_blob_many ile çoklu akışta hash'lenir.
+ */
+typedef struct {
+    size_t pos[VAULT_STATUS_HASH_BATCH];       /* idx->entries içindeki sıra */
+    size_t sizes[VAULT_STATUS_HASH_BATCH];
+    size_t count;
+} HashBatch;
+
+/* Dosyayı tek parça okur; boyut stat'takinden farklıysa hata */
+static int read_small_file(const char *path, size_t size, uint8_t **out){
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return -1;
+    uint8_t *buf = malloc(size + 1);
+    ssize_t n = buf ? read(fd, buf, size + 1) : -1;
+    close(fd);
+    if (n != (ssize_t)size) {
+        free(buf);
+        return -1;
+    }
+    *out = buf;
     return 0;
 }
 
-VaultError vault_build_tree(const VaultIndex *idx,char out_tree_hash[VAULT_HASH_HEX_SIZE]){
-    (void)idx;
-    (void)out_tree_hash;
+static void hash_batch_flush(const VaultIndex *idx, HashBatch *batch, char *marks){
+    uint8_t *data[VAULT_STATUS_HASH_BATCH];
+    size_t sizes[VAULT_STATUS_HASH_BATCH], pos[VAULT_STATUS_HASH_BATCH];
+    size_t n = 0;
+    for (size_t i = 0; i < batch->count; i++) {
+        const char *path = idx->entries[batch->pos[i]].filepath;
+        if (read_small_file(path, batch->sizes[i], &data[n]) != 0) {
+            marks[batch->pos[i]] = 'M';
+            continue;
+        }
+        sizes[n] = batch->sizes[i];
+        pos[n++] = batch->pos[i];
+    }
+
+    VaultOid oids[VAULT_STATUS_HASH_BATCH];
+    VaultError err = vault_hash_blob_many((const uint8_t *const *)data, sizes, n, oids);
+    for (size_t i = 0; i < n; i++) {
+        if (err != VAULT_OK || !vault_oid_equal(&oids[i], &idx->entries[pos[i]].hash))
+            marks[pos[i]] = 'M';
+        free(data[i]);
+    }
+    batch->count = 0;
+}
+
+static int name_cmp(const void *a, const void *b){
+    return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+/*
+ * Paralel tarama (bkz. vault_walk.h). Her dizin bir işçide okunur ve
+ * sıralı adları, index'in o dizine düşen sıralı aralığıyla birleştirilir
+ * (merge-join): izlenen dosyaların durumu taramanın kendi lstat'ından
+ * çıkar, index'te olmayan dosyalar 'A' adayıdır. Kayıt başına ikinci bir
+ * lstat ya da vault_index_find yapılmaz.
+ *
+ * İşçiler yalnızca kendi dizinlerinin doğrudan çocuğu olan kayıtların
+ * marks/seen/sizes elemanlarına yazar; her kayıt tek bir dizine ait
+ * olduğundan kilit gerekmez.
+ *
+ * .vaultignore kuralları dizinle birlikte walker'ın data'sında taşınır.
+ * Yoksayılan alt dizinlere hiç girilmez; içlerindeki izlenen kayıtlar
+ * tarama sonrası tek tek lstat edilir. Untracked cache ham adları tutar
+ * (yoksayma uygulanmadan), böylece .vaultignore değişince eskimez.
+ */
+
+/* Bir dizinin .vaultignore'u; alt dizinler walk bitene kadar paylaşır */
+typedef struct StatusIgnoreFrame {
+    VaultIgnoreStack          stack;
+    VaultIgnore              *rules;
+    struct StatusIgnoreFrame *next;
+} StatusIgnoreFrame;
+
+typedef struct {
+    IndexUntrackedDir *dirs;            /* Yeni untracked cache düğümleri */
+    size_t             dir_count;
+    size_t             dir_cap;
+    char             **untracked;       /* 'A' olarak bildirilecek yollar */
+    size_t             untracked_count;
+    size_t             untracked_cap;
+    size_t             reads;           /* Önbellekten gelmeyen dizin sayısı */
+    StatusIgnoreFrame *ignores;         /* Bu işçinin yüklediği kurallar */
+} StatusWorker;
+
+typedef struct {
+    const VaultIndex *idx;
+    IndexUntrackedDir *old_dirs;        /* idx'in yüklenen untracked cache'i */
+    size_t             old_count;
+    int                use_cache;
+    char              *marks;           /* 0, 'M', 'D' ya da 'h' (hash'lenmeli) */
+    char              *seen;            /* Tarama kaydı lstat etti */
+    uint64_t          *sizes;           /* 'h' kayıtlarının boyutu */
+    StatusWorker      *workers;
+} StatusScan;
+
+/* Adlar tamponu: "ad\0ad/\0..." */
+typedef struct {
+    char  *data;
+    size_t len;
+    size_t cap;
+} NameList;
+
+static int name_list_push(NameList *l, const char *name, size_t name_len, int is_dir){
+    size_t need = l->len + name_len + (is_dir ? 1 : 0) + 1;
+    if (need > l->cap) {
+        size_t cap = l->cap ? l->cap * 2 : 256;
+        while (cap < need)
+            cap *= 2;
+        char *grown = realloc(l->data, cap);
+        if (!grown)
+            return -1;
+        l->data = grown;
+        l->cap = cap;
+    }
+    memcpy(l->data + l->len, name, name_len);
+    l->len += name_len;
+    if (is_dir)
+        l->data[l->len++] = '/';
+    l->data[l->len++] = '\0';
+    return 0;
+}
+
+/* Dizinin düğümünü işçinin önbellek listesine ekler; names'in sahipliğini alır */
+static VaultError status_record_dir(StatusWorker *w, const char *key, const struct stat *st,
+                                    char *names, size_t names_len){
+    if (w->dir_count == w->dir_cap) {
+        size_t cap = w->dir_cap ? w->dir_cap * 2 : 64;
+        IndexUntrackedDir *grown = realloc(w->dirs, cap * sizeof(*grown));
+        if (!grown) {
+            free(names);
+            return VAULT_ERR_NOMEM;
+        }
+        w->dirs = grown;
+        w->dir_cap = cap;
+    }
+    IndexUntrackedDir *d = &w->dirs[w->dir_count];
+    if (!(d->path = strdup(key))) {
+        free(names);
+        return VAULT_ERR_NOMEM;
+    }
+    w->dir_count++;
+    d->mtime      = (long)st->st_mtim.tv_sec;
+    d->mtime_nsec = (long)st->st_mtim.tv_nsec;
+    d->ctime      = (long)st->st_ctim.tv_sec;
+    d->ctime_nsec = (long)st->st_ctim.tv_nsec;
+    d->ino        = (uint64_t)st->st_ino;
+    d->dev        = (uint64_t)st->st_dev;
+    d->names      = names;
+    d->names_len  = names_len;
+    d->valid      = 1;
     return VAULT_OK;
 }
 
-VaultError vault_head_read(char out_hash[VAULT_HASH_HEX_SIZE]){
-    (void)out_hash;
+static VaultError status_push_untracked(StatusWorker *w, const char *path){
+    if (w->untracked_count == w->untracked_cap) {
+        size_t cap = w->untracked_cap ? w->untracked_cap * 2 : 32;
+        char **grown = realloc(w->untracked, cap * sizeof(*grown));
+        if (!grown)
+            return VAULT_ERR_NOMEM;
+        w->untracked = grown;
+        w->untracked_cap = cap;
+    }
+    if (!(w->untracked[w->untracked_count] = strdup(path)))
+        return VAULT_ERR_NOMEM;
+    w->untracked_count++;
     return VAULT_OK;
 }
 
-VaultError vault_head_write(const char hash[VAULT_HASH_HEX_SIZE]){
-    (void)hash;
+/*
+ * dir ("dizin/" ya da "") içindeki .vaultignore'u yükler. Kural varsa yeni
+ * bir çerçeve parent'ın önüne eklenir, yoksa parent geçerli kalır.
+ * Okunamayan dosya kural içermiyor sayılır.
+ */
+static VaultError status_ignore_enter(StatusWorker *w, const char *dir,
+                                      const VaultIgnoreStack *parent,
+                                      const VaultIgnoreStack **out){
+    *out = parent;
+    VaultIgnore *rules;
+    VaultError err = vault_ignore_load(dir, &rules);
+    if (err == VAULT_ERR_IO)
+        return VAULT_OK;
+    if (err != VAULT_OK || !rules)
+        return err;
+
+    StatusIgnoreFrame *frame = malloc(sizeof(*frame));
+    if (!frame) {
+        vault_ignore_free(rules);
+        return VAULT_ERR_NOMEM;
+    }
+    frame->stack.parent = parent;
+    frame->stack.rules = rules;
+    frame->rules = rules;
+    frame->next = w->ignores;
+    w->ignores = frame;
+    *out = &frame->stack;
     return VAULT_OK;
 }
 
-typedef void (*VaultStatusCallback)(const char *filepath, char status,void *ctx);
+/*
+ * Bir dizinin index'teki doğrudan çocuklarını sırayla gezer. Kayıtlar
+ * yola göre sıralı olduğundan dizinin kayıtları ardışıktır; alt dizinlerin
+ * kayıtları tek bir binary search ile atlanır.
+ */
+typedef struct {
+    const VaultIndex *idx;
+    const char       *prefix;       /* "src/" ya da "" */
+    size_t            prefix_len;
+    size_t            pos;
+} ChildCursor;
+
+/* Sıradaki doğrudan çocuğun adı (prefix'ten sonrası); kalmadıysa NULL */
+static const char *child_cursor_peek(ChildCursor *c){
+    while (c->pos < c->idx->count) {
+        const char *path = c->idx->entries[c->pos].filepath;
+        if (strncmp(path, c->prefix, c->prefix_len) != 0)
+            return NULL;
+        const char *rest = path + c->prefix_len;
+        const char *slash = strchr(rest, '/');
+        if (!slash)
+            return rest;
+
+        /* "sub/..." kayıtlarını atla: "sub0" ('/' + 1) ilk büyük yoldur */
+        char next[VAULT_MAX_PATH];
+        size_t len = (size_t)(slash - path);
+        memcpy(next, path, len);
+        next[len] = '/' + 1;
+        next[len + 1] = '\0';
+        int found;
+        c->pos = index_lower_bound(c->idx->entries, c->idx->count, next, &found);
+    }
+    return NULL;
+}
+
+static void child_cursor_init(ChildCursor *c, const VaultIndex *idx, const char *prefix,
+                              size_t prefix_len){
+    int found;
+    c->idx = idx;
+    c->prefix = prefix;
+    c->prefix_len = prefix_len;
+    c->pos = prefix_len ? index_lower_bound(idx->entries, idx->count, prefix, &found) : 0;
+}
+
+/* Önbellekteki adlardan: alt dizinler lstat() edilir, dosyalar edilmez.
+ * path "dizin/" tutar; çocuklar sonuna yazılır. */
+static VaultError status_visit_cached(StatusScan *s, VaultWalk *walk, int worker,
+                                      char *path, size_t len, const char *names,
+                                      size_t names_len, const VaultIgnoreStack *ignore){
+    StatusWorker *w = &s->workers[worker];
+    size_t base = len ? len + 1 : 0;
+    ChildCursor cur;
+    child_cursor_init(&cur, s->idx, path, base);
+
+    /* .vaultignore izlenmiyorsa adlarda, izleniyorsa index'tedir */
+    int has_ignore = 0;
+    for (const char *p = names; !has_ignore && p < names + names_len; p += strlen(p) + 1)
+        has_ignore = strcmp(p, VAULT_IGNORE_FILE) == 0;
+    if (!has_ignore && base + sizeof(VAULT_IGNORE_FILE) <= VAULT_MAX_PATH) {
+        int found;
+        memcpy(path + base, VAULT_IGNORE_FILE, sizeof(VAULT_IGNORE_FILE));
+        index_lower_bound(s->idx->entries, s->idx->count, path, &found);
+        has_ignore = found;
+        path[base] = '\0';
+    }
+    VaultError err = has_ignore ? status_ignore_enter(w, path, ignore, &ignore) : VAULT_OK;
+
+    for (const char *p = names; err == VAULT_OK && p < names + names_len; ) {
+        size_t name_len = strlen(p);
+        int is_dir = name_len > 0 && p[name_len - 1] == '/';
+        size_t base_len = name_len - (is_dir ? 1 : 0);
+        const char *name = p;
+        p += name_len + 1;
+        if (base_len == 0 || len + base_len + 2 > VAULT_MAX_PATH)
+            continue;
+
+        memcpy(path + base, name, base_len);
+        path[base + base_len] = '\0';
+
+        struct stat st;
+        if (!is_dir) {
+            /* Adlar sıralı: index'in çocuklarıyla birleştir */
+            const char *child;
+            int tracked = 0;
+            while ((child = child_cursor_peek(&cur)) != NULL) {
+                int cmp = strcmp(child, path + base);
+                if (cmp > 0)
+                    break;
+                cur.pos++;
+                if (cmp == 0) {
+                    tracked = 1;
+                    break;
+                }
+            }
+            if (!tracked && !vault_ignore_match(ignore, path, 0))
+                err = status_push_untracked(w, path);
+        } else if (vault_ignore_match(ignore, path, 1)) {
+            continue;       /* budanan alt ağaç: lstat bile gerekmez */
+        } else if (lstat(path, &st) == 0 && S_ISDIR(st.st_mode)) {
+            err = vault_walk_push(walk, worker, path, base + base_len, &st, (void *)ignore);
+        } else {
+            w->reads++;     /* dizin değişmeden alt dizini gidemez: önbellek eskimiş */
+        }
+    }
+    return err;
+}
+
+static VaultError status_visit_dir(VaultWalk *walk, int worker, const char *dir_path,
+                                   size_t len, const struct stat *dir_st, void *data,
+                                   void *ctx){
+    StatusScan *s = ctx;
+    const VaultIgnoreStack *ignore = data;
+    StatusWorker *w = &s->workers[worker];
+    if (len + 2 > VAULT_MAX_PATH)
+        return VAULT_OK;    /* altındaki yollar index'e de giremez */
+
+    /* path: "dizin/" (önbellek anahtarı ve index öneki); çocuklar sonuna yazılır */
+    char path[VAULT_MAX_PATH];
+    memcpy(path, dir_path, len);
+    path[len] = '/';
+    path[len ? len + 1 : 0] = '\0';
+
+    if (s->use_cache) {
+        IndexUntrackedDir *old = untracked_dir_find(s->old_dirs, s->old_count, path);
+        if (old && old->valid && untracked_dir_matches(old, dir_st)) {
+            char *names = old->names;
+            size_t names_len = old->names_len;
+            old->names = NULL;      /* her dizin tek bir işçide ziyaret edilir */
+            VaultError err = status_record_dir(w, path, dir_st, names, names_len);
+            if (err == VAULT_OK)
+                err = status_visit_cached(s, walk, worker, path, len, names, names_len,
+                                          ignore);
+            return err;
+        }
+    }
+
+    DIR *dir = opendir(len ? dir_path : ".");
+    if (!dir)
+        return VAULT_ERR_IO;
+    w->reads++;
+
+    char **names = NULL;
+    size_t count = 0, cap = 0;
+    int has_ignore = 0;
+    VaultError err = VAULT_OK;
+    struct dirent *de;
+    while ((de = readdir(dir)) != NULL) {
+        if (strcmp(de->d_name, ".") == 0 || strcmp(de->d_name, "..") == 0 ||
+            (len == 0 && strcmp(de->d_name, VAULT_DIR) == 0))
+            continue;
+        if (strcmp(de->d_name, VAULT_IGNORE_FILE) == 0)
+            has_ignore = 1;
+        if (count == cap) {
+            cap = cap ? cap * 2 : 32;
+            char **grown = realloc(names, cap * sizeof(*names));
+            if (!grown) {
+                err = VAULT_ERR_NOMEM;
+                break;
+            }
+            names = grown;
+        }
+        if (!(names[count] = strdup(de->d_name))) {
+            err = VAULT_ERR_NOMEM;
+            break;
+        }
+        count++;
+    }
+    closedir(dir);
+    qsort(names, count, sizeof(*names), name_cmp);
+    if (err == VAULT_OK && has_ignore)
+        err = status_ignore_enter(w, path, ignore, &ignore);
+
+    ChildCursor cur;
+    child_cursor_init(&cur, s->idx, path, len ? len + 1 : 0);
+    NameList list = { NULL, 0, 0 };
+    for (size_t i = 0; err == VAULT_OK && i < count; i++) {
+        size_t name_len = strlen(names[i]);
+        if (len + name_len + 2 > VAULT_MAX_PATH)
+            continue;   /* VAULT_MAX_PATH'e sığmayan yollar index'e de giremez */
+
+        size_t base = len ? len + 1 : 0;
+        memcpy(path + base, names[i], name_len + 1);
+        struct stat st;
+        int exists = lstat(path, &st) == 0;
+
+        /* Bu addan önce gelen çocuklar diskte yok */
+        const char *child;
+        int pos = -1;
+        while ((child = child_cursor_peek(&cur)) != NULL) {
+            int cmp = strcmp(child, names[i]);
+            if (cmp > 0)
+                break;
+            if (cmp == 0)
+                pos = (int)cur.pos;
+            else
+                s->marks[cur.pos] = 'D';
+            s->seen[cur.pos++] = 1;
+            if (cmp == 0)
+                break;
+        }
+
+        if (pos >= 0) {
+            /* İzlenen yol: stat zaten elde, vault_status'taki kontrolün aynısı */
+            if (!exists || !S_ISREG(st.st_mode)) {
+                s->marks[pos] = 'D';
+            } else {
+                int r = entry_stat_check(s->idx, &s->idx->entries[pos], &st);
+                if (r > 0) {
+                    s->marks[pos] = 'M';
+                } else if (r < 0) {
+                    s->marks[pos] = 'h';
+                    s->sizes[pos] = (uint64_t)st.st_size;
+                }
+            }
+        }
+
+        if (!exists)
+            continue;
+        if (S_ISDIR(st.st_mode)) {
+            if (s->use_cache && name_list_push(&list, names[i], name_len, 1) != 0)
+                err = VAULT_ERR_NOMEM;
+            else if (!vault_ignore_match(ignore, path, 1))
+                err = vault_walk_push(walk, worker, path, base + name_len, &st,
+                                      (void *)ignore);
+        } else if (S_ISREG(st.st_mode) && pos < 0) {
+            if (s->use_cache && name_list_push(&list, names[i], name_len, 0) != 0)
+                err = VAULT_ERR_NOMEM;
+            else if (!vault_ignore_match(ignore, path, 0))
+                err = status_push_untracked(w, path);
+        }
+    }
+
+    /* Son addan sonra kalan çocuklar da diskte yok */
+    for (const char *child; err == VAULT_OK && (child = child_cursor_peek(&cur)) != NULL; ) {
+        s->marks[cur.pos] = 'D';
+        s->seen[cur.pos++] = 1;
+    }
+
+    path[len] = '/';
+    path[len ? len + 1 : 0] = '\0';
+    if (err == VAULT_OK && s->use_cache)
+        err = status_record_dir(w, path, dir_st, list.data, list.len);
+    else
+        free(list.data);
+
+    for (size_t i = 0; i < count; i++)
+        free(names[i]);
+    free(names);
+    return err;
+}
+
+static int path_ptr_cmp(const void *a, const void *b){
+    return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+static int untracked_dir_cmp(const void *a, const void *b){
+    return strcmp(((const IndexUntrackedDir *)a)->path, ((const IndexUntrackedDir *)b)->path);
+}
+
+static void status_workers_free(StatusWorker *workers, int count){
+    for (int i = 0; i < count; i++) {
+        untracked_dirs_free(workers[i].dirs, workers[i].dir_count);
+        for (size_t j = 0; j < workers[i].untracked_count; j++)
+            free(workers[i].untracked[j]);
+        free(workers[i].untracked);
+        while (workers[i].ignores) {
+            StatusIgnoreFrame *next = workers[i].ignores->next;
+            vault_ignore_free(workers[i].ignores->rules);
+            free(workers[i].ignores);
+            workers[i].ignores = next;
+        }
+    }
+    free(workers);
+}
+
+/*
+ * Çalışma dizinini paralel tarar. İşçilerin buldukları birleştirilir:
+ * izlenmeyen yollar sıralanıp *untracked'a, dizin düğümleri sıralanıp
+ * idx'in untracked cache'ine (ziyaret edilmeyen dizinler düşer).
+ */
+static VaultError status_scan(VaultIndex *idx, StatusScan *s, char ***untracked,
+                              size_t *untracked_count){
+    int jobs = vault_walk_jobs(vault_config_get_int("core.walkjobs", 0));
+    s->idx = idx;
+    s->old_dirs = idx->untracked_dirs;
+    s->old_count = idx->untracked_count;
+    s->use_cache = vault_config_get_bool("core.untrackedcache", 1);
+    s->workers = calloc((size_t)jobs, sizeof(*s->workers));
+    if (!s->workers)
+        return VAULT_ERR_NOMEM;
+
+    struct stat root;
+    VaultError err = lstat(".", &root) == 0 ? vault_walk_run(jobs, &root, status_visit_dir, s)
+                                            : VAULT_ERR_IO;
+
+    size_t dir_total = 0, path_total = 0, reads = 0;
+    for (int i = 0; i < jobs; i++) {
+        dir_total += s->workers[i].dir_count;
+        path_total += s->workers[i].untracked_count;
+        reads += s->workers[i].reads;
+    }
+    IndexUntrackedDir *dirs = NULL;
+    char **paths = NULL;
+    if (err == VAULT_OK &&
+        (!(dirs = malloc((dir_total ? dir_total : 1) * sizeof(*dirs))) ||
+         !(paths = malloc((path_total ? path_total : 1) * sizeof(*paths)))))
+        err = VAULT_ERR_NOMEM;
+    if (err != VAULT_OK) {
+        free(dirs);
+        free(paths);
+        status_workers_free(s->workers, jobs);
+        return err;
+    }
+
+    /* Sahiplik işçilerden birleşik dizilere geçer */
+    size_t nd = 0, np = 0;
+    for (int i = 0; i < jobs; i++) {
+        StatusWorker *w = &s->workers[i];
+        memcpy(dirs + nd, w->dirs, w->dir_count * sizeof(*dirs));
+        memcpy(paths + np, w->untracked, w->untracked_count * sizeof(*paths));
+        nd += w->dir_count;
+        np += w->untracked_count;
+        w->dir_count = w->untracked_count = 0;
+    }
+    status_workers_free(s->workers, jobs);
+    qsort(dirs, nd, sizeof(*dirs), untracked_dir_cmp);
+    qsort(paths, np, sizeof(*paths), path_ptr_cmp);
+
+    if (reads > 0 || nd != idx->untracked_count)
+        idx->untracked_changed = 1;
+    untracked_dirs_free(idx->untracked_dirs, idx->untracked_count);
+    idx->untracked_dirs = dirs;
+    idx->untracked_count = nd;
+    *untracked = paths;
+    *untracked_count = np;
+    return VAULT_OK;
+}
+
+/* Yol (ya da '/' ile biten dizin öneki) altındaki kayıtları işaretler */
+static void fsmonitor_touch(const VaultIndex *idx, const char *path, char *check){
+    size_t len = strlen(path);
+    if (len > 0 && path[len - 1] == '/') {
+        int found;
+        size_t i = index_lower_bound(idx->entries, idx->count, path, &found);
+        for (; i < idx->count && strncmp(idx->entries[i].filepath, path, len) == 0; i++)
+            check[i] = 1;
+        len--;      /* dizin aynı addaki bir dosyanın yerini almış olabilir */
+    }
+    char exact[VAULT_MAX_PATH];
+    if (len >= sizeof(exact))
+        return;
+    memcpy(exact, path, len);
+    exact[len] = '\0';
+    int pos = vault_index_find(idx, exact);
+    if (pos >= 0)
+        check[pos] = 1;
+}
+
+/*
+ * Daemon'a index'teki token'dan beri neyin değiştiğini sorar. Dönen dizide
+ * 1 = kayıt incelenmeli; NULL = hepsi incelenmeli. *have_token = 1 ise
+ * idx'te yeni bir token var ve incelenen kayıtların bitleri güncellenmeli.
+ */
+static char *fsmonitor_refresh(VaultIndex *idx, int *have_token){
+    VaultFsmonitorChanges changes;
+    *have_token = 0;
+    if (vault_fsmonitor_query(idx->fsmonitor_token, &changes) != VAULT_OK) {
+        /* Daemon yok: eski token bir sonraki daemon'da zaten tanınmaz */
+        if (idx->fsmonitor_token[0] != '\0') {
+            idx->fsmonitor_token[0] = '\0';
+            idx->fsmonitor_changed = 1;
+        }
+        return NULL;
+    }
+    if (strcmp(idx->fsmonitor_token, changes.token) != 0) {
+        memcpy(idx->fsmonitor_token, changes.token, sizeof(idx->fsmonitor_token));
+        idx->fsmonitor_changed = 1;
+    }
+    *have_token = 1;
+
+    char *check = NULL;
+    if (!changes.full && (check = malloc(idx->count ? idx->count : 1)) != NULL) {
+        for (size_t i = 0; i < idx->count; i++)
+            check[i] = !idx->entries[i].fsmonitor_valid;
+        for (size_t i = 0; i < changes.count; i++)
+            fsmonitor_touch(idx, changes.paths[i], check);
+    }
+    vault_fsmonitor_changes_free(&changes);
+    return check;
+}
+
+VaultError vault_status(VaultIndex *idx,VaultStatusCallback callback,void *user_data){
+    int have_token;
+    char *check = fsmonitor_refresh(idx, &have_token);
+
+    /* Önce her kaydın durumu bulunur, callback'ler sonra yol sırasında */
+    size_t n = idx->count ? idx->count : 1;
+    StatusScan scan;
+    memset(&scan, 0, sizeof(scan));
+    scan.marks = calloc(n, 1);
+    scan.seen = calloc(n, 1);
+    scan.sizes = malloc(n * sizeof(*scan.sizes));
+    HashBatch *batch = malloc(sizeof(*batch));
+    char **untracked = NULL;
+    size_t untracked_count = 0;
+    VaultError err = (scan.marks && scan.seen && scan.sizes && batch) ? VAULT_OK
+                                                                      : VAULT_ERR_NOMEM;
+    if (err == VAULT_OK)
+        err = status_scan(idx, &scan, &untracked, &untracked_count);
+    if (err != VAULT_OK) {
+        free(check);
+        free(scan.marks);
+        free(scan.seen);
+        free(scan.sizes);
+        free(batch);
+        return err;
+    }
+    batch->count = 0;
+
+    char *marks = scan.marks;
+    for (size_t i = 0; i < idx->count; i++) {
+        const IndexEntry *e = &idx->entries[i];
+        uint64_t size = scan.sizes[i];
+
+        /* Tarama görmediyse (dizini önbellekten geldi ya da yok): lstat */
+        if (!scan.seen[i]) {
+            if (check && !check[i])
+                continue;   /* temizdi ve daemon değiştiğini bildirmedi */
+            struct stat st;
+            if (lstat(e->filepath, &st) != 0 || !S_ISREG(st.st_mode)) {
+                marks[i] = 'D';
+                continue;
+            }
+            int r = entry_stat_check(idx, e, &st);
+            if (r > 0)
+                marks[i] = 'M';
+            else if (r < 0)
+                marks[i] = 'h';
+            size = (uint64_t)st.st_size;
+        }
+        if (marks[i] != 'h')
+            continue;
+
+        /* Stat cache yetmedi: içerik hash'lenir */
+        marks[i] = 0;
+        if (size <= VAULT_STATUS_HASH_MAX_FILE) {
+            batch->pos[batch->count] = i;
+            batch->sizes[batch->count++] = (size_t)size;
+            if (batch->count == VAULT_STATUS_HASH_BATCH)
+                hash_batch_flush(idx, batch, marks);
+        } else {
+            VaultOid oid;
+            if (vault_hash_blob_file(e->filepath, &oid) != VAULT_OK ||
+                !vault_oid_equal(&oid, &e->hash))
+                marks[i] = 'M';
+        }
+    }
+    hash_batch_flush(idx, batch, marks);
 
-VaultError vault_status(const VaultIndex *idx,VaultStatusCallback callback,void *user_data){
-    (void)idx;
-    (void)callback;
-    (void)user_data;
+    for (size_t i = 0; i < idx->count; i++) {
+        if (have_token && (!check || check[i] || scan.seen[i]) &&
+            idx->entries[i].fsmonitor_valid != !marks[i]) {
+            idx->entries[i].fsmonitor_valid = !marks[i];
+            idx->fsmonitor_changed = 1;
+        }
+        if (marks[i])
+            callback(idx->entries[i].filepath, marks[i], user_data);
+    }
+    for (size_t i = 0; i < untracked_count; i++) {
+        callback(untracked[i], 'A', user_data);
+        free(untracked[i]);
+    }
+    free(untracked);
+    free(check);
+    free(scan.marks);
+    free(scan.seen);
+    free(scan.sizes);
+    free(batch);
     return VAULT_OK;
 }
 
 void vault_index_free(VaultIndex *idx){
-    (void)idx;
+    for (size_t i = 0; i < idx->count; i++)
+        entry_release(idx, &idx->entries[i]);
+    free(idx->entries);
+    tree_nodes_free(idx->tree_nodes, idx->tree_count);
+    untracked_dirs_free(idx->untracked_dirs, idx->untracked_count);
+    if (idx->map)
+        munmap((void *)idx->map, idx->map_size);
+    memset(idx, 0, sizeof(*idx));
 }
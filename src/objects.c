@@ -1,61 +1,1357 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include "../include/vault_objects.h"
+#include "../include/vault_compress.h"
+#include "../include/vault_fsync.h"
+#include "../include/vault_oidset.h"
+#include "../include/vault_pack.h"
+#include "../include/vault_sha256.h"
+
+#include <dirent.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+/* ---- Dahili yardımcılar ------------------------------------------------- */
+
+static const char *object_type_name(VaultObjectType type){
+    switch (type) {
+    case VAULT_OBJ_BLOB:   return "blob";
+    case VAULT_OBJ_TREE:   return "tree";
+    case VAULT_OBJ_COMMIT: return "commit";
+    }
+    return NULL;
+}
+
+static int object_type_parse(const char *name, size_t len, VaultObjectType *out){
+    if (len == 4 && memcmp(name, "blob", 4) == 0)   { *out = VAULT_OBJ_BLOB;   return 0; }
+    if (len == 4 && memcmp(name, "tree", 4) == 0)   { *out = VAULT_OBJ_TREE;   return 0; }
+    if (len == 6 && memcmp(name, "commit", 6) == 0) { *out = VAULT_OBJ_COMMIT; return 0; }
+    return -1;
+}
+
+/* Hex karakterin değeri + 1; 0 = geçersiz karakter */
+static const uint8_t hex_digit[256] = {
+    ['0'] = 1,  ['1'] = 2,  ['2'] = 3,  ['3'] = 4,  ['4'] = 5,
+    ['5'] = 6,  ['6'] = 7,  ['7'] = 8,  ['8'] = 9,  ['9'] = 10,
+    ['a'] = 11, ['b'] = 12, ['c'] = 13, ['d'] = 14, ['e'] = 15, ['f'] = 16,
+    ['A'] = 11, ['B'] = 12, ['C'] = 13, ['D'] = 14, ['E'] = 15, ['F'] = 16,
+};
+
+static void digest_to_oid(const unsigned char *digest, VaultOid *out_oid){
+    memcpy(out_oid->id, digest, VAULT_HASH_RAW_SIZE);
+}
+
+/* "blob 12\0" gibi nesne başlığını üretir; '\0' dahil uzunluğu döner. */
+static size_t object_header(VaultObjectType type, size_t size, char *buf, size_t buf_size){
+    int n = snprintf(buf, buf_size, "%s %zu", object_type_name(type), size);
+    return (size_t)n + 1;
+}
+
+static VaultError read_whole_file(const char *path, uint8_t **out_data, size_t *out_size){
+    FILE *fp = fopen(path, "rb");
+    if (!fp)
+        return (errno == ENOENT) ? VAULT_ERR_NOTFOUND : VAULT_ERR_IO;
+
+    struct stat st;
+    if (fstat(fileno(fp), &st) != 0) {
+        fclose(fp);
+        return VAULT_ERR_IO;
+    }
+
+    size_t size = (size_t)st.st_size;
+    uint8_t *buf = malloc(size ? size : 1);
+    if (!buf) {
+        fclose(fp);
+        return VAULT_ERR_NOMEM;
+    }
+    if (size && fread(buf, 1, size, fp) != size) {
+        free(buf);
+        fclose(fp);
+        return VAULT_ERR_IO;
+    }
+    fclose(fp);
+
+    *out_data = buf;
+    *out_size = size;
+    return VAULT_OK;
+}
+
+static int write_all(int fd, const uint8_t *buf, size_t len){
+    while (len > 0) {
+        ssize_t n = write(fd, buf, len);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            return -1;
+        }
+        buf += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+/* ---- Hash --------------------------------------------------------------- */
 
 VaultError vault_hash_content(const uint8_t *data, size_t size,
-                              char out_hash[VAULT_HASH_HEX_SIZE]){
-    (void)data;
-    (void)size;
-    (void)out_hash;
+                              VaultOid *out_oid){
+    vault_sha256(data, size, out_oid->id);
+    return VAULT_OK;
+}
+
+/* blob_header: her mesajın önüne "blob <boyut>\0" eklenir */
+static VaultError hash_many(const uint8_t *const *data, const size_t *sizes,
+                            size_t count, int blob_header, VaultOid *out_oids){
+    if (count == 0)
+        return VAULT_OK;
+    VaultSha256 *ctx = malloc(count * sizeof(*ctx));
+    uint8_t (*digests)[VAULT_SHA256_DIGEST_SIZE] = malloc(count * sizeof(*digests));
+    if (!ctx || !digests) {
+        free(ctx);
+        free(digests);
+        return VAULT_ERR_NOMEM;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        vault_sha256_init(&ctx[i]);
+        if (blob_header) {
+            char header[32];
+            size_t header_len = object_header(VAULT_OBJ_BLOB, sizes[i], header, sizeof(header));
+            vault_sha256_update(&ctx[i], header, header_len);
+        }
+    }
+    vault_sha256_final_many(ctx, data, sizes, count, digests);
+    for (size_t i = 0; i < count; i++)
+        digest_to_oid(digests[i], &out_oids[i]);
+
+    free(ctx);
+    free(digests);
     return VAULT_OK;
 }
 
+VaultError vault_hash_content_many(const uint8_t *const *data, const size_t *sizes,
+                                   size_t count, VaultOid *out_oids){
+    return hash_many(data, sizes, count, 0, out_oids);
+}
+
+VaultError vault_hash_blob_many(const uint8_t *const *data, const size_t *sizes,
+                                size_t count, VaultOid *out_oids){
+    return hash_many(data, sizes, count, 1, out_oids);
+}
+
+VaultError vault_hash_blob_file(const char *path, VaultOid *out_oid){
+    FILE *fp = fopen(path, "rb");
+    if (!fp)
+        return (errno == ENOENT) ? VAULT_ERR_NOTFOUND : VAULT_ERR_IO;
+
+    struct stat st;
+    if (fstat(fileno(fp), &st) != 0 || !S_ISREG(st.st_mode)) {
+        fclose(fp);
+        return VAULT_ERR_IO;
+    }
+
+    uint8_t *buf = malloc(VAULT_STREAM_CHUNK);
+    if (!buf) {
+        fclose(fp);
+        return VAULT_ERR_NOMEM;
+    }
+
+    size_t size = (size_t)st.st_size;
+    char header[64];
+    size_t header_len = object_header(VAULT_OBJ_BLOB, size, header, sizeof(header));
+    VaultSha256 md;
+    vault_sha256_init(&md);
+    vault_sha256_update(&md, header, header_len);
+
+    /* Header'daki boyut okunan byte sayısıyla uyuşmalı */
+    VaultError err = VAULT_OK;
+    size_t total = 0, n;
+    while ((n = fread(buf, 1, VAULT_STREAM_CHUNK, fp)) > 0) {
+        total += n;
+        vault_sha256_update(&md, buf, n);
+    }
+    if (ferror(fp) || total != size)
+        err = VAULT_ERR_IO;
+    if (err == VAULT_OK)
+        vault_sha256_final(&md, out_oid->id);
+
+    free(buf);
+    fclose(fp);
+    return err;
+}
+
+/* ---- Hex dönüşümü ------------------------------------------------------ */
+
+VaultError vault_oid_from_hex(const char *hex, VaultOid *out_oid){
+    /* Dallanma yok: geçersiz karakter (değer 0) sonda bir kez kontrol edilir */
+    unsigned bad = 0;
+    for (int i = 0; i < VAULT_HASH_RAW_SIZE; i++) {
+        unsigned hi = hex_digit[(unsigned char)hex[i * 2]];
+        unsigned lo = hex_digit[(unsigned char)hex[i * 2 + 1]];
+        bad |= (hi == 0) | (lo == 0);
+        out_oid->id[i] = (uint8_t)(((hi - 1) << 4) | ((lo - 1) & 0x0f));
+    }
+    return bad ? VAULT_ERR_CORRUPT : VAULT_OK;
+}
+
+/*
+ * 4 byte → 8 hex karakter. 8 nibble bir 64 bit kelimenin byte'larına
+ * dağıtılır ve '0'..'9' / 'a'..'f' eşlemesi hepsine aynı anda uygulanır:
+ * nibble >= 10 ise (n + 6) değerinin 4. biti 1'dir ve 'a' - '0' - 10 = 39
+ * eklenir. Byte'lar 21'i aşmadığı için taşma komşu byte'a geçmez.
+ */
+static void hex_encode4(const uint8_t *in, char *out){
+    uint64_t n = 0;
+    for (int i = 0; i < 4; i++)
+        n |= ((uint64_t)(in[i] >> 4) << (i * 16)) |
+             ((uint64_t)(in[i] & 0x0f) << (i * 16 + 8));
+
+    uint64_t alpha = ((n + 0x0606060606060606ull) >> 4) & 0x0101010101010101ull;
+    n += 0x3030303030303030ull + alpha * 39;
+    for (int i = 0; i < 8; i++)
+        out[i] = (char)(n >> (i * 8));
+}
+
+void vault_oid_to_hex(const VaultOid *oid, char out_hex[VAULT_HASH_HEX_SIZE]){
+    for (int i = 0; i < VAULT_HASH_RAW_SIZE; i += 4)
+        hex_encode4(oid->id + i, out_hex + i * 2);
+    out_hex[VAULT_HASH_HEX_SIZE - 1] = '\0';
+}
+
+void vault_object_path(const VaultOid *oid, char *out_path, size_t out_size){
+    char hex[VAULT_HASH_HEX_SIZE];
+    vault_oid_to_hex(oid, hex);
+    snprintf(out_path, out_size, "%s/%.2s/%s", VAULT_OBJECTS_DIR, hex, hex + 2);
+}
+
+/* Loose nesnenin alt dizini: .vault/objects/<ilk2> */
+static void object_dir(const VaultOid *oid, char *out_path, size_t out_size){
+    char hex[VAULT_HASH_HEX_SIZE];
+    vault_oid_to_hex(oid, hex);
+    snprintf(out_path, out_size, "%s/%.2s", VAULT_OBJECTS_DIR, hex);
+}
+
+/* ---- Yazma -------------------------------------------------------------- */
+
+static void exist_add(const VaultOid *oid);
+
+/* Sıkıştırıcı çıktısını geçici dosyaya yazan sink; ctx = int *fd */
+static VaultError fd_sink(const uint8_t *data, size_t size, void *ctx){
+    return write_all(*(int *)ctx, data, size) == 0 ? VAULT_OK : VAULT_ERR_IO;
+}
+
+/*
+ * Nesnenin codec'ini seçer: repo ayarı, ama sıkıştırılamaz görünen blob'lar
+ * ham saklanır. Tree ve commit metindir, her zaman sıkışır.
+ */
+static void choose_codec(VaultObjectType type, const uint8_t *sample, size_t sample_size,
+                         VaultCompressSettings *out){
+    vault_compress_settings(out);
+    if (type == VAULT_OBJ_BLOB && out->codec != VAULT_CODEC_NONE &&
+        vault_compress_probe(sample, sample_size))
+        out->codec = VAULT_CODEC_NONE;
+}
+
+/* 'V' | codec, ardından sıkıştırılmış başlık + içerik */
+static VaultError write_loose(int fd, const VaultCompressSettings *cs,
+                              const char *header, size_t header_len,
+                              const uint8_t *data, size_t size){
+    const uint8_t magic[2] = { VAULT_LOOSE_MAGIC, (uint8_t)cs->codec };
+    if (write_all(fd, magic, sizeof(magic)) != 0)
+        return VAULT_ERR_IO;
+
+    VaultCompressor *c;
+    VaultError err = vault_compressor_open(&c, cs->codec, cs->level, fd_sink, &fd);
+    if (err != VAULT_OK)
+        return err;
+    err = vault_compressor_write(c, (const uint8_t *)header, header_len);
+    if (err == VAULT_OK)
+        err = vault_compressor_write(c, data, size);
+    if (err == VAULT_OK)
+        err = vault_compressor_finish(c);
+    vault_compressor_free(c);
+    return err;
+}
+
 VaultError vault_object_write(VaultObjectType type,
                               const uint8_t *data, size_t size,
-                              char out_hash[VAULT_HASH_HEX_SIZE]){
-    (void)type;
-    (void)data;
-    (void)size;
-    (void)out_hash;
+                              VaultOid *out_oid){
+    char header[32];
+    size_t header_len = object_header(type, size, header, sizeof(header));
+
+    /* Hash: başlık + içerik */
+    VaultSha256 md;
+    vault_sha256_init(&md);
+    vault_sha256_update(&md, header, header_len);
+    vault_sha256_update(&md, data, size);
+    vault_sha256_final(&md, out_oid->id);
+
+    /* Aynı içerik zaten varsa tekrar yazmaya gerek yok */
+    if (vault_object_exists(out_oid))
+        return VAULT_OK;
+
+    VaultCompressSettings cs;
+    choose_codec(type, data, size, &cs);
+
+    /* Atomik yazma: geçici dosya → rename() */
+    char dir[VAULT_OBJECT_PATH_MAX];
+    char path[VAULT_OBJECT_PATH_MAX];
+    char tmp[VAULT_OBJECT_PATH_MAX];
+    object_dir(out_oid, dir, sizeof(dir));
+    vault_object_path(out_oid, path, sizeof(path));
+    snprintf(tmp, sizeof(tmp), "%.*s/tmp_obj_XXXXXX",
+             (int)(sizeof(tmp) - 16), dir);
+
+    if (mkdir(dir, 0755) != 0 && errno != EEXIST)
+        return VAULT_ERR_IO;
+
+    int fd = mkstemp(tmp);
+    if (fd < 0)
+        return VAULT_ERR_IO;
+
+    VaultError err = write_loose(fd, &cs, header, header_len, data, size);
+    if (err == VAULT_OK)
+        err = vault_fsync_file(fd);
+
+    if (close(fd) != 0 && err == VAULT_OK)
+        err = VAULT_ERR_IO;
+    if (err == VAULT_OK && rename(tmp, path) != 0)
+        err = VAULT_ERR_IO;
+    if (err == VAULT_OK)
+        err = vault_fsync_dir(dir);
+    if (err != VAULT_OK)
+        unlink(tmp);
+    else
+        exist_add(out_oid);
+    return err;
+}
+
+VaultError vault_blob_write(const VaultBlob *blob, VaultOid *out_oid){
+    return vault_object_write(VAULT_OBJ_BLOB, blob->data, blob->size, out_oid);
+}
+
+/* ---- Akış (Streaming) Yazma -------------------------------------------- */
+
+struct VaultObjectStream {
+    VaultSha256      md;
+    VaultCompressor *comp;       /* İlk içerik parçasında açılır (sonda için) */
+    VaultObjectType  type;
+    int              fd;
+    size_t           expected;   /* Başlıkta ilan edilen boyut */
+    size_t           fed;        /* Şu ana kadar beslenen içerik */
+    char             header[32];
+    size_t           header_len;
+    char             tmp_path[VAULT_OBJECT_PATH_MAX];
+};
+
+/*
+ * Codec'i ilk parçaya bakarak seçer, codec başlığını yazar ve nesne
+ * başlığını sıkıştırıcıya verir.
+ */
+static VaultError stream_start(VaultObjectStream *st, const uint8_t *data, size_t size){
+    VaultCompressSettings cs;
+    choose_codec(st->type, data, size, &cs);
+
+    const uint8_t magic[2] = { VAULT_LOOSE_MAGIC, (uint8_t)cs.codec };
+    if (write_all(st->fd, magic, sizeof(magic)) != 0)
+        return VAULT_ERR_IO;
+
+    VaultError err = vault_compressor_open(&st->comp, cs.codec, cs.level, fd_sink, &st->fd);
+    if (err != VAULT_OK)
+        return err;
+    return vault_compressor_write(st->comp, (const uint8_t *)st->header, st->header_len);
+}
+
+void vault_object_stream_abort(VaultObjectStream *stream){
+    if (!stream)
+        return;
+    vault_compressor_free(stream->comp);
+    if (stream->fd >= 0) {
+        close(stream->fd);
+        unlink(stream->tmp_path);
+    }
+    free(stream);
+}
+
+VaultError vault_object_stream_open(VaultObjectStream **out_stream,
+                                    VaultObjectType type, size_t size){
+    VaultObjectStream *st = calloc(1, sizeof(*st));
+    if (!st)
+        return VAULT_ERR_NOMEM;
+    st->fd = -1;
+    st->type = type;
+    st->expected = size;
+
+    /* Hash henüz bilinmediği için geçici dosya objects/ kökünde açılır */
+    snprintf(st->tmp_path, sizeof(st->tmp_path), "%s/tmp_obj_XXXXXX", VAULT_OBJECTS_DIR);
+    st->fd = mkstemp(st->tmp_path);
+    if (st->fd < 0) {
+        vault_object_stream_abort(st);
+        return VAULT_ERR_IO;
+    }
+
+    st->header_len = object_header(type, size, st->header, sizeof(st->header));
+    vault_sha256_init(&st->md);
+    vault_sha256_update(&st->md, st->header, st->header_len);
+
+    *out_stream = st;
+    return VAULT_OK;
+}
+
+VaultError vault_object_stream_write(VaultObjectStream *stream,
+                                     const uint8_t *data, size_t size){
+    if (size > stream->expected - stream->fed)
+        return VAULT_ERR_CORRUPT;
+    if (!stream->comp) {
+        VaultError err = stream_start(stream, data, size);
+        if (err != VAULT_OK)
+            return err;
+    }
+    stream->fed += size;
+    vault_sha256_update(&stream->md, data, size);
+    return vault_compressor_write(stream->comp, data, size);
+}
+
+VaultError vault_object_stream_finish(VaultObjectStream *stream,
+                                      VaultOid *out_oid){
+    VaultError err = VAULT_OK;
+
+    if (stream->fed != stream->expected)
+        err = VAULT_ERR_CORRUPT;
+    if (err == VAULT_OK && !stream->comp)
+        err = stream_start(stream, NULL, 0);
+    if (err == VAULT_OK)
+        err = vault_compressor_finish(stream->comp);
+    if (err == VAULT_OK)
+        err = vault_fsync_file(stream->fd);
+    if (err != VAULT_OK) {
+        vault_object_stream_abort(stream);
+        return err;
+    }
+    vault_sha256_final(&stream->md, out_oid->id);
+
+    int fd = stream->fd;
+    stream->fd = -1;
+    if (close(fd) != 0) {
+        unlink(stream->tmp_path);
+        vault_object_stream_abort(stream);
+        return VAULT_ERR_IO;
+    }
+
+    /* Aynı içerik zaten varsa yazdığımız kopya gereksiz */
+    if (vault_object_exists(out_oid)) {
+        unlink(stream->tmp_path);
+        vault_object_stream_abort(stream);
+        return VAULT_OK;
+    }
+
+    char dir[VAULT_OBJECT_PATH_MAX];
+    char path[VAULT_OBJECT_PATH_MAX];
+    object_dir(out_oid, dir, sizeof(dir));
+    vault_object_path(out_oid, path, sizeof(path));
+
+    if ((mkdir(dir, 0755) != 0 && errno != EEXIST) || rename(stream->tmp_path, path) != 0) {
+        unlink(stream->tmp_path);
+        err = VAULT_ERR_IO;
+    } else if ((err = vault_fsync_dir(dir)) == VAULT_OK) {
+        exist_add(out_oid);
+    }
+    vault_object_stream_abort(stream);
+    return err;
+}
+
+/* ---- Okuma -------------------------------------------------------------- */
+
+/*
+ * Loose dosyanın ilk byte'larından codec'i bulur ve sıkıştırılmış verinin
+ * başladığı ofseti döner. Codec başlığı olmayan dosyalar eski zlib biçimidir.
+ */
+static size_t loose_codec(const uint8_t *data, size_t size, VaultCodec *out_codec){
+    if (size >= 2 && data[0] == VAULT_LOOSE_MAGIC) {
+        *out_codec = (VaultCodec)data[1];
+        return 2;
+    }
+    *out_codec = VAULT_CODEC_ZLIB;
+    return 0;
+}
+
+static VaultError loose_object_read(const VaultOid *oid,
+                                    uint8_t **out_data, size_t *out_size,
+                                    VaultObjectType *out_type){
+    char path[VAULT_OBJECT_PATH_MAX];
+    vault_object_path(oid, path, sizeof(path));
+
+    uint8_t *packed = NULL;
+    size_t packed_size = 0;
+    VaultError err = read_whole_file(path, &packed, &packed_size);
+    if (err != VAULT_OK)
+        return err;
+
+    VaultCodec codec;
+    size_t skip = loose_codec(packed, packed_size, &codec);
+    VaultDecompressor *d;
+    err = vault_decompressor_open(&d, codec);
+    if (err != VAULT_OK) {
+        free(packed);
+        return err;
+    }
+
+    size_t cap = packed_size * 4 + 64;
+    uint8_t *raw = malloc(cap);
+    if (!raw) {
+        vault_decompressor_free(d);
+        free(packed);
+        return VAULT_ERR_NOMEM;
+    }
+
+    const uint8_t *in = packed + skip;
+    size_t in_left = packed_size - skip;
+    size_t raw_size = 0;
+    int done = 0;
+    while (!done) {
+        if (raw_size == cap) {
+            uint8_t *grown = realloc(raw, cap * 2);
+            if (!grown) {
+                err = VAULT_ERR_NOMEM;
+                break;
+            }
+            raw = grown;
+            cap *= 2;
+        }
+        uint8_t *out = raw + raw_size;
+        size_t out_left = cap - raw_size;
+        err = vault_decompressor_run(d, &in, &in_left, &out, &out_left, &done);
+        if (err != VAULT_OK)
+            break;
+        raw_size = cap - out_left;
+
+        /* Girdi bitti, çıktıda yer var ama akış bitmedi: kesik dosya */
+        if (!done && in_left == 0 && raw_size < cap) {
+            err = VAULT_ERR_CORRUPT;
+            break;
+        }
+    }
+    vault_decompressor_free(d);
+    free(packed);
+    if (err != VAULT_OK) {
+        free(raw);
+        return err;
+    }
+
+    /* Başlığı ayrıştır: "<tip> <boyut>\0" */
+    uint8_t *nul = memchr(raw, '\0', raw_size);
+    uint8_t *space = nul ? memchr(raw, ' ', (size_t)(nul - raw)) : NULL;
+    VaultObjectType type;
+    if (!space || object_type_parse((const char *)raw, (size_t)(space - raw), &type) != 0) {
+        free(raw);
+        return VAULT_ERR_CORRUPT;
+    }
+
+    char *end = NULL;
+    unsigned long long declared = strtoull((const char *)space + 1, &end, 10);
+    size_t body_off = (size_t)(nul - raw) + 1;
+    if ((uint8_t *)end != nul || declared != raw_size - body_off) {
+        free(raw);
+        return VAULT_ERR_CORRUPT;
+    }
+
+    /* İçeriği ayrı bir buffer'a taşı; metin işleyenler için sonuna '\0' */
+    uint8_t *body = malloc(raw_size - body_off + 1);
+    if (!body) {
+        free(raw);
+        return VAULT_ERR_NOMEM;
+    }
+    memcpy(body, raw + body_off, raw_size - body_off);
+    body[raw_size - body_off] = '\0';
+    free(raw);
+
+    *out_data = body;
+    *out_size = (size_t)declared;
+    *out_type = type;
     return VAULT_OK;
 }
 
-VaultError vault_object_read(const char hash[VAULT_HASH_HEX_SIZE],
+/* Yalnızca "<tip> <boyut>\0" başlığı açılır; dosyanın geri kalanı okunmaz */
+static VaultError loose_object_size(const VaultOid *oid,
+                                    size_t *out_size, VaultObjectType *out_type){
+    char path[VAULT_OBJECT_PATH_MAX];
+    vault_object_path(oid, path, sizeof(path));
+
+    FILE *fp = fopen(path, "rb");
+    if (!fp)
+        return (errno == ENOENT) ? VAULT_ERR_NOTFOUND : VAULT_ERR_IO;
+
+    uint8_t in[512];
+    size_t n = fread(in, 1, sizeof(in), fp);
+    VaultCodec codec;
+    size_t skip = loose_codec(in, n, &codec);
+    VaultDecompressor *d;
+    VaultError err = vault_decompressor_open(&d, codec);
+    if (err != VAULT_OK) {
+        fclose(fp);
+        return err;
+    }
+
+    char header[64];
+    const uint8_t *ip = in + skip;
+    size_t in_left = n - skip;
+    uint8_t *op = (uint8_t *)header;
+    size_t out_left = sizeof(header);
+    uint8_t *nul = NULL;
+    int done = 0;
+    while (!nul && !done && out_left > 0) {
+        if (in_left == 0) {
+            n = fread(in, 1, sizeof(in), fp);
+            if (n == 0)
+                break;
+            ip = in;
+            in_left = n;
+        }
+        err = vault_decompressor_run(d, &ip, &in_left, &op, &out_left, &done);
+        if (err != VAULT_OK)
+            break;
+        nul = memchr(header, '\0', sizeof(header) - out_left);
+    }
+    vault_decompressor_free(d);
+    fclose(fp);
+    if (!nul)
+        return err != VAULT_OK ? err : VAULT_ERR_CORRUPT;
+
+    char *space = memchr(header, ' ', (size_t)((char *)nul - header));
+    VaultObjectType type;
+    if (!space || object_type_parse(header, (size_t)(space - header), &type) != 0)
+        return VAULT_ERR_CORRUPT;
+
+    char *end = NULL;
+    unsigned long long declared = strtoull(space + 1, &end, 10);
+    if ((uint8_t *)end != nul)
+        return VAULT_ERR_CORRUPT;
+
+    *out_size = (size_t)declared;
+    *out_type = type;
+    return VAULT_OK;
+}
+
+/* Başlık küçük bir buffer'a, gövde VAULT_STREAM_CHUNK'lık parçalarla fd'ye */
+static VaultError loose_object_read_fd(const VaultOid *oid, VaultObjectType type, int fd){
+    char path[VAULT_OBJECT_PATH_MAX];
+    vault_object_path(oid, path, sizeof(path));
+
+    FILE *fp = fopen(path, "rb");
+    if (!fp)
+        return (errno == ENOENT) ? VAULT_ERR_NOTFOUND : VAULT_ERR_IO;
+
+    uint8_t *in = malloc(2 * VAULT_STREAM_CHUNK);
+    if (!in) {
+        fclose(fp);
+        return VAULT_ERR_NOMEM;
+    }
+    uint8_t *buf = in + VAULT_STREAM_CHUNK;
+    size_t n = fread(in, 1, VAULT_STREAM_CHUNK, fp);
+    VaultCodec codec;
+    size_t skip = loose_codec(in, n, &codec);
+    VaultDecompressor *d;
+    VaultError err = vault_decompressor_open(&d, codec);
+    if (err != VAULT_OK) {
+        free(in);
+        fclose(fp);
+        return err;
+    }
+
+    /* header'a başlık ve gövdenin ilk byte'ları düşebilir */
+    char header[64];
+    const uint8_t *ip = in + skip;
+    size_t in_left = n - skip;
+    uint8_t *op = (uint8_t *)header;
+    size_t out_left = sizeof(header);
+    uint8_t *nul = NULL;
+    uint64_t declared = 0, written = 0;
+    int done = 0, out_full = 0;
+    for (;;) {
+        /* Çıktı dolduysa codec'te bekleyen çıktı olabilir: önce o alınır */
+        if (in_left == 0 && !out_full) {
+            n = fread(in, 1, VAULT_STREAM_CHUNK, fp);
+            if (n == 0) {
+                /* Ham codec'te akış dosyayla biter; diğerlerinde kesik dosya */
+                if (codec != VAULT_CODEC_NONE || !nul)
+                    err = VAULT_ERR_CORRUPT;
+                break;
+            }
+            ip = in;
+            in_left = n;
+        }
+        err = vault_decompressor_run(d, &ip, &in_left, &op, &out_left, &done);
+        if (err != VAULT_OK)
+            break;
+        if (codec == VAULT_CODEC_NONE)
+            done = 0;       /* "girdi bitti" yalnızca bu parça için */
+        out_full = out_left == 0;
+
+        const uint8_t *body;
+        size_t body_len;
+        if (!nul) {
+            size_t produced = sizeof(header) - out_left;
+            if (!(nul = memchr(header, '\0', produced))) {
+                if (done || out_left == 0) {
+                    err = VAULT_ERR_CORRUPT;
+                    break;
+                }
+                continue;
+            }
+            char *space = memchr(header, ' ', (size_t)((char *)nul - header));
+            VaultObjectType got;
+            char *end = NULL;
+            if (!space || object_type_parse(header, (size_t)(space - header), &got) != 0 ||
+                (declared = strtoull(space + 1, &end, 10), (uint8_t *)end != nul)) {
+                err = VAULT_ERR_CORRUPT;
+                break;
+            }
+            if (got != type) {
+                err = VAULT_ERR_CORRUPT;
+                break;
+            }
+            body = nul + 1;
+            body_len = produced - (size_t)(nul + 1 - (uint8_t *)header);
+        } else {
+            body = buf;
+            body_len = VAULT_STREAM_CHUNK - out_left;
+        }
+
+        written += body_len;
+        if (written > declared) {
+            err = VAULT_ERR_CORRUPT;
+            break;
+        }
+        if (write_all(fd, body, body_len) != 0) {
+            err = VAULT_ERR_IO;
+            break;
+        }
+        if (done)
+            break;
+        op = buf;
+        out_left = VAULT_STREAM_CHUNK;
+    }
+    vault_decompressor_free(d);
+    free(in);
+    fclose(fp);
+    if (err == VAULT_OK && written != declared)
+        err = VAULT_ERR_CORRUPT;
+    return err;
+}
+
+VaultError vault_object_read_fd(const VaultOid *oid, VaultObjectType type, int fd){
+    VaultError err = vault_pack_read_fd(oid, type, fd);
+    if (err != VAULT_ERR_NOTFOUND)
+        return err;
+    return loose_object_read_fd(oid, type, fd);
+}
+
+/* Cache'e bakmadan: önce pack'ler, sonra loose nesneler */
+static VaultError storage_read(const VaultOid *oid,
+                               uint8_t **out_data, size_t *out_size,
+                               VaultObjectType *out_type){
+    VaultError err = vault_pack_read(oid, out_data, out_size, out_type);
+    if (err != VAULT_ERR_NOTFOUND)
+        return err;
+    return loose_object_read(oid, out_data, out_size, out_type);
+}
+
+static int cache_copy(const VaultOid *oid, uint8_t **out_data, size_t *out_size,
+                      VaultObjectType *out_type);
+
+VaultError vault_object_read(const VaultOid *oid,
                              uint8_t **out_data, size_t *out_size,
                              VaultObjectType *out_type){
-    (void)hash;
-    (void)out_data;
-    (void)out_size;
-    (void)out_type;
+    if (cache_copy(oid, out_data, out_size, out_type) == 0)
+        return VAULT_OK;
+    return storage_read(oid, out_data, out_size, out_type);
+}
+
+static int is_hex_name(const char *s, size_t len){
+    if (strlen(s) != len)
+        return 0;
+    for (size_t i = 0; i < len; i++)
+        if (!((s[i] >= '0' && s[i] <= '9') || (s[i] >= 'a' && s[i] <= 'f')))
+            return 0;
+    return 1;
+}
+
+/*
+ * Tek bir fan-out dizinindeki (ör. "ab") loose nesneleri bildirir. Dizin
+ * açılamazsa VAULT_ERR_IO; errno korunur (ENOENT = o önekte nesne yok).
+ */
+static VaultError loose_dir_foreach(const char *prefix, VaultOidCallback fn, void *ctx){
+    char dir_path[VAULT_OBJECT_PATH_MAX];
+    snprintf(dir_path, sizeof(dir_path), "%s/%.2s", VAULT_OBJECTS_DIR, prefix);
+    DIR *sub = opendir(dir_path);
+    if (!sub)
+        return VAULT_ERR_IO;
+
+    VaultError err = VAULT_OK;
+    struct dirent *fe;
+    while (err == VAULT_OK && (fe = readdir(sub)) != NULL) {
+        if (!is_hex_name(fe->d_name, VAULT_HASH_HEX_SIZE - 3))
+            continue;
+
+        char hex[VAULT_HASH_HEX_SIZE];
+        VaultOid oid;
+        snprintf(hex, sizeof(hex), "%.2s%.62s", prefix, fe->d_name);
+        if (vault_oid_from_hex(hex, &oid) == VAULT_OK)
+            err = fn(&oid, ctx);
+    }
+    closedir(sub);
+    return err;
+}
+
+VaultError vault_object_foreach_loose(VaultOidCallback fn, void *ctx){
+    DIR *root = opendir(VAULT_OBJECTS_DIR);
+    if (!root)
+        return VAULT_ERR_IO;
+
+    VaultError err = VAULT_OK;
+    struct dirent *de;
+    while (err == VAULT_OK && (de = readdir(root)) != NULL) {
+        if (!is_hex_name(de->d_name, 2))
+            continue;
+        /* Açılamayan dizin atlanır */
+        VaultError derr = loose_dir_foreach(de->d_name, fn, ctx);
+        if (derr != VAULT_ERR_IO)
+            err = derr;
+    }
+    closedir(root);
+    return err;
+}
+
+/* ---- Varlık kümesi ------------------------------------------------------ */
+
+/*
+ * Süreç boyunca bilinen oid'ler (bkz. vault_oidset.h). Pack index'leri ilk
+ * sorguda bir kez yüklenir. Loose nesneler ise fan-out dizini başına,
+ * o önekle ilk sorgu geldiğinde tek bir readdir ile eklenir (git'in loose
+ * nesne cache'i gibi): tek nesnelik bir komut tüm objects dizinini taramaz,
+ * "yok" cevabı en fazla bir dizin okumasıdır. vault add iş parçacıkları
+ * aynı anda sorgular, yazdıkları nesneleri ekler.
+ */
+static pthread_once_t   exist_once = PTHREAD_ONCE_INIT;
+static pthread_rwlock_t exist_lock = PTHREAD_RWLOCK_INITIALIZER;
+static VaultOidSet      exist_set;
+static int              exist_ready;        /* Pack'ler yüklendi, küme güvenilir */
+static uint8_t          exist_loose[256];   /* Fan-out dizini kümeye okundu mu */
+
+typedef struct {
+    VaultOid *ids;
+    size_t    count;
+    size_t    capacity;
+} OidList;
+
+static VaultError oid_list_push(const VaultOid *oid, void *ctx){
+    OidList *list = ctx;
+    if (list->count == list->capacity) {
+        size_t cap = list->capacity ? list->capacity * 2 : 1024;
+        VaultOid *grown = realloc(list->ids, cap * sizeof(*grown));
+        if (!grown)
+            return VAULT_ERR_NOMEM;
+        list->ids = grown;
+        list->capacity = cap;
+    }
+    list->ids[list->count++] = *oid;
     return VAULT_OK;
 }
 
-int vault_object_exists(const char hash[VAULT_HASH_HEX_SIZE]){
-    (void)hash;
+static void exist_load(void){
+    OidList list = { NULL, 0, 0 };
+    if (vault_pack_foreach_oid(oid_list_push, &list) != VAULT_OK) {
+        free(list.ids);
+        return;
+    }
+    exist_ready = vault_oidset_build(&exist_set, list.ids, list.count) == VAULT_OK;
+}
+
+static VaultError exist_set_add(const VaultOid *oid, void *ctx){
+    (void)ctx;
+    return vault_oidset_add(&exist_set, oid);
+}
+
+/*
+ * oid'in fan-out dizinini kümeye okur; exist_lock yazma kipinde tutulmalı.
+ * 0 = dizin artık kümede (yoksa boş sayılır), -1 = okunamadı.
+ */
+static int exist_load_loose(const VaultOid *oid){
+    uint8_t fan = oid->id[0];
+    if (exist_loose[fan])
+        return 0;
+
+    char hex[VAULT_HASH_HEX_SIZE];
+    vault_oid_to_hex(oid, hex);
+    VaultError err = loose_dir_foreach(hex, exist_set_add, NULL);
+    if (err == VAULT_ERR_IO && errno == ENOENT)
+        err = VAULT_OK;
+    if (err == VAULT_ERR_NOMEM)
+        exist_ready = 0;    /* Küme yarım eklendi: artık güvenilmez */
+    if (err != VAULT_OK)
+        return -1;
+    exist_loose[fan] = 1;
     return 0;
 }
 
-VaultError vault_blob_write(const VaultBlob *blob,
-                            char out_hash[VAULT_HASH_HEX_SIZE]){
-    (void)blob;
-    (void)out_hash;
+/* Bu süreçte yazılan nesne: sonraki sorgular diske gitmesin */
+static void exist_add(const VaultOid *oid){
+    pthread_once(&exist_once, exist_load);
+    if (!exist_ready)
+        return;
+    pthread_rwlock_wrlock(&exist_lock);
+    /* Eklenemezse küme eksik kalır; "yok" cevapları artık güvenilmez */
+    if (vault_oidset_add(&exist_set, oid) != VAULT_OK)
+        exist_ready = 0;
+    pthread_rwlock_unlock(&exist_lock);
+}
+
+int vault_object_exists(const VaultOid *oid){
+    pthread_once(&exist_once, exist_load);
+
+    pthread_rwlock_rdlock(&exist_lock);
+    int ready = exist_ready;
+    int known = ready && vault_oidset_contains(&exist_set, oid);
+    int loaded = exist_loose[oid->id[0]];
+    pthread_rwlock_unlock(&exist_lock);
+    if (known)
+        return 1;
+    if (ready && loaded)
+        return 0;
+
+    if (ready) {
+        /* Öneki ilk kez soruluyor: dizini bir kez oku, sonra kesin cevap */
+        pthread_rwlock_wrlock(&exist_lock);
+        int ok = exist_ready && exist_load_loose(oid) == 0;
+        known = ok && vault_oidset_contains(&exist_set, oid);
+        pthread_rwlock_unlock(&exist_lock);
+        if (ok)
+            return known;
+    }
+
+    if (vault_pack_contains(oid))
+        return 1;
+
+    char path[VAULT_OBJECT_PATH_MAX];
+    vault_object_path(oid, path, sizeof(path));
+    return access(path, F_OK) == 0;
+}
+
+VaultError vault_object_size(const VaultOid *oid,
+                             size_t *out_size, VaultObjectType *out_type){
+    VaultError err = vault_pack_object_size(oid, out_size, out_type);
+    if (err != VAULT_ERR_NOTFOUND)
+        return err;
+    return loose_object_size(oid, out_size, out_type);
+}
+
+/* ---- Nesne cache'i ------------------------------------------------------ */
+
+/*
+ * Hash tablosu (zincirleme) + çift bağlı LRU listesi. Baş en son kullanılan,
+ * kuyruk ilk atılacak olandır. refs > 0 olan girişler atılmaz.
+ */
+struct VaultCacheEntry {
+    VaultOid         oid;
+    uint8_t         *data;
+    size_t           size;
+    VaultObjectType  type;
+    unsigned         refs;
+    int              detached;      /* Tabloda değil: son release free eder */
+    VaultCacheEntry *lru_prev;
+    VaultCacheEntry *lru_next;
+    VaultCacheEntry *hash_next;
+};
+
+static pthread_mutex_t   cache_lock = PTHREAD_MUTEX_INITIALIZER;
+static VaultCacheEntry **cache_buckets;
+static size_t            cache_bucket_count;
+static VaultCacheEntry  *cache_head;
+static VaultCacheEntry  *cache_tail;
+static size_t            cache_limit = VAULT_OBJECT_CACHE_DEFAULT_LIMIT;
+static size_t            cache_bytes;
+static size_t            cache_count;
+static uint64_t          cache_hits;
+static uint64_t          cache_misses;
+static uint64_t          cache_evictions;
+
+static VaultCacheEntry **cache_slot(const VaultOid *oid){
+    VaultCacheEntry **slot = &cache_buckets[vault_oid_hash(oid) & (cache_bucket_count - 1)];
+    while (*slot && !vault_oid_equal(&(*slot)->oid, oid))
+        slot = &(*slot)->hash_next;
+    return slot;
+}
+
+static VaultCacheEntry *cache_find(const VaultOid *oid){
+    return cache_bucket_count ? *cache_slot(oid) : NULL;
+}
+
+static void lru_unlink(VaultCacheEntry *e){
+    if (e->lru_prev) e->lru_prev->lru_next = e->lru_next; else cache_head = e->lru_next;
+    if (e->lru_next) e->lru_next->lru_prev = e->lru_prev; else cache_tail = e->lru_prev;
+    e->lru_prev = e->lru_next = NULL;
+}
+
+static void lru_push_front(VaultCacheEntry *e){
+    e->lru_prev = NULL;
+    e->lru_next = cache_head;
+    if (cache_head)
+        cache_head->lru_prev = e;
+    cache_head = e;
+    if (!cache_tail)
+        cache_tail = e;
+}
+
+/* Girişi tablodan ve LRU listesinden çıkarır (belleği serbest bırakmaz) */
+static void cache_detach(VaultCacheEntry *e){
+    VaultCacheEntry **slot = cache_slot(&e->oid);
+    *slot = e->hash_next;
+    e->hash_next = NULL;
+    lru_unlink(e);
+    cache_bytes -= e->size;
+    cache_count--;
+    e->detached = 1;
+}
+
+static void cache_entry_free(VaultCacheEntry *e){
+    free(e->data);
+    free(e);
+}
+
+/* Bütçeye inene kadar kullanılmayan en eski girişleri atar */
+static void cache_evict(size_t limit){
+    VaultCacheEntry *e = cache_tail;
+    while (e && cache_bytes > limit) {
+        VaultCacheEntry *prev = e->lru_prev;
+        if (e->refs == 0) {
+            cache_detach(e);
+            cache_entry_free(e);
+            cache_evictions++;
+        }
+        e = prev;
+    }
+}
+
+/* Kova sayısını nesne sayısının üstünde tutar; başarısızlık zararsızdır */
+static void cache_grow(void){
+    if (cache_count < cache_bucket_count)
+        return;
+    size_t n = cache_bucket_count ? cache_bucket_count * 2 : 256;
+    VaultCacheEntry **grown = calloc(n, sizeof(*grown));
+    if (!grown)
+        return;
+    for (size_t i = 0; i < cache_bucket_count; i++) {
+        VaultCacheEntry *e = cache_buckets[i];
+        while (e) {
+            VaultCacheEntry *next = e->hash_next;
+            size_t b = vault_oid_hash(&e->oid) & (n - 1);
+            e->hash_next = grown[b];
+            grown[b] = e;
+            e = next;
+        }
+    }
+    free(cache_buckets);
+    cache_buckets = grown;
+    cache_bucket_count = n;
+}
+
+static void view_fill(VaultObjectView *view, VaultCacheEntry *e){
+    view->data  = e->data;
+    view->size  = e->size;
+    view->type  = e->type;
+    view->entry = e;
+}
+
+/*
+ * vault_object_read için: cache'te varsa kopyasını verir. 0 = bulundu.
+ * İsabet ve ıskalar vault_object_view'dakiyle aynı sayılır; isabet eden
+ * giriş LRU'nun başına taşınır. Iskada nesne cache'e eklenmez.
+ */
+static int cache_copy(const VaultOid *oid, uint8_t **out_data, size_t *out_size,
+                      VaultObjectType *out_type){
+    pthread_mutex_lock(&cache_lock);
+    VaultCacheEntry *e = cache_find(oid);
+    uint8_t *copy = e ? malloc(e->size + 1) : NULL;
+    if (copy) {
+        memcpy(copy, e->data, e->size + 1);
+        *out_data = copy;
+        *out_size = e->size;
+        *out_type = e->type;
+        lru_unlink(e);
+        lru_push_front(e);
+        cache_hits++;
+    } else if (!e) {
+        cache_misses++;
+    }
+    pthread_mutex_unlock(&cache_lock);
+    return copy ? 0 : -1;
+}
+
+VaultError vault_object_view(const VaultOid *oid, VaultObjectView *out_view){
+    pthread_mutex_lock(&cache_lock);
+    VaultCacheEntry *e = cache_find(oid);
+    if (e) {
+        e->refs++;
+        lru_unlink(e);
+        lru_push_front(e);
+        cache_hits++;
+        view_fill(out_view, e);
+        pthread_mutex_unlock(&cache_lock);
+        return VAULT_OK;
+    }
+    cache_misses++;
+    pthread_mutex_unlock(&cache_lock);
+
+    /* Okuma (açma) kilidin dışında yapılır */
+    VaultCacheEntry *fresh = calloc(1, sizeof(*fresh));
+    if (!fresh)
+        return VAULT_ERR_NOMEM;
+    VaultError err = storage_read(oid, &fresh->data, &fresh->size, &fresh->type);
+    if (err != VAULT_OK) {
+        free(fresh);
+        return err;
+    }
+    fresh->oid  = *oid;
+    fresh->refs = 1;
+
+    pthread_mutex_lock(&cache_lock);
+    if ((e = cache_find(oid)) != NULL) {
+        /* Bu arada başka bir iş parçacığı eklemiş: onunkini kullan */
+        e->refs++;
+        view_fill(out_view, e);
+        pthread_mutex_unlock(&cache_lock);
+        cache_entry_free(fresh);
+        return VAULT_OK;
+    }
+    if (fresh->size > cache_limit) {
+        fresh->detached = 1;
+    } else {
+        cache_grow();
+        if (cache_bucket_count) {
+            VaultCacheEntry **slot = cache_slot(oid);
+            *slot = fresh;
+            lru_push_front(fresh);
+            cache_bytes += fresh->size;
+            cache_count++;
+            cache_evict(cache_limit);
+        } else {
+            fresh->detached = 1;
+        }
+    }
+    view_fill(out_view, fresh);
+    pthread_mutex_unlock(&cache_lock);
     return VAULT_OK;
 }
 
+void vault_object_view_release(VaultObjectView *view){
+    VaultCacheEntry *e = view->entry;
+    if (!e)
+        return;
+
+    pthread_mutex_lock(&cache_lock);
+    if (--e->refs == 0) {
+        if (e->detached)
+            cache_entry_free(e);
+        else if (cache_bytes > cache_limit)
+            cache_evict(cache_limit);
+    }
+    pthread_mutex_unlock(&cache_lock);
+    memset(view, 0, sizeof(*view));
+}
+
+void vault_object_cache_set_limit(size_t bytes){
+    pthread_mutex_lock(&cache_lock);
+    cache_limit = bytes;
+    cache_evict(cache_limit);
+    pthread_mutex_unlock(&cache_lock);
+}
+
+void vault_object_cache_stats(VaultObjectCacheStats *out_stats){
+    pthread_mutex_lock(&cache_lock);
+    out_stats->hits      = cache_hits;
+    out_stats->misses    = cache_misses;
+    out_stats->evictions = cache_evictions;
+    out_stats->bytes     = cache_bytes;
+    out_stats->count     = cache_count;
+    out_stats->limit     = cache_limit;
+    pthread_mutex_unlock(&cache_lock);
+}
+
+void vault_object_cache_clear(void){
+    pthread_mutex_lock(&cache_lock);
+    VaultCacheEntry *e = cache_head;
+    while (e) {
+        VaultCacheEntry *next = e->lru_next;
+        cache_detach(e);
+        if (e->refs == 0)
+            cache_entry_free(e);
+        e = next;
+    }
+    cache_hits = cache_misses = cache_evictions = 0;
+    pthread_mutex_unlock(&cache_lock);
+}
+
+/* ---- Tree serileştirme -------------------------------------------------- */
+
 VaultError vault_tree_serialize(const VaultTree *tree,
                                 uint8_t **out_data, size_t *out_size){
-    (void)tree;
-    (void)out_data;
-    (void)out_size;
+    size_t cap = 1;
+    for (size_t i = 0; i < tree->count; i++)
+        cap += strlen(tree->entries[i].mode) + strlen(tree->entries[i].name)
+             + VAULT_HASH_HEX_SIZE + 2;
+
+    char *buf = malloc(cap);
+    if (!buf)
+        return VAULT_ERR_NOMEM;
+
+    size_t len = 0;
+    for (size_t i = 0; i < tree->count; i++) {
+        const VaultTreeEntry *e = &tree->entries[i];
+        char hex[VAULT_HASH_HEX_SIZE];
+        vault_oid_to_hex(&e->hash, hex);
+        len += (size_t)snprintf(buf + len, cap - len, "%s %s %s\n",
+                                e->mode, hex, e->name);
+    }
+
+    *out_data = (uint8_t *)buf;
+    *out_size = len;
     return VAULT_OK;
 }
 
 VaultError vault_tree_deserialize(const uint8_t *data, size_t size,
                                   VaultTree *out_tree){
-    (void)data;
-    (void)size;
-    (void)out_tree;
+    out_tree->entries  = NULL;
+    out_tree->count    = 0;
+    out_tree->capacity = 0;
+
+    const char *p   = (const char *)data;
+    const char *end = p + size;
+    while (p < end) {
+        const char *nl = memchr(p, '\n', (size_t)(end - p));
+        if (!nl)
+            nl = end;
+
+        const char *sp1 = memchr(p, ' ', (size_t)(nl - p));
+        const char *sp2 = sp1 ? memchr(sp1 + 1, ' ', (size_t)(nl - sp1 - 1)) : NULL;
+        if (!sp2 || (size_t)(sp1 - p) >= sizeof(out_tree->entries[0].mode) ||
+            sp2 - sp1 - 1 != VAULT_HASH_HEX_SIZE - 1 ||
+            (size_t)(nl - sp2 - 1) >= sizeof(out_tree->entries[0].name)) {
+            vault_tree_free(out_tree);
+            return VAULT_ERR_CORRUPT;
+        }
+
+        if (out_tree->count == out_tree->capacity) {
+            size_t cap = out_tree->capacity ? out_tree->capacity * 2 : 16;
+            VaultTreeEntry *grown = realloc(out_tree->entries, cap * sizeof(*grown));
+            if (!grown) {
+                vault_tree_free(out_tree);
+                return VAULT_ERR_NOMEM;
+            }
+            out_tree->entries  = grown;
+            out_tree->capacity = cap;
+        }
+
+        VaultTreeEntry *e = &out_tree->entries[out_tree->count++];
+        memcpy(e->mode, p, (size_t)(sp1 - p));
+        e->mode[sp1 - p] = '\0';
+        if (vault_oid_from_hex(sp1 + 1, &e->hash) != VAULT_OK) {
+            vault_tree_free(out_tree);
+            return VAULT_ERR_CORRUPT;
+        }
+        memcpy(e->name, sp2 + 1, (size_t)(nl - sp2 - 1));
+        e->name[nl - sp2 - 1] = '\0';
+
+        p = nl + 1;
+    }
+    return VAULT_OK;
+}
+
+/* ---- Commit serileştirme ------------------------------------------------ */
+
+VaultError vault_commit_serialize(const VaultCommit *commit,
+                                  uint8_t **out_data, size_t *out_size){
+    size_t cap = 2 * VAULT_HASH_HEX_SIZE + sizeof(commit->author)
+               + sizeof(commit->message) + 64;
+    char *buf = malloc(cap);
+    if (!buf)
+        return VAULT_ERR_NOMEM;
+
+    char hex[VAULT_HASH_HEX_SIZE];
+    vault_oid_to_hex(&commit->tree_hash, hex);
+    size_t len = (size_t)snprintf(buf, cap, "tree %s\n", hex);
+    if (!vault_oid_is_null(&commit->parent_hash)) {
+        vault_oid_to_hex(&commit->parent_hash, hex);
+        len += (size_t)snprintf(buf + len, cap - len, "parent %s\n", hex);
+    }
+    len += (size_t)snprintf(buf + len, cap - len, "author %s %ld\n\n%s",
+                            commit->author, commit->timestamp, commit->message);
+
+    *out_data = (uint8_t *)buf;
+    *out_size = len;
     return VAULT_OK;
 }
 
+VaultError vault_commit_deserialize(const uint8_t *data, size_t size,
+                                    VaultCommit *out_commit){
+    memset(out_commit, 0, sizeof(*out_commit));
+
+    const char *p   = (const char *)data;
+    const char *end = p + size;
+    int have_tree = 0;
+
+    while (p < end) {
+        const char *nl = memchr(p, '\n', (size_t)(end - p));
+        if (!nl)
+            return VAULT_ERR_CORRUPT;
+        size_t len = (size_t)(nl - p);
+
+        if (len == 0) {
+            /* Boş satır: başlık bitti, geri kalanı mesaj */
+            size_t msg_len = (size_t)(end - nl - 1);
+            if (msg_len >= sizeof(out_commit->message))
+                msg_len = sizeof(out_commit->message) - 1;
+            memcpy(out_commit->message, nl + 1, msg_len);
+            out_commit->message[msg_len] = '\0';
+            return have_tree ? VAULT_OK : VAULT_ERR_CORRUPT;
+        }
+
+        if (len == 5 + VAULT_HASH_HEX_SIZE - 1 && memcmp(p, "tree ", 5) == 0) {
+            if (vault_oid_from_hex(p + 5, &out_commit->tree_hash) != VAULT_OK)
+                return VAULT_ERR_CORRUPT;
+            have_tree = 1;
+        } else if (len == 7 + VAULT_HASH_HEX_SIZE - 1 && memcmp(p, "parent ", 7) == 0) {
+            if (vault_oid_from_hex(p + 7, &out_commit->parent_hash) != VAULT_OK)
+                return VAULT_ERR_CORRUPT;
+        } else if (len > 7 && memcmp(p, "author ", 7) == 0) {
+            /* Yazar adı boşluk içerebilir; zaman damgası son kelimedir */
+            const char *sp = nl;
+            while (sp > p + 7 && sp[-1] != ' ')
+                sp--;
+            if (sp <= p + 7)
+                return VAULT_ERR_CORRUPT;
+            size_t author_len = (size_t)(sp - 1 - (p + 7));
+            if (author_len >= sizeof(out_commit->author))
+                author_len = sizeof(out_commit->author) - 1;
+            memcpy(out_commit->author, p + 7, author_len);
+            out_commit->author[author_len] = '\0';
+            out_commit->timestamp = strtol(sp, NULL, 10);
+        }
+
+        p = nl + 1;
+    }
+    return VAULT_ERR_CORRUPT;
+}
+
+/* ---- Bellek Yönetimi ---------------------------------------------------- */
+
 void vault_tree_free(VaultTree *tree){
-    (void)tree;
+    free(tree->entries);
+    tree->entries  = NULL;
+    tree->count    = 0;
+    tree->capacity = 0;
 }
@@ -0,0 +1,157 @@
+#include "../include/vault_oidset.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/* Ek tablo bu boyuttan ve sıralı diziden büyüyünce birleştirilir */
+#define EXTRA_MERGE_MIN  1024
+
+static uint64_t oid_word(const VaultOid *oid, size_t at){
+    uint64_t v;
+    memcpy(&v, oid->id + at, sizeof(v));
+    return v;
+}
+
+static int oid_cmp(const void *a, const void *b){
+    return vault_oid_cmp(a, b);
+}
+
+/* ---- Bloom filtresi ----------------------------------------------------- */
+
+/* Çift hash'leme: i. bit = h1 + i * h2 (h2 tek, tüm bitleri gezer) */
+static void bloom_set(VaultOidSet *set, const VaultOid *oid){
+    uint64_t h1 = oid_word(oid, 0);
+    uint64_t h2 = oid_word(oid, 8) | 1;
+    for (int i = 0; i < VAULT_OIDSET_BLOOM_HASHES; i++) {
+        size_t bit = (size_t)(h1 + (uint64_t)i * h2) & set->bloom_mask;
+        set->bloom[bit >> 6] |= (uint64_t)1 << (bit & 63);
+    }
+}
+
+static int bloom_test(const VaultOidSet *set, const VaultOid *oid){
+    uint64_t h1 = oid_word(oid, 0);
+    uint64_t h2 = oid_word(oid, 8) | 1;
+    for (int i = 0; i < VAULT_OIDSET_BLOOM_HASHES; i++) {
+        size_t bit = (size_t)(h1 + (uint64_t)i * h2) & set->bloom_mask;
+        if (!(set->bloom[bit >> 6] & ((uint64_t)1 << (bit & 63))))
+            return 0;
+    }
+    return 1;
+}
+
+/* ---- Ek tablo ----------------------------------------------------------- */
+
+static VaultOid *extra_slot(VaultOid *table, size_t cap, const VaultOid *oid){
+    size_t i = (size_t)oid_word(oid, 16) & (cap - 1);
+    while (!vault_oid_is_null(&table[i]) && !vault_oid_equal(&table[i], oid))
+        i = (i + 1) & (cap - 1);
+    return &table[i];
+}
+
+static VaultError extra_grow(VaultOidSet *set){
+    size_t cap = set->extra_cap ? set->extra_cap * 2 : 64;
+    VaultOid *table = calloc(cap, sizeof(*table));
+    if (!table)
+        return VAULT_ERR_NOMEM;
+    for (size_t i = 0; i < set->extra_cap; i++)
+        if (!vault_oid_is_null(&set->extra[i]))
+            *extra_slot(table, cap, &set->extra[i]) = set->extra[i];
+    free(set->extra);
+    set->extra = table;
+    set->extra_cap = cap;
+    return VAULT_OK;
+}
+
+/* ---- Küme --------------------------------------------------------------- */
+
+VaultError vault_oidset_build(VaultOidSet *set, VaultOid *ids, size_t count){
+    memset(set, 0, sizeof(*set));
+
+    if (count > 0)
+        qsort(ids, count, sizeof(*ids), oid_cmp);
+    size_t uniq = 0;
+    for (size_t i = 0; i < count; i++)
+        if (uniq == 0 || !vault_oid_equal(&ids[uniq - 1], &ids[i]))
+            ids[uniq++] = ids[i];
+
+    size_t bits = 1024;
+    while (bits < uniq * VAULT_OIDSET_BLOOM_BITS)
+        bits *= 2;
+    set->bloom = calloc(bits / 64, sizeof(uint64_t));
+    if (!set->bloom) {
+        free(ids);
+        return VAULT_ERR_NOMEM;
+    }
+    set->bloom_mask = bits - 1;
+    set->ids = ids;
+    set->count = uniq;
+    for (size_t i = 0; i < uniq; i++)
+        bloom_set(set, &ids[i]);
+    return VAULT_OK;
+}
+
+int vault_oidset_contains(const VaultOidSet *set, const VaultOid *oid){
+    if (!set->bloom || !bloom_test(set, oid))
+        return 0;
+    if (set->count > 0 && bsearch(oid, set->ids, set->count, sizeof(*oid), oid_cmp))
+        return 1;
+    return set->extra_count > 0 &&
+           !vault_oid_is_null(extra_slot(set->extra, set->extra_cap, oid));
+}
+
+/* Ek tablo sıralı diziye katılır, filtre yeni boyuta göre yeniden kurulur */
+static VaultError merge_extra(VaultOidSet *set){
+    size_t total = set->count + set->extra_count;
+    VaultOid *ids = malloc(total * sizeof(*ids));
+    if (!ids)
+        return VAULT_ERR_NOMEM;
+    memcpy(ids, set->ids, set->count * sizeof(*ids));
+    size_t n = set->count;
+    for (size_t i = 0; i < set->extra_cap; i++)
+        if (!vault_oid_is_null(&set->extra[i]))
+            ids[n++] = set->extra[i];
+
+    VaultOidSet merged;
+    VaultError err = vault_oidset_build(&merged, ids, n);
+    if (err != VAULT_OK)
+        return err;
+    vault_oidset_free(set);
+    *set = merged;
+    return VAULT_OK;
+}
+
+VaultError vault_oidset_add(VaultOidSet *set, const VaultOid *oid){
+    if (vault_oid_is_null(oid) || vault_oidset_contains(set, oid))
+        return VAULT_OK;
+
+    if (!set->bloom) {
+        VaultError err = vault_oidset_build(set, NULL, 0);
+        if (err != VAULT_OK)
+            return err;
+    }
+
+    /* Yük oranı 1/2'yi geçmesin */
+    if ((set->extra_count + 1) * 2 > set->extra_cap) {
+        VaultError err;
+        if (set->extra_count >= EXTRA_MERGE_MIN && set->extra_count >= set->count)
+            err = merge_extra(set);
+        else
+            err = extra_grow(set);
+        if (err != VAULT_OK)
+            return err;
+        if (set->extra_cap == 0 && (err = extra_grow(set)) != VAULT_OK)
+            return err;
+    }
+
+    *extra_slot(set->extra, set->extra_cap, oid) = *oid;
+    set->extra_count++;
+    bloom_set(set, oid);
+    return VAULT_OK;
+}
+
+void vault_oidset_free(VaultOidSet *set){
+    free(set->bloom);
+    free(set->ids);
+    free(set->extra);
+    memset(set, 0, sizeof(*set));
+}
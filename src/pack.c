@@ -0,0 +1,1220 @@
+#ifdef __linux__
+#define _DEFAULT_SOURCE     /* madvise */
+#endif
+#define _POSIX_C_SOURCE 200809L
+
+#include "../include/vault_pack.h"
+#include "../include/vault_delta.h"
+#include "../include/vault_fsync.h"
+#include "../include/vault_sha256.h"
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <zlib.h>
+
+#define PACK_MAGIC        "VPAK"
+#define IDX_MAGIC         "VIDX"
+#define PACK_HEADER_SIZE  12
+#define IDX_HEADER_SIZE   8
+#define IDX_FANOUT_SIZE   (256 * 4)
+#define PACK_NAME_SIZE    (5 + VAULT_HASH_HEX_SIZE)   /* "pack-<checksum>\0" */
+
+/* mmap edilmiş tek bir pack + index çifti */
+typedef struct {
+    char           name[PACK_NAME_SIZE];   /* "pack-<checksum>" */
+    const uint8_t *idx;
+    size_t         idx_size;
+    const uint8_t *pack;
+    size_t         pack_size;
+    uint32_t       count;
+    const uint8_t *fanout;
+    const uint8_t *oids;
+    const uint8_t *offsets;
+} VaultPack;
+
+static VaultPack *packs;
+static size_t     pack_count;
+static int        packs_loaded;
+
+/* vault add / checkout iş parçacıkları aynı anda nesne okuyabilir: yükleme
+ * ve delta base cache'i bu kilitle korunur. mmap'ler salt okunur; inflate ve
+ * delta uygulama kilit dışında yapılır. */
+static pthread_mutex_t pack_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void delta_cache_clear(void);
+
+/* ---- Big-endian yardımcılar --------------------------------------------- */
+
+static uint32_t get_be32(const uint8_t *p){
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+           ((uint32_t)p[2] << 8)  |  (uint32_t)p[3];
+}
+
+static uint64_t get_be64(const uint8_t *p){
+    return ((uint64_t)get_be32(p) << 32) | get_be32(p + 4);
+}
+
+static void put_be32(uint8_t *p, uint32_t v){
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+static void put_be64(uint8_t *p, uint64_t v){
+    put_be32(p, (uint32_t)(v >> 32));
+    put_be32(p + 4, (uint32_t)v);
+}
+
+/* ---- Pack yükleme ------------------------------------------------------- */
+
+static const uint8_t *map_file(const char *path, size_t *out_size){
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return NULL;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        return NULL;
+    }
+
+    void *map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return NULL;
+
+    *out_size = (size_t)st.st_size;
+    return map;
+}
+
+static int pack_open(const char *name, VaultPack *out){
+    char path[VAULT_OBJECT_PATH_MAX];
+    memset(out, 0, sizeof(*out));
+    snprintf(out->name, sizeof(out->name), "%s", name);
+
+    snprintf(path, sizeof(path), "%s/%s.idx", VAULT_PACK_DIR, name);
+    out->idx = map_file(path, &out->idx_size);
+    if (!out->idx)
+        return -1;
+
+    snprintf(path, sizeof(path), "%s/%s.pack", VAULT_PACK_DIR, name);
+    out->pack = map_file(path, &out->pack_size);
+    if (!out->pack)
+        goto fail;
+
+    /* Index başlığı ve boyut tutarlılığı */
+    if (out->idx_size < IDX_HEADER_SIZE + IDX_FANOUT_SIZE + VAULT_HASH_RAW_SIZE ||
+        memcmp(out->idx, IDX_MAGIC, 4) != 0 ||
+        get_be32(out->idx + 4) != VAULT_PACK_VERSION)
+        goto fail;
+
+    out->fanout = out->idx + IDX_HEADER_SIZE;
+    out->count  = get_be32(out->fanout + 255 * 4);
+    out->oids   = out->fanout + IDX_FANOUT_SIZE;
+    out->offsets = out->oids + (size_t)out->count * VAULT_HASH_RAW_SIZE;
+
+    size_t expected = IDX_HEADER_SIZE + IDX_FANOUT_SIZE
+                    + (size_t)out->count * (VAULT_HASH_RAW_SIZE + 8)
+                    + VAULT_HASH_RAW_SIZE;
+    if (out->idx_size != expected)
+        goto fail;
+
+    /* Pack başlığı; index'in sonundaki checksum pack'inkiyle eşleşmeli */
+    if (out->pack_size < PACK_HEADER_SIZE + VAULT_HASH_RAW_SIZE ||
+        memcmp(out->pack, PACK_MAGIC, 4) != 0 ||
+        get_be32(out->pack + 4) != VAULT_PACK_VERSION ||
+        get_be32(out->pack + 8) != out->count ||
+        memcmp(out->pack + out->pack_size - VAULT_HASH_RAW_SIZE,
+               out->idx + out->idx_size - VAULT_HASH_RAW_SIZE,
+               VAULT_HASH_RAW_SIZE) != 0)
+        goto fail;
+
+    return 0;
+
+fail:
+    if (out->idx)
+        munmap((void *)out->idx, out->idx_size);
+    if (out->pack)
+        munmap((void *)out->pack, out->pack_size);
+    memset(out, 0, sizeof(*out));
+    return -1;
+}
+
+static void packs_load(void){
+    pthread_mutex_lock(&pack_lock);
+    if (packs_loaded) {
+        pthread_mutex_unlock(&pack_lock);
+        return;
+    }
+    packs_loaded = 1;
+
+    DIR *dir = opendir(VAULT_PACK_DIR);
+    if (!dir) {
+        pthread_mutex_unlock(&pack_lock);
+        return;
+    }
+
+    struct dirent *de;
+    while ((de = readdir(dir)) != NULL) {
+        size_t len = strlen(de->d_name);
+        if (len != PACK_NAME_SIZE - 1 + 4 || strcmp(de->d_name + len - 4, ".idx") != 0 ||
+            strncmp(de->d_name, "pack-", 5) != 0)
+            continue;
+
+        char name[PACK_NAME_SIZE];
+        memcpy(name, de->d_name, PACK_NAME_SIZE - 1);
+        name[PACK_NAME_SIZE - 1] = '\0';
+
+        VaultPack *grown = realloc(packs, (pack_count + 1) * sizeof(*grown));
+        if (!grown)
+            break;
+        packs = grown;
+        if (pack_open(name, &packs[pack_count]) == 0)
+            pack_count++;
+        else
+            fprintf(stderr, "vault: warning: ignoring unreadable pack '%s'\n", name);
+    }
+    closedir(dir);
+    pthread_mutex_unlock(&pack_lock);
+}
+
+void vault_pack_close_all(void){
+    pthread_mutex_lock(&pack_lock);
+    for (size_t i = 0; i < pack_count; i++) {
+        munmap((void *)packs[i].idx, packs[i].idx_size);
+        munmap((void *)packs[i].pack, packs[i].pack_size);
+    }
+    free(packs);
+    packs = NULL;
+    pack_count = 0;
+    packs_loaded = 0;
+    delta_cache_clear();
+    pthread_mutex_unlock(&pack_lock);
+}
+
+/* ---- Arama -------------------------------------------------------------- */
+
+/* Fanout ile aralığı daralt, sonra binary search. Bulamazsa -1. */
+static long pack_find(const VaultPack *p, const VaultOid *oid){
+    const uint8_t *raw = oid->id;
+    uint32_t lo = raw[0] ? get_be32(p->fanout + (raw[0] - 1) * 4) : 0;
+    uint32_t hi = get_be32(p->fanout + raw[0] * 4);
+
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        int cmp = memcmp(p->oids + (size_t)mid * VAULT_HASH_RAW_SIZE, raw,
+                         VAULT_HASH_RAW_SIZE);
+        if (cmp == 0)
+            return (long)mid;
+        if (cmp < 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return -1;
+}
+
+static const VaultPack *pack_locate(const VaultOid *oid, long *out_pos){
+    packs_load();
+    for (size_t i = 0; i < pack_count; i++) {
+        long pos = pack_find(&packs[i], oid);
+        if (pos >= 0) {
+            *out_pos = pos;
+            return &packs[i];
+        }
+    }
+    return NULL;
+}
+
+int vault_pack_contains(const VaultOid *oid){
+    long pos;
+    return pack_locate(oid, &pos) != NULL;
+}
+
+VaultError vault_pack_foreach_oid(VaultOidCallback fn, void *ctx){
+    packs_load();
+    for (size_t i = 0; i < pack_count; i++)
+        for (uint32_t j = 0; j < packs[i].count; j++) {
+            VaultOid oid;
+            memcpy(oid.id, packs[i].oids + (size_t)j * VAULT_HASH_RAW_SIZE, VAULT_HASH_RAW_SIZE);
+            VaultError err = fn(&oid, ctx);
+            if (err != VAULT_OK)
+                return err;
+        }
+    return VAULT_OK;
+}
+
+/* ---- Varint / giriş başlığı -------------------------------------------- */
+
+/* 7-bit little-endian varint; tüketilen byte sayısını döner, hata → 0 */
+static size_t varint_parse(const uint8_t *p, size_t avail, uint64_t *out){
+    uint64_t v = 0;
+    unsigned shift = 0;
+    for (size_t i = 0; i < avail && shift < 64; i++, shift += 7) {
+        v |= (uint64_t)(p[i] & 0x7f) << shift;
+        if (!(p[i] & 0x80)) {
+            *out = v;
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+static size_t varint_write(uint8_t *p, uint64_t v){
+    size_t n = 0;
+    do {
+        uint8_t b = v & 0x7f;
+        v >>= 7;
+        p[n++] = b | (v ? 0x80 : 0);
+    } while (v);
+    return n;
+}
+
+/*
+ * Giriş başlığı:
+ *   [tip][boyut varint]                    → tam nesne
+ *   [DELTA][delta boyutu varint][mesafe]   → base, bu girişten "mesafe"
+ *                                            byte geride
+ * Başlık uzunluğunu döner, hata → 0.
+ */
+static size_t entry_header_parse(const uint8_t *p, size_t avail, uint8_t *out_type,
+                                 uint64_t *out_size, uint64_t *out_base_dist){
+    if (avail < 2)
+        return 0;
+    *out_type = p[0];
+
+    size_t n = varint_parse(p + 1, avail - 1, out_size);
+    if (n == 0)
+        return 0;
+    n += 1;
+
+    if (*out_type == VAULT_PACK_OBJ_DELTA) {
+        size_t m = varint_parse(p + n, avail - n, out_base_dist);
+        if (m == 0)
+            return 0;
+        n += m;
+    }
+    return n;
+}
+
+static size_t entry_header_write(uint8_t *p, uint8_t type, uint64_t size, uint64_t base_dist){
+    size_t n = 0;
+    p[n++] = type;
+    n += varint_write(p + n, size);
+    if (type == VAULT_PACK_OBJ_DELTA)
+        n += varint_write(p + n, base_dist);
+    return n;
+}
+
+static VaultError inflate_exact(const uint8_t *src, size_t src_size,
+                                uint8_t *dst, size_t dst_size){
+    z_stream zs;
+    memset(&zs, 0, sizeof(zs));
+    if (inflateInit(&zs) != Z_OK)
+        return VAULT_ERR_COMPRESS;
+
+    /* avail_in / avail_out 32 bit: 4GB'tan büyük nesneler parça parça */
+    size_t in_left = src_size, out_left = dst_size;
+    zs.next_out = dst;      /* boş nesnede de NULL olmamalı */
+    int zr;
+    do {
+        if (zs.avail_in == 0 && in_left > 0) {
+            zs.next_in  = (Bytef *)src + (src_size - in_left);
+            zs.avail_in = in_left > UINT_MAX ? UINT_MAX : (uInt)in_left;
+            in_left    -= zs.avail_in;
+        }
+        if (zs.avail_out == 0 && out_left > 0) {
+            zs.next_out  = dst + (dst_size - out_left);
+            zs.avail_out = out_left > UINT_MAX ? UINT_MAX : (uInt)out_left;
+            out_left    -= zs.avail_out;
+        }
+        zr = inflate(&zs, Z_NO_FLUSH);
+    } while (zr == Z_OK);
+    size_t produced = dst_size - out_left - zs.avail_out;
+    inflateEnd(&zs);
+
+    return (zr == Z_STREAM_END && produced == dst_size) ? VAULT_OK : VAULT_ERR_CORRUPT;
+}
+
+/* ---- Delta base cache --------------------------------------------------- */
+
+/*
+ * Delta zincirlerinin ortak base'leri tekrar tekrar açılmasın diye
+ * yeniden oluşturulmuş base'leri (pack, offset) anahtarıyla saklayan
+ * doğrudan eşlemeli (direct-mapped) bir cache. Toplam boyut
+ * VAULT_PACK_DELTA_CACHE_LIMIT ile sınırlıdır.
+ */
+typedef struct {
+    const VaultPack *pack;
+    uint64_t         offset;
+    uint8_t         *data;
+    size_t           size;
+    uint8_t          type;
+} DeltaCacheSlot;
+
+static DeltaCacheSlot delta_cache[VAULT_PACK_DELTA_CACHE_SLOTS];
+static size_t         delta_cache_bytes;
+
+static size_t delta_cache_slot(const VaultPack *p, uint64_t offset){
+    uint64_t h = offset ^ ((uintptr_t)p >> 4);
+    h ^= h >> 17;
+    h *= 0x9e3779b97f4a7c15ull;
+    return (size_t)(h >> 32) % VAULT_PACK_DELTA_CACHE_SLOTS;
+}
+
+static void delta_cache_evict(size_t i){
+    if (!delta_cache[i].data)
+        return;
+    delta_cache_bytes -= delta_cache[i].size;
+    free(delta_cache[i].data);
+    memset(&delta_cache[i], 0, sizeof(delta_cache[i]));
+}
+
+static const DeltaCacheSlot *delta_cache_get(const VaultPack *p, uint64_t offset){
+    const DeltaCacheSlot *slot = &delta_cache[delta_cache_slot(p, offset)];
+    if (slot->data && slot->pack == p && slot->offset == offset)
+        return slot;
+    return NULL;
+}
+
+/* Cache verinin sahipliğini alırsa 1, almazsa 0 döner (çağıran free eder) */
+static int delta_cache_put(const VaultPack *p, uint64_t offset,
+                           uint8_t *data, size_t size, uint8_t type){
+    if (size > VAULT_PACK_DELTA_CACHE_LIMIT / 4)
+        return 0;
+
+    size_t i = delta_cache_slot(p, offset);
+    delta_cache_evict(i);
+
+    /* Bütçe aşılıyorsa diğer slotlardan yer aç */
+    for (size_t j = (i + 1) % VAULT_PACK_DELTA_CACHE_SLOTS;
+         delta_cache_bytes + size > VAULT_PACK_DELTA_CACHE_LIMIT && j != i;
+         j = (j + 1) % VAULT_PACK_DELTA_CACHE_SLOTS)
+        delta_cache_evict(j);
+
+    delta_cache[i].pack   = p;
+    delta_cache[i].offset = offset;
+    delta_cache[i].data   = data;
+    delta_cache[i].size   = size;
+    delta_cache[i].type   = type;
+    delta_cache_bytes += size;
+    return 1;
+}
+
+static void delta_cache_clear(void){
+    for (size_t i = 0; i < VAULT_PACK_DELTA_CACHE_SLOTS; i++)
+        delta_cache_evict(i);
+}
+
+/* ---- Nesne okuma -------------------------------------------------------- */
+
+/* Tam (delta olmayan) bir girişi açar */
+static VaultError entry_inflate(const VaultPack *p, uint64_t off,
+                                uint8_t **out_data, size_t *out_size, uint8_t *out_type){
+    size_t body_end = p->pack_size - VAULT_HASH_RAW_SIZE;
+    uint8_t type;
+    uint64_t size, dist = 0;
+    size_t hdr = entry_header_parse(p->pack + off, body_end - off, &type, &size, &dist);
+    if (hdr == 0)
+        return VAULT_ERR_CORRUPT;
+
+    uint8_t *data = malloc((size_t)size + 1);
+    if (!data)
+        return VAULT_ERR_NOMEM;
+
+    VaultError err = inflate_exact(p->pack + off + hdr, body_end - off - hdr,
+                                   data, (size_t)size);
+    if (err != VAULT_OK) {
+        free(data);
+        return err;
+    }
+    data[size] = '\0';
+
+    *out_data = data;
+    *out_size = (size_t)size;
+    *out_type = type;
+    return VAULT_OK;
+}
+
+/*
+ * Offset'teki nesneyi yeniden oluşturur. Delta ise zincir, cache'te bir
+ * base bulunana ya da tam bir nesneye ulaşılana kadar geriye doğru izlenir,
+ * sonra delta'lar sırayla uygulanır. Ara sonuçlar cache'e girer.
+ *
+ * Kilit yalnızca cache'e bakarken ve eklerken tutulur: cache'teki base
+ * kilit altında kopyalanır (başka bir iş parçacığı onu atabilir).
+ */
+static VaultError pack_entry_read(const VaultPack *p, uint64_t off,
+                                  uint8_t **out_data, size_t *out_size,
+                                  VaultObjectType *out_type){
+    size_t body_end = p->pack_size - VAULT_HASH_RAW_SIZE;
+    uint64_t chain[VAULT_PACK_MAX_CHAIN];
+    size_t depth = 0;
+    uint64_t cur = off;
+
+    uint8_t *base = NULL;
+    size_t base_size = 0;
+    uint8_t base_type = 0;
+    VaultError err;
+
+    for (;;) {
+        if (cur < PACK_HEADER_SIZE || cur >= body_end)
+            return VAULT_ERR_CORRUPT;
+
+        pthread_mutex_lock(&pack_lock);
+        const DeltaCacheSlot *hit = delta_cache_get(p, cur);
+        if (hit && (base = malloc(hit->size + 1)) != NULL) {
+            memcpy(base, hit->data, hit->size + 1);
+            base_size = hit->size;
+            base_type = hit->type;
+        }
+        pthread_mutex_unlock(&pack_lock);
+        if (hit && !base)
+            return VAULT_ERR_NOMEM;
+        if (base)
+            break;
+
+        uint8_t type;
+        uint64_t size, dist = 0;
+        if (entry_header_parse(p->pack + cur, body_end - cur, &type, &size, &dist) == 0)
+            return VAULT_ERR_CORRUPT;
+
+        if (type != VAULT_PACK_OBJ_DELTA) {
+            if (type > VAULT_OBJ_COMMIT)
+                return VAULT_ERR_CORRUPT;
+            err = entry_inflate(p, cur, &base, &base_size, &base_type);
+            if (err != VAULT_OK)
+                return err;
+            break;
+        }
+
+        if (depth == VAULT_PACK_MAX_CHAIN || dist == 0 || dist > cur)
+            return VAULT_ERR_CORRUPT;
+        chain[depth++] = cur;
+        cur -= dist;
+    }
+
+    while (depth > 0) {
+        uint64_t at = chain[--depth];
+        uint8_t *delta = NULL, *result = NULL;
+        size_t delta_size = 0, result_size = 0;
+        uint8_t dtype;
+
+        err = entry_inflate(p, at, &delta, &delta_size, &dtype);
+        if (err == VAULT_OK) {
+            err = vault_delta_apply(base, base_size, delta, delta_size,
+                                    &result, &result_size);
+            free(delta);
+        }
+
+        /* Kullanılan base bir sonraki okuma için cache'e */
+        pthread_mutex_lock(&pack_lock);
+        int cached = delta_cache_put(p, cur, base, base_size, base_type);
+        pthread_mutex_unlock(&pack_lock);
+        if (!cached)
+            free(base);
+        if (err != VAULT_OK)
+            return err;
+
+        base = result;
+        base_size = result_size;
+        cur = at;
+    }
+
+    *out_data = base;
+    *out_size = base_size;
+    *out_type = (VaultObjectType)base_type;
+    return VAULT_OK;
+}
+
+VaultError vault_pack_read(const VaultOid *oid,
+                           uint8_t **out_data, size_t *out_size,
+                           VaultObjectType *out_type){
+    long pos;
+    const VaultPack *p = pack_locate(oid, &pos);
+    if (!p)
+        return VAULT_ERR_NOTFOUND;
+
+    return pack_entry_read(p, get_be64(p->offsets + (size_t)pos * 8),
+                           out_data, out_size, out_type);
+}
+
+static int fd_write_all(int fd, const uint8_t *buf, size_t len){
+    while (len > 0) {
+        ssize_t n = write(fd, buf, len);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            return -1;
+        }
+        buf += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+/* Akışla okunurken inflate'e tek seferde verilen mmap penceresi */
+#define PACK_STREAM_WINDOW (1u << 20)
+
+/*
+ * Tüketilmiş pencerenin sayfalarını bırakır; yoksa büyük bir nesneyi akışla
+ * okumak bile pack'teki karşılığı kadar RSS bırakır. Eşleme salt okunur,
+ * bırakılan sayfa gerekirse dosyadan yeniden yüklenir.
+ */
+static void pack_drop_pages(const uint8_t *from, const uint8_t *to){
+#ifdef MADV_DONTNEED
+    uintptr_t page = (uintptr_t)sysconf(_SC_PAGESIZE);
+    uintptr_t lo = (uintptr_t)from & ~(page - 1);
+    uintptr_t hi = (uintptr_t)to & ~(page - 1);
+    if (hi > lo)
+        madvise((void *)lo, hi - lo, MADV_DONTNEED);
+#else
+    (void)from;
+    (void)to;
+#endif
+}
+
+/*
+ * Tam bir giriş mmap'ten PACK_STREAM_WINDOW'luk pencerelerle açılıp
+ * VAULT_STREAM_CHUNK'lık parçalarla fd'ye yazılır. Delta'ların sonucu base olmadan kurulamaz: onlar bellekte
+ * oluşturulur (büyük nesneler repack'te delta'lanmaz, bkz.
+ * VAULT_PACK_DELTA_MAX_SIZE).
+ */
+VaultError vault_pack_read_fd(const VaultOid *oid, VaultObjectType type, int fd){
+    long pos;
+    const VaultPack *p = pack_locate(oid, &pos);
+    if (!p)
+        return VAULT_ERR_NOTFOUND;
+
+    uint64_t off = get_be64(p->offsets + (size_t)pos * 8);
+    size_t body_end = p->pack_size - VAULT_HASH_RAW_SIZE;
+    uint8_t etype;
+    uint64_t size, dist = 0;
+    size_t hdr = (off >= PACK_HEADER_SIZE && off < body_end)
+                 ? entry_header_parse(p->pack + off, body_end - off, &etype, &size, &dist) : 0;
+    if (hdr == 0)
+        return VAULT_ERR_CORRUPT;
+
+    if (etype == VAULT_PACK_OBJ_DELTA) {
+        uint8_t *data;
+        size_t data_size;
+        VaultObjectType got;
+        VaultError err = pack_entry_read(p, off, &data, &data_size, &got);
+        if (err != VAULT_OK)
+            return err;
+        if (got != type)
+            err = VAULT_ERR_CORRUPT;
+        else if (fd_write_all(fd, data, data_size) != 0)
+            err = VAULT_ERR_IO;
+        free(data);
+        return err;
+    }
+    if (etype != (uint8_t)type)
+        return VAULT_ERR_CORRUPT;
+
+    z_stream zs;
+    memset(&zs, 0, sizeof(zs));
+    if (inflateInit(&zs) != Z_OK)
+        return VAULT_ERR_COMPRESS;
+
+    uint8_t buf[VAULT_STREAM_CHUNK];
+    const uint8_t *in = p->pack + off + hdr, *win = in;
+    size_t in_left = body_end - off - hdr;
+    uint64_t written = 0;
+    VaultError err = VAULT_OK;
+    int zr = Z_OK;
+    while (err == VAULT_OK && zr != Z_STREAM_END) {
+        if (zs.avail_in == 0) {
+            if (in_left == 0) {
+                err = VAULT_ERR_CORRUPT;
+                break;
+            }
+            pack_drop_pages(win, in);
+            win = in;
+            zs.next_in = (Bytef *)in;
+            zs.avail_in = in_left > PACK_STREAM_WINDOW ? PACK_STREAM_WINDOW
+                                                       : (uInt)in_left;
+            in += zs.avail_in;
+            in_left -= zs.avail_in;
+        }
+        zs.next_out = buf;
+        zs.avail_out = sizeof(buf);
+        zr = inflate(&zs, Z_NO_FLUSH);
+        if (zr != Z_OK && zr != Z_STREAM_END && zr != Z_BUF_ERROR) {
+            err = VAULT_ERR_CORRUPT;
+            break;
+        }
+        size_t n = sizeof(buf) - zs.avail_out;
+        written += n;
+        if (written > size)
+            err = VAULT_ERR_CORRUPT;
+        else if (fd_write_all(fd, buf, n) != 0)
+            err = VAULT_ERR_IO;
+    }
+    inflateEnd(&zs);
+    pack_drop_pages(win, in);
+    if (err == VAULT_OK && written != size)
+        err = VAULT_ERR_CORRUPT;
+    return err;
+}
+
+/*
+ * Offset'teki nesnenin tipini ve boyutunu içeriği açmadan bulur. Tam
+ * nesnede ikisi de giriş başlığındadır. Delta'da sonuç boyutu delta
+ * verisinin ikinci varint'idir: yalnızca ilk birkaç byte inflate edilir;
+ * tip için zincir, başlıklar üzerinden tam nesneye kadar izlenir.
+ */
+static VaultError pack_entry_size(const VaultPack *p, uint64_t off,
+                                  size_t *out_size, VaultObjectType *out_type){
+    size_t body_end = p->pack_size - VAULT_HASH_RAW_SIZE;
+    int have_size = 0;
+
+    for (size_t depth = 0; depth <= VAULT_PACK_MAX_CHAIN; depth++) {
+        if (off < PACK_HEADER_SIZE || off >= body_end)
+            return VAULT_ERR_CORRUPT;
+
+        uint8_t type;
+        uint64_t size, dist = 0;
+        size_t hdr = entry_header_parse(p->pack + off, body_end - off, &type, &size, &dist);
+        if (hdr == 0)
+            return VAULT_ERR_CORRUPT;
+
+        if (type != VAULT_PACK_OBJ_DELTA) {
+            if (type > VAULT_OBJ_COMMIT)
+                return VAULT_ERR_CORRUPT;
+            if (!have_size)
+                *out_size = (size_t)size;
+            *out_type = (VaultObjectType)type;
+            return VAULT_OK;
+        }
+
+        if (!have_size) {
+            /* İki varint en fazla 20 byte */
+            uint8_t head[20];
+            z_stream zs;
+            memset(&zs, 0, sizeof(zs));
+            if (inflateInit(&zs) != Z_OK)
+                return VAULT_ERR_COMPRESS;
+            zs.next_in   = (Bytef *)(p->pack + off + hdr);
+            size_t avail = body_end - off - hdr;
+            zs.avail_in  = avail > UINT_MAX ? UINT_MAX : (uInt)avail;
+            zs.next_out  = head;
+            zs.avail_out = (uInt)(size < sizeof(head) ? size : sizeof(head));
+            int zr = inflate(&zs, Z_SYNC_FLUSH);
+            size_t produced = zs.total_out;
+            inflateEnd(&zs);
+            if (zr != Z_OK && zr != Z_STREAM_END && zr != Z_BUF_ERROR)
+                return VAULT_ERR_CORRUPT;
+
+            uint64_t base_size, result_size;
+            size_t n = varint_parse(head, produced, &base_size);
+            if (n == 0 || varint_parse(head + n, produced - n, &result_size) == 0)
+                return VAULT_ERR_CORRUPT;
+            *out_size = (size_t)result_size;
+            have_size = 1;
+        }
+
+        if (dist == 0 || dist > off)
+            return VAULT_ERR_CORRUPT;
+        off -= dist;
+    }
+    return VAULT_ERR_CORRUPT;
+}
+
+VaultError vault_pack_object_size(const VaultOid *oid,
+                                  size_t *out_size, VaultObjectType *out_type){
+    long pos;
+    const VaultPack *p = pack_locate(oid, &pos);
+    if (!p)
+        return VAULT_ERR_NOTFOUND;
+
+    return pack_entry_size(p, get_be64(p->offsets + (size_t)pos * 8),
+                           out_size, out_type);
+}
+
+/* ---- Repack ------------------------------------------------------------- */
+
+typedef struct {
+    VaultOid oid;
+    uint64_t offset;
+    int      loose;       /* Loose olarak da mevcut mu (silinecek) */
+    uint8_t  type;
+    size_t   size;
+    uint32_t name_hash;   /* Nesneyi gösteren tree girişinin adından */
+    int      depth;       /* Delta zinciri derinliği (tam nesne = 0) */
+} RepackEntry;
+
+typedef struct {
+    RepackEntry *items;
+    size_t       count;
+    size_t       capacity;
+} RepackList;
+
+static int repack_push(RepackList *list, const VaultOid *oid, int loose){
+    if (list->count == list->capacity) {
+        size_t cap = list->capacity ? list->capacity * 2 : 256;
+        RepackEntry *grown = realloc(list->items, cap * sizeof(*grown));
+        if (!grown)
+            return -1;
+        list->items = grown;
+        list->capacity = cap;
+    }
+    RepackEntry *e = &list->items[list->count++];
+    memset(e, 0, sizeof(*e));
+    e->oid = *oid;
+    e->loose = loose;
+    return 0;
+}
+
+static int repack_entry_cmp(const void *a, const void *b){
+    const RepackEntry *x = a, *y = b;
+    int cmp = vault_oid_cmp(&x->oid, &y->oid);
+    if (cmp != 0)
+        return cmp;
+    return y->loose - x->loose;   /* loose kopya önde kalsın */
+}
+
+static VaultError collect_loose_one(const VaultOid *oid, void *ctx){
+    return repack_push(ctx, oid, 1) == 0 ? VAULT_OK : VAULT_ERR_NOMEM;
+}
+
+static VaultError collect_loose(RepackList *list){
+    return vault_object_foreach_loose(collect_loose_one, list);
+}
+
+static VaultError collect_packed_one(const VaultOid *oid, void *ctx){
+    return repack_push(ctx, oid, 0) == 0 ? VAULT_OK : VAULT_ERR_NOMEM;
+}
+
+static VaultError collect_packed(RepackList *list){
+    return vault_pack_foreach_oid(collect_packed_one, list);
+}
+
+/* Yazılan her byte pack checksum'ına da girer */
+static int pack_emit(FILE *fp, VaultSha256 *md, const void *buf, size_t len, uint64_t *pos){
+    if (len && fwrite(buf, 1, len, fp) != len)
+        return -1;
+    vault_sha256_update(md, buf, len);
+    *pos += len;
+    return 0;
+}
+
+static int repack_oid_cmp(const void *key, const void *item){
+    return vault_oid_cmp(key, &((const RepackEntry *)item)->oid);
+}
+
+/*
+ * Git'teki pack_name_hash: adın son karakterlerine daha çok ağırlık verir,
+ * böylece farklı dizinlerdeki aynı isimli / aynı uzantılı dosyalar
+ * sıralamada yan yana düşer.
+ */
+static uint32_t name_hash(const char *name){
+    uint32_t h = 0;
+    for (; *name; name++) {
+        unsigned char c = (unsigned char)*name;
+        if (c == ' ' || c == '\t' || c == '\n')
+            continue;
+        h = (h >> 2) + ((uint32_t)c << 24);
+    }
+    return h;
+}
+
+/*
+ * 1. geçiş: her nesnenin tipini ve boyutunu başlıktan öğren; yalnızca
+ * tree'ler açılıp girişlerinden çocuklara isim hash'i atanır. Blob'lar
+ * burada inflate edilmez, yazılırken bir kez açılır. Liste hash'e göre
+ * sıralı olmalı.
+ */
+static VaultError repack_collect_info(RepackList *list){
+    for (size_t i = 0; i < list->count; i++) {
+        RepackEntry *e = &list->items[i];
+        VaultObjectType type;
+        VaultError err = vault_object_size(&e->oid, &e->size, &type);
+        if (err != VAULT_OK)
+            return err;
+        e->type = (uint8_t)type;
+
+        if (type == VAULT_OBJ_TREE) {
+            uint8_t *data = NULL;
+            size_t size;
+            if ((err = vault_object_read(&e->oid, &data, &size, &type)) != VAULT_OK)
+                return err;
+            VaultTree tree;
+            if (vault_tree_deserialize(data, size, &tree) == VAULT_OK) {
+                for (size_t j = 0; j < tree.count; j++) {
+                    RepackEntry *child = bsearch(&tree.entries[j].hash, list->items,
+                                                 list->count, sizeof(*list->items),
+                                                 repack_oid_cmp);
+                    if (child && child->name_hash == 0)
+                        child->name_hash = name_hash(tree.entries[j].name);
+                }
+                vault_tree_free(&tree);
+            }
+            free(data);
+        }
+    }
+    return VAULT_OK;
+}
+
+/* Tip, isim hash'i, büyükten küçüğe boyut: benzer nesneler pencerede buluşur */
+static int repack_delta_order_cmp(const void *a, const void *b){
+    const RepackEntry *x = *(const RepackEntry * const *)a;
+    const RepackEntry *y = *(const RepackEntry * const *)b;
+    if (x->type != y->type)
+        return x->type < y->type ? -1 : 1;
+    if (x->name_hash != y->name_hash)
+        return x->name_hash < y->name_hash ? -1 : 1;
+    if (x->size != y->size)
+        return x->size > y->size ? -1 : 1;
+    return vault_oid_cmp(&x->oid, &y->oid);
+}
+
+/*
+ * Girişi yazar. İçerik VAULT_STREAM_CHUNK'lık parçalarla deflate edilip
+ * doğrudan pack'e akar: zlib'in tek seferlik API'si boyutu uLong / uInt
+ * ile alır ve 4GB'tan büyük nesneleri keserdi.
+ */
+static VaultError pack_write_entry(FILE *fp, VaultSha256 *md, RepackEntry *e,
+                                   uint8_t type, const uint8_t *payload, size_t size,
+                                   uint64_t base_offset, uint64_t *pos){
+    uint8_t hdr[32];
+    size_t hdr_len = entry_header_write(hdr, type, size, *pos - base_offset);
+
+    e->offset = *pos;
+    if (pack_emit(fp, md, hdr, hdr_len, pos) != 0)
+        return VAULT_ERR_IO;
+
+    z_stream zs;
+    memset(&zs, 0, sizeof(zs));
+    if (deflateInit(&zs, Z_DEFAULT_COMPRESSION) != Z_OK)
+        return VAULT_ERR_COMPRESS;
+
+    uint8_t out[VAULT_STREAM_CHUNK];
+    size_t left = size;
+    VaultError err = VAULT_OK;
+    int zr;
+    do {
+        if (zs.avail_in == 0 && left > 0) {
+            size_t chunk = left > VAULT_STREAM_CHUNK ? VAULT_STREAM_CHUNK : left;
+            zs.next_in  = (Bytef *)payload + (size - left);
+            zs.avail_in = (uInt)chunk;
+            left       -= chunk;
+        }
+        zs.next_out  = out;
+        zs.avail_out = sizeof(out);
+        zr = deflate(&zs, left > 0 ? Z_NO_FLUSH : Z_FINISH);
+        if (zr == Z_STREAM_ERROR) {
+            err = VAULT_ERR_COMPRESS;
+            break;
+        }
+        if (pack_emit(fp, md, out, sizeof(out) - zs.avail_out, pos) != 0) {
+            err = VAULT_ERR_IO;
+            break;
+        }
+    } while (zr != Z_STREAM_END);
+    deflateEnd(&zs);
+    return err;
+}
+
+/* Kayan pencerede tutulan, yakın zamanda yazılmış bir nesne */
+typedef struct {
+    RepackEntry *entry;
+    uint8_t     *data;
+} WindowSlot;
+
+/*
+ * Nesneyi yazar: penceredeki aynı tipteki nesnelere karşı delta dener,
+ * en küçüğü yeterince küçükse delta olarak, değilse tam olarak yazar.
+ */
+static VaultError pack_write_object(FILE *fp, VaultSha256 *md, RepackEntry *e,
+                                    const uint8_t *data, WindowSlot *window,
+                                    uint64_t *pos){
+    uint8_t *best = NULL;
+    size_t best_size = 0;
+    const RepackEntry *best_base = NULL;
+
+    int deltable = e->size >= VAULT_PACK_DELTA_MIN_SIZE && e->size <= VAULT_PACK_DELTA_MAX_SIZE;
+    for (int i = 0; deltable && i < VAULT_PACK_WINDOW; i++) {
+        const RepackEntry *b = window[i].entry;
+        if (!b || b->type != e->type || b->depth >= VAULT_PACK_MAX_DEPTH ||
+            b->size > VAULT_PACK_DELTA_MAX_SIZE)
+            continue;
+
+        /* Derin zincirlerde delta'nın daha çok kazandırması gerekir */
+        size_t max_size = e->size / 2 - 20;
+        max_size = max_size * (size_t)(VAULT_PACK_MAX_DEPTH - b->depth) / VAULT_PACK_MAX_DEPTH;
+        if (best && best_size - 1 < max_size)
+            max_size = best_size - 1;
+        /* base'den uzun kısım olduğu gibi eklenmek zorunda */
+        if (max_size == 0 || e->size > b->size + max_size)
+            continue;
+
+        uint8_t *delta = NULL;
+        size_t delta_size = 0;
+        VaultError err = vault_delta_create(window[i].data, b->size, data, e->size,
+                                            max_size, &delta, &delta_size);
+        if (err == VAULT_ERR_NOMEM) {
+            free(best);
+            return err;
+        }
+        if (err != VAULT_OK)
+            continue;
+
+        free(best);
+        best = delta;
+        best_size = delta_size;
+        best_base = b;
+    }
+
+    VaultError err;
+    if (best) {
+        e->depth = best_base->depth + 1;
+        err = pack_write_entry(fp, md, e, VAULT_PACK_OBJ_DELTA, best, best_size,
+                               best_base->offset, pos);
+        free(best);
+    } else {
+        e->depth = 0;
+        err = pack_write_entry(fp, md, e, e->type, data, e->size, 0, pos);
+    }
+    return err;
+}
+
+static VaultError idx_write(const char *path, const RepackList *list,
+                            const uint8_t checksum[VAULT_HASH_RAW_SIZE]){
+    FILE *fp = fopen(path, "wb");
+    if (!fp)
+        return VAULT_ERR_IO;
+
+    uint8_t buf[IDX_FANOUT_SIZE];
+    memcpy(buf, IDX_MAGIC, 4);
+    put_be32(buf + 4, VAULT_PACK_VERSION);
+    int ok = fwrite(buf, 1, IDX_HEADER_SIZE, fp) == IDX_HEADER_SIZE;
+
+    size_t j = 0;
+    for (int b = 0; b < 256; b++) {
+        while (j < list->count && list->items[j].oid.id[0] == b)
+            j++;
+        put_be32(buf + b * 4, (uint32_t)j);
+    }
+    ok = ok && fwrite(buf, 1, IDX_FANOUT_SIZE, fp) == IDX_FANOUT_SIZE;
+
+    for (size_t i = 0; ok && i < list->count; i++)
+        ok = fwrite(list->items[i].oid.id, 1, VAULT_HASH_RAW_SIZE, fp) == VAULT_HASH_RAW_SIZE;
+    for (size_t i = 0; ok && i < list->count; i++) {
+        put_be64(buf, list->items[i].offset);
+        ok = fwrite(buf, 1, 8, fp) == 8;
+    }
+    ok = ok && fwrite(checksum, 1, VAULT_HASH_RAW_SIZE, fp) == VAULT_HASH_RAW_SIZE;
+    ok = ok && fflush(fp) == 0 && vault_fsync_file(fileno(fp)) == VAULT_OK;
+
+    if (fclose(fp) != 0 || !ok) {
+        unlink(path);
+        return VAULT_ERR_IO;
+    }
+    return VAULT_OK;
+}
+
+static void remove_loose(const RepackList *list){
+    for (size_t i = 0; i < list->count; i++) {
+        if (!list->items[i].loose)
+            continue;
+        char path[VAULT_OBJECT_PATH_MAX];
+        vault_object_path(&list->items[i].oid, path, sizeof(path));
+        unlink(path);
+
+        /* Boşalan <ilk2> dizini de gitsin; dolu ise rmdir zaten başarısız olur */
+        char *slash = strrchr(path, '/');
+        *slash = '\0';
+        rmdir(path);
+    }
+}
+
+static void remove_old_packs(const char *keep){
+    for (size_t i = 0; i < pack_count; i++) {
+        if (strcmp(packs[i].name, keep) == 0)
+            continue;
+        char path[VAULT_OBJECT_PATH_MAX];
+        snprintf(path, sizeof(path), "%s/%s.idx", VAULT_PACK_DIR, packs[i].name);
+        unlink(path);
+        snprintf(path, sizeof(path), "%s/%s.pack", VAULT_PACK_DIR, packs[i].name);
+        unlink(path);
+    }
+}
+
+VaultError vault_repack(size_t *out_count){
+    RepackList list = {0};
+    VaultError err;
+
+    if (out_count)
+        *out_count = 0;
+
+    if ((err = collect_packed(&list)) != VAULT_OK ||
+        (err = collect_loose(&list)) != VAULT_OK) {
+        free(list.items);
+        return err;
+    }
+
+    /* Sırala ve tekrarları at (aynı nesne hem loose hem pack'te olabilir) */
+    qsort(list.items, list.count, sizeof(*list.items), repack_entry_cmp);
+    size_t uniq = 0;
+    for (size_t i = 0; i < list.count; i++) {
+        if (uniq > 0 && vault_oid_equal(&list.items[uniq - 1].oid, &list.items[i].oid))
+            continue;
+        list.items[uniq++] = list.items[i];
+    }
+    list.count = uniq;
+
+    if (list.count == 0) {
+        free(list.items);
+        return VAULT_OK;
+    }
+
+    if ((err = repack_collect_info(&list)) != VAULT_OK) {
+        free(list.items);
+        return err;
+    }
+
+    if (mkdir(VAULT_PACK_DIR, 0755) != 0 && errno != EEXIST) {
+        free(list.items);
+        return VAULT_ERR_IO;
+    }
+
+    char tmp_pack[VAULT_OBJECT_PATH_MAX];
+    snprintf(tmp_pack, sizeof(tmp_pack), "%s/tmp_pack_XXXXXX", VAULT_PACK_DIR);
+    int fd = mkstemp(tmp_pack);
+    if (fd >= 0)
+        fchmod(fd, 0644);   /* mkstemp 0600 açar; pack herkesçe okunabilir olmalı */
+    FILE *fp = (fd >= 0) ? fdopen(fd, "wb") : NULL;
+    if (!fp) {
+        if (fd >= 0) {
+            close(fd);
+            unlink(tmp_pack);
+        }
+        free(list.items);
+        return VAULT_ERR_IO;
+    }
+    VaultSha256 md;
+    vault_sha256_init(&md);
+
+    uint64_t pos = 0;
+    uint8_t header[PACK_HEADER_SIZE];
+    memcpy(header, PACK_MAGIC, 4);
+    put_be32(header + 4, VAULT_PACK_VERSION);
+    put_be32(header + 8, (uint32_t)list.count);
+    err = pack_emit(fp, &md, header, sizeof(header), &pos) == 0 ? VAULT_OK : VAULT_ERR_IO;
+
+    /* Delta sırası: tip / isim / boyut. Pencere son yazılan nesneleri tutar. */
+    RepackEntry **order = malloc(list.count * sizeof(*order));
+    WindowSlot window[VAULT_PACK_WINDOW];
+    memset(window, 0, sizeof(window));
+    if (!order)
+        err = VAULT_ERR_NOMEM;
+    if (err == VAULT_OK) {
+        for (size_t i = 0; i < list.count; i++)
+            order[i] = &list.items[i];
+        qsort(order, list.count, sizeof(*order), repack_delta_order_cmp);
+    }
+
+    for (size_t i = 0; err == VAULT_OK && i < list.count; i++) {
+        RepackEntry *e = order[i];
+        uint8_t *data = NULL;
+        size_t size = 0;
+        VaultObjectType type;
+        err = vault_object_read(&e->oid, &data, &size, &type);
+        if (err != VAULT_OK)
+            break;
+        /* Boyut ve tip 1. geçişte başlıktan okundu: içerikle uyuşmalı */
+        if (size != e->size || (uint8_t)type != e->type) {
+            free(data);
+            err = VAULT_ERR_CORRUPT;
+            break;
+        }
+
+        err = pack_write_object(fp, &md, e, data, window, &pos);
+
+        /* Çok büyük nesneler pencereye girmez: bellek sınırlı kalsın */
+        WindowSlot *slot = &window[i % VAULT_PACK_WINDOW];
+        free(slot->data);
+        slot->entry = NULL;
+        slot->data  = NULL;
+        if (err == VAULT_OK && size <= VAULT_PACK_WINDOW_MAX_OBJECT) {
+            slot->entry = e;
+            slot->data  = data;
+        } else {
+            free(data);
+        }
+    }
+    for (int i = 0; i < VAULT_PACK_WINDOW; i++)
+        free(window[i].data);
+    free(order);
+
+    uint8_t checksum[VAULT_SHA256_DIGEST_SIZE];
+    vault_sha256_final(&md, checksum);
+    if (err == VAULT_OK && fwrite(checksum, 1, VAULT_HASH_RAW_SIZE, fp) != VAULT_HASH_RAW_SIZE)
+        err = VAULT_ERR_IO;
+    if (err == VAULT_OK && (fflush(fp) != 0 || vault_fsync_file(fileno(fp)) != VAULT_OK))
+        err = VAULT_ERR_IO;
+    if (fclose(fp) != 0 && err == VAULT_OK)
+        err = VAULT_ERR_IO;
+
+    if (err != VAULT_OK) {
+        unlink(tmp_pack);
+        free(list.items);
+        return err;
+    }
+
+    /* Önce .pack, sonra .idx yerine konur: okuyucu index'i gördüğünde
+     * pack her zaman hazırdır. */
+    VaultOid pack_oid;
+    char hex[VAULT_HASH_HEX_SIZE];
+    char name[PACK_NAME_SIZE];
+    char path[VAULT_OBJECT_PATH_MAX];
+    char tmp_idx[VAULT_OBJECT_PATH_MAX];
+    memcpy(pack_oid.id, checksum, VAULT_HASH_RAW_SIZE);
+    vault_oid_to_hex(&pack_oid, hex);
+    snprintf(name, sizeof(name), "pack-%s", hex);
+    snprintf(path, sizeof(path), "%s/%s.pack", VAULT_PACK_DIR, name);
+    if (rename(tmp_pack, path) != 0) {
+        unlink(tmp_pack);
+        free(list.items);
+        return VAULT_ERR_IO;
+    }
+
+    snprintf(tmp_idx, sizeof(tmp_idx), "%s/tmp_idx_%s", VAULT_PACK_DIR, hex);
+    snprintf(path, sizeof(path), "%s/%s.idx", VAULT_PACK_DIR, name);
+    err = idx_write(tmp_idx, &list, checksum);
+    if (err == VAULT_OK && rename(tmp_idx, path) != 0) {
+        unlink(tmp_idx);
+        err = VAULT_ERR_IO;
+    }
+    /* Eski kopyalar silinmeden önce yeni pack kalıcı olmalı */
+    if (err == VAULT_OK)
+        err = vault_fsync_dir(VAULT_PACK_DIR);
+    if (err == VAULT_OK)
+        err = vault_fsync_barrier();
+    if (err != VAULT_OK) {
+        free(list.items);
+        return err;
+    }
+
+    /* Artık her şey yeni pack'te: eskileri temizle */
+    remove_old_packs(name);
+    remove_loose(&list);
+    vault_pack_close_all();
+
+    if (out_count)
+        *out_count = list.count;
+    free(list.items);
+    return VAULT_OK;
+}
@@ -0,0 +1,531 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "../include/vault_sha256.h"
+
+#include <pthread.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define VAULT_SHA256_X86 1
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+static const uint32_t K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+static const uint32_t H0[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+};
+
+static uint32_t load_be32(const uint8_t *p){
+    return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | p[3];
+}
+
+static void store_be32(uint8_t *p, uint32_t v){
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+/* ---- Generic ------------------------------------------------------------ */
+
+#define ROTR(x, n)  (((x) >> (n)) | ((x) << (32 - (n))))
+
+static void compress_generic(uint32_t state[8], const uint8_t *data, size_t blocks){
+    uint32_t w[64];
+    for (; blocks > 0; blocks--, data += VAULT_SHA256_BLOCK_SIZE) {
+        for (int t = 0; t < 16; t++)
+            w[t] = load_be32(data + 4 * t);
+        for (int t = 16; t < 64; t++) {
+            uint32_t s0 = ROTR(w[t - 15], 7) ^ ROTR(w[t - 15], 18) ^ (w[t - 15] >> 3);
+            uint32_t s1 = ROTR(w[t - 2], 17) ^ ROTR(w[t - 2], 19) ^ (w[t - 2] >> 10);
+            w[t] = w[t - 16] + s0 + w[t - 7] + s1;
+        }
+
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+        for (int t = 0; t < 64; t++) {
+            uint32_t t1 = h + (ROTR(e, 6) ^ ROTR(e, 11) ^ ROTR(e, 25)) +
+                          ((e & f) ^ (~e & g)) + K[t] + w[t];
+            uint32_t t2 = (ROTR(a, 2) ^ ROTR(a, 13) ^ ROTR(a, 22)) +
+                          ((a & b) ^ (a & c) ^ (b & c));
+            h = g; g = f; f = e; e = d + t1;
+            d = c; c = b; b = a; a = t1 + t2;
+        }
+        state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+        state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+    }
+}
+
+#ifdef VAULT_SHA256_X86
+
+/* ---- SHA-NI ------------------------------------------------------------- */
+
+/*
+ * sha256rnds2 iki tur işler ve durumu ABEF / CDGH sırasında ister; giriş ve
+ * çıkışta bu sıraya çevrilir. Mesaj planı 4'lü gruplar hâlinde
+ * sha256msg1 (W[t-16] + σ0(W[t-15])), + W[t-7] ve sha256msg2 (σ1) ile
+ * hesaplanır.
+ */
+__attribute__((target("sha,sse4.1,ssse3")))
+static void compress_shani(uint32_t state[8], const uint8_t *data, size_t blocks){
+    const __m128i bswap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    __m128i tmp    = _mm_loadu_si128((const __m128i *)&state[0]);
+    __m128i state1 = _mm_loadu_si128((const __m128i *)&state[4]);
+    tmp    = _mm_shuffle_epi32(tmp, 0xB1);              /* CDAB */
+    state1 = _mm_shuffle_epi32(state1, 0x1B);           /* EFGH */
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);   /* ABEF */
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);        /* CDGH */
+
+    for (; blocks > 0; blocks--, data += VAULT_SHA256_BLOCK_SIZE) {
+        __m128i abef = state0, cdgh = state1, msg;
+        __m128i m0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data +  0)), bswap);
+        __m128i m1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + 16)), bswap);
+        __m128i m2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + 32)), bswap);
+        __m128i m3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + 48)), bswap);
+
+/* 4 tur: W[4i..4i+3] = a */
+#define SHANI_ROUNDS(i, a)                                                         \
+        msg    = _mm_add_epi32(a, _mm_loadu_si128((const __m128i *)&K[4 * (i)])); \
+        state1 = _mm_sha256rnds2_epu32(state1, state0, msg);                       \
+        state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0E))
+/* a ← sonraki 4 kelime; a, b, c, d ardışık dört grup */
+#define SHANI_SCHEDULE(a, b, c, d)                                                 \
+        a = _mm_sha256msg2_epu32(_mm_add_epi32(_mm_sha256msg1_epu32(a, b),         \
+                                               _mm_alignr_epi8(d, c, 4)), d)
+
+        SHANI_ROUNDS( 0, m0); SHANI_SCHEDULE(m0, m1, m2, m3);
+        SHANI_ROUNDS( 1, m1); SHANI_SCHEDULE(m1, m2, m3, m0);
+        SHANI_ROUNDS( 2, m2); SHANI_SCHEDULE(m2, m3, m0, m1);
+        SHANI_ROUNDS( 3, m3); SHANI_SCHEDULE(m3, m0, m1, m2);
+        SHANI_ROUNDS( 4, m0); SHANI_SCHEDULE(m0, m1, m2, m3);
+        SHANI_ROUNDS( 5, m1); SHANI_SCHEDULE(m1, m2, m3, m0);
+        SHANI_ROUNDS( 6, m2); SHANI_SCHEDULE(m2, m3, m0, m1);
+        SHANI_ROUNDS( 7, m3); SHANI_SCHEDULE(m3, m0, m1, m2);
+        SHANI_ROUNDS( 8, m0); SHANI_SCHEDULE(m0, m1, m2, m3);
+        SHANI_ROUNDS( 9, m1); SHANI_SCHEDULE(m1, m2, m3, m0);
+        SHANI_ROUNDS(10, m2); SHANI_SCHEDULE(m2, m3, m0, m1);
+        SHANI_ROUNDS(11, m3); SHANI_SCHEDULE(m3, m0, m1, m2);
+        SHANI_ROUNDS(12, m0);
+        SHANI_ROUNDS(13, m1);
+        SHANI_ROUNDS(14, m2);
+        SHANI_ROUNDS(15, m3);
+#undef SHANI_ROUNDS
+#undef SHANI_SCHEDULE
+
+        state0 = _mm_add_epi32(state0, abef);
+        state1 = _mm_add_epi32(state1, cdgh);
+    }
+
+    tmp    = _mm_shuffle_epi32(state0, 0x1B);           /* FEBA */
+    state1 = _mm_shuffle_epi32(state1, 0xB1);           /* DCHG */
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);        /* DCBA */
+    state1 = _mm_alignr_epi8(state1, tmp, 8);           /* HGFE */
+    _mm_storeu_si128((__m128i *)&state[0], state0);
+    _mm_storeu_si128((__m128i *)&state[4], state1);
+}
+
+/* ---- AVX2, 8 şerit ------------------------------------------------------ */
+
+#define V_ROTR(x, n)  _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - (n)))
+#define V_ADD(a, b)   _mm256_add_epi32(a, b)
+#define V_XOR3(a, b, c)  _mm256_xor_si256(_mm256_xor_si256(a, b), c)
+
+/* 8 şeridin 32 byte'ını (8 kelime) kelime başına bir vektöre çevirir */
+__attribute__((target("avx2")))
+static void load_transpose(const uint8_t *const blocks[8], size_t off, __m256i out[8]){
+    const __m256i bswap = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                           3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    __m256i r[8], t[8], u[8];
+    for (int i = 0; i < 8; i++)
+        r[i] = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i *)(blocks[i] + off)), bswap);
+
+    for (int i = 0; i < 8; i += 2) {
+        t[i]     = _mm256_unpacklo_epi32(r[i], r[i + 1]);
+        t[i + 1] = _mm256_unpackhi_epi32(r[i], r[i + 1]);
+    }
+    for (int i = 0; i < 8; i += 4) {
+        u[i]     = _mm256_unpacklo_epi64(t[i], t[i + 2]);
+        u[i + 1] = _mm256_unpackhi_epi64(t[i], t[i + 2]);
+        u[i + 2] = _mm256_unpacklo_epi64(t[i + 1], t[i + 3]);
+        u[i + 3] = _mm256_unpackhi_epi64(t[i + 1], t[i + 3]);
+    }
+    for (int i = 0; i < 4; i++) {
+        out[i]     = _mm256_permute2x128_si256(u[i], u[i + 4], 0x20);
+        out[i + 4] = _mm256_permute2x128_si256(u[i], u[i + 4], 0x31);
+    }
+}
+
+/* Her şeritte bir blok: states[i] ← compress(states[i], blocks[i]) */
+__attribute__((target("avx2")))
+static void compress_x8_avx2(uint32_t *const states[8], const uint8_t *const blocks[8]){
+    __m256i s[8], w[16];
+    for (int j = 0; j < 8; j++)
+        s[j] = _mm256_setr_epi32((int)states[0][j], (int)states[1][j], (int)states[2][j],
+                                 (int)states[3][j], (int)states[4][j], (int)states[5][j],
+                                 (int)states[6][j], (int)states[7][j]);
+    load_transpose(blocks, 0, w);
+    load_transpose(blocks, 32, w + 8);
+
+    __m256i a = s[0], b = s[1], c = s[2], d = s[3];
+    __m256i e = s[4], f = s[5], g = s[6], h = s[7];
+    for (int t = 0; t < 64; t++) {
+        if (t >= 16) {
+            __m256i w15 = w[(t - 15) & 15], w2 = w[(t - 2) & 15];
+            __m256i s0 = V_XOR3(V_ROTR(w15, 7), V_ROTR(w15, 18), _mm256_srli_epi32(w15, 3));
+            __m256i s1 = V_XOR3(V_ROTR(w2, 17), V_ROTR(w2, 19), _mm256_srli_epi32(w2, 10));
+            w[t & 15] = V_ADD(V_ADD(w[t & 15], s0), V_ADD(w[(t - 7) & 15], s1));
+        }
+        __m256i ch  = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+        __m256i maj = _mm256_or_si256(_mm256_and_si256(a, b),
+                                      _mm256_and_si256(c, _mm256_or_si256(a, b)));
+        __m256i t1 = V_ADD(V_ADD(h, V_XOR3(V_ROTR(e, 6), V_ROTR(e, 11), V_ROTR(e, 25))),
+                           V_ADD(V_ADD(ch, _mm256_set1_epi32((int)K[t])), w[t & 15]));
+        __m256i t2 = V_ADD(V_XOR3(V_ROTR(a, 2), V_ROTR(a, 13), V_ROTR(a, 22)), maj);
+        h = g; g = f; f = e; e = V_ADD(d, t1);
+        d = c; c = b; b = a; a = V_ADD(t1, t2);
+    }
+    s[0] = V_ADD(s[0], a); s[1] = V_ADD(s[1], b); s[2] = V_ADD(s[2], c); s[3] = V_ADD(s[3], d);
+    s[4] = V_ADD(s[4], e); s[5] = V_ADD(s[5], f); s[6] = V_ADD(s[6], g); s[7] = V_ADD(s[7], h);
+
+    uint32_t out[8][8];
+    for (int j = 0; j < 8; j++)
+        _mm256_storeu_si256((__m256i *)out[j], s[j]);
+    for (int i = 0; i < 8; i++)
+        for (int j = 0; j < 8; j++)
+            states[i][j] = out[j][i];
+}
+
+static unsigned detect_features(void){
+    unsigned a, b, c, d, features = 0;
+    if (!__get_cpuid(1, &a, &b, &c, &d))
+        return 0;
+    int ssse3 = (c >> 9) & 1, sse41 = (c >> 19) & 1;
+    int osxsave = (c >> 27) & 1, avx = (c >> 28) & 1;
+    if (__get_cpuid_max(0, NULL) < 7)
+        return 0;
+    __cpuid_count(7, 0, a, b, c, d);
+
+    if (((b >> 29) & 1) && ssse3 && sse41)
+        features |= VAULT_SHA256_SHANI;
+    if (((b >> 5) & 1) && avx && osxsave) {
+        /* İşletim sistemi YMM kayıtlarını kaydediyor mu? */
+        unsigned lo, hi;
+        __asm__ volatile ("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+        (void)hi;
+        if ((lo & 6) == 6)
+            features |= VAULT_SHA256_AVX2;
+    }
+    return features;
+}
+
+#else
+
+static unsigned detect_features(void){
+    return 0;
+}
+
+#endif /* VAULT_SHA256_X86 */
+
+/* ---- Çekirdek seçimi ---------------------------------------------------- */
+
+typedef void (*CompressFn)(uint32_t state[8], const uint8_t *data, size_t blocks);
+
+static pthread_once_t select_once = PTHREAD_ONCE_INIT;
+static unsigned supported;
+static unsigned active;
+static CompressFn compress = compress_generic;
+
+/*
+ * SHA-NI varsa çoklu akış da onu kullanır: bu işlemcilerde tek bir SHA-NI
+ * akışı 8 AVX2 şeridinin toplamından hızlıdır. AVX2 şeritleri SHA-NI'siz
+ * işlemciler içindir.
+ */
+static void apply_features(unsigned features){
+    active = features & supported;
+    if (active & VAULT_SHA256_SHANI)
+        active &= ~VAULT_SHA256_AVX2;
+#ifdef VAULT_SHA256_X86
+    compress = (active & VAULT_SHA256_SHANI) ? compress_shani : compress_generic;
+#else
+    compress = compress_generic;
+#endif
+}
+
+static void select_kernels(void){
+    supported = detect_features();
+    apply_features(supported);
+}
+
+static CompressFn kernel(void){
+    pthread_once(&select_once, select_kernels);
+    return compress;
+}
+
+unsigned vault_sha256_features(void){
+    pthread_once(&select_once, select_kernels);
+    return supported;
+}
+
+unsigned vault_sha256_use(unsigned features){
+    pthread_once(&select_once, select_kernels);
+    apply_features(features);
+    return active;
+}
+
+const char *vault_sha256_impl_name(void){
+    pthread_once(&select_once, select_kernels);
+    switch (active) {
+    case VAULT_SHA256_SHANI: return "sha-ni";
+    case VAULT_SHA256_AVX2:  return "generic+avx2";
+    default:                 return "generic";
+    }
+}
+
+/* ---- Tek akış ----------------------------------------------------------- */
+
+void vault_sha256_init(VaultSha256 *ctx){
+    memcpy(ctx->state, H0, sizeof(H0));
+    ctx->total = 0;
+    ctx->block_len = 0;
+}
+
+void vault_sha256_update(VaultSha256 *ctx, const void *data, size_t size){
+    CompressFn fn = kernel();
+    const uint8_t *p = data;
+    ctx->total += size;
+
+    if (ctx->block_len > 0) {
+        size_t take = VAULT_SHA256_BLOCK_SIZE - ctx->block_len;
+        if (take > size)
+            take = size;
+        memcpy(ctx->block + ctx->block_len, p, take);
+        ctx->block_len += take;
+        p += take;
+        size -= take;
+        if (ctx->block_len < VAULT_SHA256_BLOCK_SIZE)
+            return;
+        fn(ctx->state, ctx->block, 1);
+        ctx->block_len = 0;
+    }
+
+    size_t blocks = size / VAULT_SHA256_BLOCK_SIZE;
+    if (blocks > 0) {
+        fn(ctx->state, p, blocks);
+        p += blocks * VAULT_SHA256_BLOCK_SIZE;
+        size -= blocks * VAULT_SHA256_BLOCK_SIZE;
+    }
+    memcpy(ctx->block, p, size);
+    ctx->block_len = size;
+}
+
+/*
+ * Son blok(lar): kalan byte'lar + 0x80 + sıfırlar + bit cinsinden uzunluk
+ * (big-endian). Kalan 55 byte'tan fazlaysa uzunluk ikinci bloğa taşar.
+ * Blok sayısını döner (1 veya 2).
+ */
+static size_t pad_tail(const uint8_t *tail, size_t len, uint64_t total,
+                       uint8_t out[2 * VAULT_SHA256_BLOCK_SIZE]){
+    size_t blocks = len < 56 ? 1 : 2;
+    memset(out, 0, blocks * VAULT_SHA256_BLOCK_SIZE);
+    memcpy(out, tail, len);
+    out[len] = 0x80;
+    uint64_t bits = total * 8;
+    uint8_t *end = out + blocks * VAULT_SHA256_BLOCK_SIZE;
+    store_be32(end - 8, (uint32_t)(bits >> 32));
+    store_be32(end - 4, (uint32_t)bits);
+    return blocks;
+}
+
+static void digest_out(const uint32_t state[8], uint8_t out[VAULT_SHA256_DIGEST_SIZE]){
+    for (int i = 0; i < 8; i++)
+        store_be32(out + 4 * i, state[i]);
+}
+
+void vault_sha256_final(VaultSha256 *ctx, uint8_t out[VAULT_SHA256_DIGEST_SIZE]){
+    uint8_t tail[2 * VAULT_SHA256_BLOCK_SIZE];
+    size_t blocks = pad_tail(ctx->block, ctx->block_len, ctx->total, tail);
+    kernel()(ctx->state, tail, blocks);
+    digest_out(ctx->state, out);
+}
+
+void vault_sha256(const void *data, size_t size, uint8_t out[VAULT_SHA256_DIGEST_SIZE]){
+    VaultSha256 ctx;
+    vault_sha256_init(&ctx);
+    vault_sha256_update(&ctx, data, size);
+    vault_sha256_final(&ctx, out);
+}
+
+/* ---- Çoklu akış --------------------------------------------------------- */
+
+#ifdef VAULT_SHA256_X86
+
+#define LANES  8
+
+/*
+ * Bir şeritteki mesajın blok sırası: (context'te yarım kalan blok veri ile
+ * tamamlandıysa) o blok, verinin tam blokları, sonra padding'li son
+ * blok(lar).
+ */
+typedef struct {
+    VaultSha256   *ctx;
+    size_t         msg;             /* out indeksi */
+    int            active;
+    int            first;           /* ctx->block önce işlenecek */
+    const uint8_t *data;            /* Sıradaki tam blok */
+    size_t         full;            /* Kalan tam blok sayısı */
+    uint8_t        tail[2 * VAULT_SHA256_BLOCK_SIZE];
+    size_t         tail_blocks;
+    size_t         tail_pos;
+} Lane;
+
+static void lane_start(Lane *l, VaultSha256 *ctx, const uint8_t *data, size_t size, size_t msg){
+    l->ctx = ctx;
+    l->msg = msg;
+    l->active = 1;
+    l->first = 0;
+    ctx->total += size;
+
+    if (ctx->block_len > 0) {
+        size_t take = VAULT_SHA256_BLOCK_SIZE - ctx->block_len;
+        if (take > size)
+            take = size;
+        memcpy(ctx->block + ctx->block_len, data, take);
+        ctx->block_len += take;
+        data += take;
+        size -= take;
+        if (ctx->block_len == VAULT_SHA256_BLOCK_SIZE) {
+            l->first = 1;
+            ctx->block_len = 0;
+        }
+    }
+
+    l->data = data;
+    l->full = size / VAULT_SHA256_BLOCK_SIZE;
+    size_t rest = size % VAULT_SHA256_BLOCK_SIZE;
+    if (ctx->block_len > 0)     /* Veri context'teki bloğu doldurmaya yetmedi */
+        l->tail_blocks = pad_tail(ctx->block, ctx->block_len, ctx->total, l->tail);
+    else
+        l->tail_blocks = pad_tail(data + l->full * VAULT_SHA256_BLOCK_SIZE, rest,
+                                  ctx->total, l->tail);
+    l->tail_pos = 0;
+}
+
+static const uint8_t *lane_next(Lane *l){
+    if (l->first) {
+        l->first = 0;
+        return l->ctx->block;
+    }
+    if (l->full > 0) {
+        const uint8_t *p = l->data;
+        l->data += VAULT_SHA256_BLOCK_SIZE;
+        l->full--;
+        return p;
+    }
+    if (l->tail_pos < l->tail_blocks)
+        return l->tail + VAULT_SHA256_BLOCK_SIZE * l->tail_pos++;
+    return NULL;
+}
+
+/* Şeridin kalanını tek akış çekirdeğiyle bitirir */
+static void lane_drain(Lane *l, CompressFn fn){
+    if (l->first) {
+        fn(l->ctx->state, l->ctx->block, 1);
+        l->first = 0;
+    }
+    if (l->full > 0) {
+        fn(l->ctx->state, l->data, l->full);
+        l->full = 0;
+    }
+    if (l->tail_pos < l->tail_blocks) {
+        fn(l->ctx->state, l->tail + VAULT_SHA256_BLOCK_SIZE * l->tail_pos,
+           l->tail_blocks - l->tail_pos);
+        l->tail_pos = l->tail_blocks;
+    }
+}
+
+static void final_many_avx2(VaultSha256 *ctx, const uint8_t *const *data,
+                            const size_t *sizes, size_t count,
+                            uint8_t (*out)[VAULT_SHA256_DIGEST_SIZE]){
+    static const uint8_t idle_block[VAULT_SHA256_BLOCK_SIZE];
+    CompressFn fn = kernel();
+    Lane lanes[LANES];
+    uint32_t idle_state[LANES][8];
+    size_t next = 0;
+    for (int i = 0; i < LANES; i++)
+        lanes[i].active = 0;
+
+    for (;;) {
+        const uint8_t *blocks[LANES];
+        uint32_t *states[LANES];
+        int busy = 0;
+
+        for (int i = 0; i < LANES; i++) {
+            Lane *l = &lanes[i];
+            blocks[i] = NULL;
+            while (!blocks[i]) {
+                if (!l->active) {
+                    if (next == count)
+                        break;
+                    lane_start(l, &ctx[next], data[next], sizes[next], next);
+                    next++;
+                }
+                if (!(blocks[i] = lane_next(l))) {
+                    digest_out(l->ctx->state, out[l->msg]);
+                    l->active = 0;
+                }
+            }
+            if (blocks[i]) {
+                states[i] = l->ctx->state;
+                busy++;
+            } else {
+                blocks[i] = idle_block;
+                states[i] = idle_state[i];
+            }
+        }
+        if (busy == 0)
+            return;
+
+        /* Tek bir uzun mesaj kaldıysa 8 şeridin 7'si boşa döner */
+        if (busy == 1 && next == count) {
+            for (int i = 0; i < LANES; i++) {
+                if (states[i] == idle_state[i])
+                    continue;
+                fn(states[i], blocks[i], 1);
+                lane_drain(&lanes[i], fn);
+                digest_out(lanes[i].ctx->state, out[lanes[i].msg]);
+            }
+            return;
+        }
+        compress_x8_avx2(states, blocks);
+    }
+}
+
+#endif /* VAULT_SHA256_X86 */
+
+void vault_sha256_final_many(VaultSha256 *ctx, const uint8_t *const *data,
+                             const size_t *sizes, size_t count,
+                             uint8_t (*out)[VAULT_SHA256_DIGEST_SIZE]){
+    kernel();
+#ifdef VAULT_SHA256_X86
+    if ((active & VAULT_SHA256_AVX2) && count > 1) {
+        final_many_avx2(ctx, data, sizes, count, out);
+        return;
+    }
+#endif
+    for (size_t i = 0; i < count; i++) {
+        vault_sha256_update(&ctx[i], data[i], sizes[i]);
+        vault_sha256_final(&ctx[i], out[i]);
+    }
+}
@@ -0,0 +1,130 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "../include/vault_tree.h"
+#include "../include/vault_index.h"
+
+#include <string.h>
+
+int vault_tree_entry_is_dir(const VaultTreeEntry *entry){
+    return strcmp(entry->mode, "040000") == 0;
+}
+
+/* Git sırası: dizin isimleri sonlarında '/' varmış gibi karşılaştırılır */
+static int entry_cmp(const VaultTreeEntry *a, const VaultTreeEntry *b){
+    size_t la = strlen(a->name), lb = strlen(b->name);
+    size_t n = la < lb ? la : lb;
+    int cmp = memcmp(a->name, b->name, n);
+    if (cmp != 0)
+        return cmp;
+    unsigned char ca = la > n ? (unsigned char)a->name[n]
+                              : (vault_tree_entry_is_dir(a) ? '/' : '\0');
+    unsigned char cb = lb > n ? (unsigned char)b->name[n]
+                              : (vault_tree_entry_is_dir(b) ? '/' : '\0');
+    return (int)ca - (int)cb;
+}
+
+/* Sıfır oid boş tree'dir */
+static VaultError tree_load(const VaultOid *oid, VaultTree *out){
+    memset(out, 0, sizeof(*out));
+    if (vault_oid_is_null(oid))
+        return VAULT_OK;
+
+    VaultObjectView view;
+    VaultError err = vault_object_view(oid, &view);
+    if (err != VAULT_OK)
+        return err;
+    if (view.type != VAULT_OBJ_TREE)
+        err = VAULT_ERR_CORRUPT;
+    else
+        err = vault_tree_deserialize(view.data, view.size, out);
+    vault_object_view_release(&view);
+    return err;
+}
+
+typedef struct {
+    char                  path[VAULT_MAX_PATH];
+    VaultTreeDiffCallback callback;
+    void                 *user_data;
+} TreeDiffWalk;
+
+static VaultError diff_level(TreeDiffWalk *walk, size_t len,
+                             const VaultOid *old_oid, const VaultOid *new_oid);
+
+/* Bir girişi (eski ya da yeni tarafta) rapor eder; dizinse içine iner */
+static VaultError diff_entry(TreeDiffWalk *walk, size_t len,
+                             const VaultTreeEntry *old_entry,
+                             const VaultTreeEntry *new_entry){
+    const VaultTreeEntry *any = old_entry ? old_entry : new_entry;
+    size_t name_len = strlen(any->name);
+    if (len + name_len + 2 > VAULT_MAX_PATH)
+        return VAULT_ERR_CORRUPT;
+    memcpy(walk->path + len, any->name, name_len + 1);
+
+    VaultError err;
+    if (vault_tree_entry_is_dir(any)) {
+        static const VaultOid empty;
+        walk->path[len + name_len] = '/';
+        err = diff_level(walk, len + name_len + 1,
+                         old_entry ? &old_entry->hash : &empty,
+                         new_entry ? &new_entry->hash : &empty);
+    } else {
+        VaultTreeChange change = {
+            .path      = walk->path,
+            .status    = !old_entry ? 'A' : !new_entry ? 'D' : 'M',
+            .old_entry = old_entry,
+            .new_entry = new_entry,
+        };
+        err = walk->callback(&change, walk->user_data);
+    }
+    walk->path[len] = '\0';
+    return err;
+}
+
+static VaultError diff_level(TreeDiffWalk *walk, size_t len,
+                             const VaultOid *old_oid, const VaultOid *new_oid){
+    /* Aynı hash: alt ağacın tamamı aynı, açmaya gerek yok */
+    if (vault_oid_equal(old_oid, new_oid))
+        return VAULT_OK;
+
+    VaultTree old_tree, new_tree;
+    VaultError err = tree_load(old_oid, &old_tree);
+    if (err != VAULT_OK)
+        return err;
+    if ((err = tree_load(new_oid, &new_tree)) != VAULT_OK) {
+        vault_tree_free(&old_tree);
+        return err;
+    }
+
+    size_t i = 0, j = 0;
+    while (err == VAULT_OK && (i < old_tree.count || j < new_tree.count)) {
+        const VaultTreeEntry *a = i < old_tree.count ? &old_tree.entries[i] : NULL;
+        const VaultTreeEntry *b = j < new_tree.count ? &new_tree.entries[j] : NULL;
+        int cmp = !a ? 1 : !b ? -1 : entry_cmp(a, b);
+
+        if (cmp < 0) {
+            err = diff_entry(walk, len, a, NULL);
+            i++;
+        } else if (cmp > 0) {
+            err = diff_entry(walk, len, NULL, b);
+            j++;
+        } else {
+            if (!vault_oid_equal(&a->hash, &b->hash) || strcmp(a->mode, b->mode) != 0)
+                err = diff_entry(walk, len, a, b);
+            i++;
+            j++;
+        }
+    }
+
+    vault_tree_free(&old_tree);
+    vault_tree_free(&new_tree);
+    return err;
+}
+
+VaultError vault_tree_diff(const VaultOid *old_tree, const VaultOid *new_tree,
+                           VaultTreeDiffCallback callback, void *user_data){
+    TreeDiffWalk walk;
+    walk.path[0] = '\0';
+    walk.callback = callback;
+    walk.user_data = user_data;
+    return diff_level(&walk, 0, old_tree, new_tree);
+}
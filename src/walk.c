@@ -0,0 +1,238 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "../include/vault_walk.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* Kuyruktaki bir dizin */
+typedef struct {
+    char       *path;
+    size_t      len;
+    struct stat st;
+    void       *data;
+} WalkJob;
+
+/*
+ * İki uçlu kuyruk: sahibi sondan (bottom) ekler ve alır, hırsızlar baştan
+ * (top) alır. İş dizin başına olduğundan (readdir + lstat'lar) kuyruk başına
+ * bir kilit yeterince ucuzdur.
+ */
+typedef struct {
+    WalkJob        *jobs;
+    size_t          top;
+    size_t          bottom;
+    size_t          cap;
+    pthread_mutex_t lock;
+} WalkDeque;
+
+struct VaultWalk {
+    WalkDeque      *deques;
+    int             workers;
+    VaultWalkDirFn  fn;
+    void           *ctx;
+
+    pthread_mutex_t lock;       /* Aşağıdakileri korur */
+    pthread_cond_t  wake;
+    size_t          pending;    /* Kuyrukta ya da işlenmekte olan dizinler */
+    size_t          pushes;     /* Her eklemede artar: uyuyan işçi iş kaçırmaz */
+    int             sleepers;
+    VaultError      err;
+};
+
+typedef struct {
+    VaultWalk *walk;
+    int        worker;
+} WalkWorker;
+
+static void walk_fail(VaultWalk *walk, VaultError err){
+    pthread_mutex_lock(&walk->lock);
+    if (walk->err == VAULT_OK)
+        walk->err = err;
+    pthread_mutex_unlock(&walk->lock);
+}
+
+static int deque_push(WalkDeque *q, WalkJob *job){
+    pthread_mutex_lock(&q->lock);
+    if (q->bottom == q->cap) {
+        if (q->top > 0) {
+            /* Çalınan baş tarafı geri kazan */
+            memmove(q->jobs, q->jobs + q->top, (q->bottom - q->top) * sizeof(*q->jobs));
+            q->bottom -= q->top;
+            q->top = 0;
+        } else {
+            size_t cap = q->cap ? q->cap * 2 : 64;
+            WalkJob *grown = realloc(q->jobs, cap * sizeof(*grown));
+            if (!grown) {
+                pthread_mutex_unlock(&q->lock);
+                return -1;
+            }
+            q->jobs = grown;
+            q->cap = cap;
+        }
+    }
+    q->jobs[q->bottom++] = *job;
+    pthread_mutex_unlock(&q->lock);
+    return 0;
+}
+
+/* from_top = 0: sahibi sondan alır; 1: hırsız baştan alır */
+static int deque_take(WalkDeque *q, int from_top, WalkJob *out){
+    int found = 0;
+    pthread_mutex_lock(&q->lock);
+    if (q->top < q->bottom) {
+        *out = from_top ? q->jobs[q->top++] : q->jobs[--q->bottom];
+        if (q->top == q->bottom)
+            q->top = q->bottom = 0;
+        found = 1;
+    }
+    pthread_mutex_unlock(&q->lock);
+    return found;
+}
+
+VaultError vault_walk_push(VaultWalk *walk, int worker, const char *path,
+                           size_t len, const struct stat *st, void *data){
+    WalkJob job;
+    if (!(job.path = malloc(len + 1)))
+        return VAULT_ERR_NOMEM;
+    memcpy(job.path, path, len);
+    job.path[len] = '\0';
+    job.len = len;
+    job.st = *st;
+    job.data = data;
+
+    pthread_mutex_lock(&walk->lock);
+    walk->pending++;
+    walk->pushes++;
+    pthread_mutex_unlock(&walk->lock);
+
+    if (deque_push(&walk->deques[worker], &job) != 0) {
+        free(job.path);
+        pthread_mutex_lock(&walk->lock);
+        walk->pending--;
+        pthread_mutex_unlock(&walk->lock);
+        return VAULT_ERR_NOMEM;
+    }
+
+    pthread_mutex_lock(&walk->lock);
+    if (walk->sleepers > 0)
+        pthread_cond_signal(&walk->wake);
+    pthread_mutex_unlock(&walk->lock);
+    return VAULT_OK;
+}
+
+/* Önce kendi kuyruğu, sonra sıradaki işçilerden çalma */
+static int walk_find_job(VaultWalk *walk, int worker, WalkJob *out){
+    if (deque_take(&walk->deques[worker], 0, out))
+        return 1;
+    for (int i = 1; i < walk->workers; i++)
+        if (deque_take(&walk->deques[(worker + i) % walk->workers], 1, out))
+            return 1;
+    return 0;
+}
+
+static void *walk_worker(void *arg){
+    WalkWorker *self = arg;
+    VaultWalk *walk = self->walk;
+
+    for (;;) {
+        pthread_mutex_lock(&walk->lock);
+        size_t seen = walk->pushes;
+        pthread_mutex_unlock(&walk->lock);
+
+        WalkJob job;
+        if (walk_find_job(walk, self->worker, &job)) {
+            pthread_mutex_lock(&walk->lock);
+            int failed = walk->err != VAULT_OK;
+            pthread_mutex_unlock(&walk->lock);
+
+            /* Hata sonrası kalan işler yalnızca boşaltılır */
+            if (!failed) {
+                VaultError err = walk->fn(walk, self->worker, job.path, job.len,
+                                          &job.st, job.data, walk->ctx);
+                if (err != VAULT_OK)
+                    walk_fail(walk, err);
+            }
+            free(job.path);
+
+            pthread_mutex_lock(&walk->lock);
+            if (--walk->pending == 0)
+                pthread_cond_broadcast(&walk->wake);
+            pthread_mutex_unlock(&walk->lock);
+            continue;
+        }
+
+        /* İş yok: ya her şey bitti ya da başkası yeni dizin ekleyecek */
+        pthread_mutex_lock(&walk->lock);
+        if (walk->pending == 0) {
+            pthread_mutex_unlock(&walk->lock);
+            break;
+        }
+        if (walk->pushes == seen) {
+            walk->sleepers++;
+            pthread_cond_wait(&walk->wake, &walk->lock);
+            walk->sleepers--;
+        }
+        pthread_mutex_unlock(&walk->lock);
+    }
+    return NULL;
+}
+
+int vault_walk_jobs(int jobs){
+    if (jobs > 0)
+        return jobs;
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+}
+
+VaultError vault_walk_run(int jobs, const struct stat *root_st,
+                          VaultWalkDirFn fn, void *ctx){
+    VaultWalk walk;
+    memset(&walk, 0, sizeof(walk));
+    walk.workers = vault_walk_jobs(jobs);
+    walk.fn = fn;
+    walk.ctx = ctx;
+
+    walk.deques = calloc((size_t)walk.workers, sizeof(*walk.deques));
+    WalkWorker *self = calloc((size_t)walk.workers, sizeof(*self));
+    pthread_t *threads = calloc((size_t)walk.workers, sizeof(*threads));
+    if (!walk.deques || !self || !threads) {
+        free(walk.deques);
+        free(self);
+        free(threads);
+        return VAULT_ERR_NOMEM;
+    }
+    pthread_mutex_init(&walk.lock, NULL);
+    pthread_cond_init(&walk.wake, NULL);
+    for (int i = 0; i < walk.workers; i++) {
+        pthread_mutex_init(&walk.deques[i].lock, NULL);
+        self[i].walk = &walk;
+        self[i].worker = i;
+    }
+
+    VaultError err = vault_walk_push(&walk, 0, "", 0, root_st, NULL);
+    if (err == VAULT_OK) {
+        /* Ana iş parçacığı 0 numaralı işçidir; jobs - 1 ek iş parçacığı yeter */
+        int started = 1;
+        while (started < walk.workers &&
+               pthread_create(&threads[started], NULL, walk_worker, &self[started]) == 0)
+            started++;
+        walk_worker(&self[0]);
+        for (int i = 1; i < started; i++)
+            pthread_join(threads[i], NULL);
+        err = walk.err;
+    }
+
+    for (int i = 0; i < walk.workers; i++) {
+        free(walk.deques[i].jobs);
+        pthread_mutex_destroy(&walk.deques[i].lock);
+    }
+    pthread_cond_destroy(&walk.wake);
+    pthread_mutex_destroy(&walk.lock);
+    free(walk.deques);
+    free(self);
+    free(threads);
+    return err;
+}
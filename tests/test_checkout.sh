@@ -0,0 +1,63 @@
+#!/bin/sh
+#
+# vault checkout: dosya ↔ dizin dönüşümünün iki yönü ve izlenmeyen dosya
+# koruması. Geçici bir dizinde çalışır.
+#
+# Kullanım: make test   (veya tests/test_checkout.sh ./vault)
+
+set -e
+VAULT=$(cd "$(dirname "$1")" && pwd)/$(basename "$1")
+DIR=$(mktemp -d "${TMPDIR:-/tmp}/vault-checkout-XXXXXX")
+trap 'rm -rf "$DIR"' EXIT
+cd "$DIR"
+
+fail(){ echo "checkout FAIL: $*" >&2; exit 1; }
+
+"$VAULT" init >/dev/null
+mkdir -p a/b
+echo dizin > a/b/f
+echo kalan > a/g
+"$VAULT" add a/b/f a/g >/dev/null
+"$VAULT" commit -m "a/b dizin" >/dev/null
+DIR_COMMIT=$(cat .vault/HEAD)
+
+rm -r a/b
+echo dosya > a/b
+"$VAULT" add a >/dev/null
+"$VAULT" commit -m "a/b dosya" >/dev/null
+FILE_COMMIT=$(cat .vault/HEAD)
+
+"$VAULT" checkout "$DIR_COMMIT" >/dev/null || fail "dosya -> dizin"
+[ "$(cat a/b/f)" = dizin ] || fail "a/b/f içeriği"
+
+"$VAULT" checkout "$FILE_COMMIT" >/dev/null || fail "dizin -> dosya"
+[ -f a/b ] && [ "$(cat a/b)" = dosya ] || fail "a/b içeriği"
+[ "$(cat a/g)" = kalan ] || fail "a/g içeriği"
+
+# İzlenmeyen bir dosya içeren dizin korunur
+"$VAULT" checkout "$DIR_COMMIT" >/dev/null
+echo yerel > a/b/yerel
+if "$VAULT" checkout "$FILE_COMMIT" >/dev/null 2>&1; then
+    fail "izlenmeyen a/b/yerel'in üzerine yazıldı"
+fi
+[ "$(cat a/b/yerel)" = yerel ] || fail "a/b/yerel kayboldu"
+rm a/b/yerel
+
+# Yeni bir yolun üst dizini yerinde izlenmeyen bir dosya: checkout hiçbir
+# şeye dokunmadan reddedilir
+"$VAULT" checkout "$FILE_COMMIT" >/dev/null
+rm a/b
+echo sonra > z
+"$VAULT" add a z >/dev/null
+"$VAULT" commit -m "a/b yok, z var" >/dev/null
+GONE_COMMIT=$(cat .vault/HEAD)
+echo yerel > a/b
+if "$VAULT" checkout "$DIR_COMMIT" >/dev/null 2>&1; then
+    fail "izlenmeyen a/b dosyasının yerine dizin kuruldu"
+fi
+[ -f a/b ] && [ "$(cat a/b)" = yerel ] || fail "a/b kayboldu"
+[ "$(cat a/g)" = kalan ] || fail "a/g silindi"
+[ "$(cat z)" = sonra ] || fail "z silindi (yarım checkout)"
+[ "$(cat .vault/HEAD)" = "$GONE_COMMIT" ] || fail "HEAD değişti"
+
+echo "checkout ok"
@@ -0,0 +1,113 @@
+/*
+ * .vaultignore eşleyicisini bilinen .gitignore davranışıyla karşılaştırır.
+ *
+ * Her satır: kurallar (kök .vaultignore), yol, dizin mi, beklenen sonuç.
+ * Hızlı yollar (sabit, son ek, önek) ile genel glob aynı cevabı vermeli.
+ *
+ * Kullanım: make test
+ */
+
+#include "../include/vault_ignore.h"
+
+#include <stdio.h>
+#include <string.h>
+
+typedef struct {
+    const char *rules;
+    const char *path;
+    int         is_dir;
+    int         ignored;
+} Case;
+
+static const Case cases[] = {
+    /* Sabit ve son ek */
+    { "TODO\n",            "TODO",              0, 1 },
+    { "TODO\n",            "src/TODO",          0, 1 },
+    { "TODO\n",            "TODO.txt",          0, 0 },
+    { "*.o\n",             "a/b/main.o",        0, 1 },
+    { "*.o\n",             "main.c",            0, 0 },
+    { "*.o\n",             "o",                 0, 0 },
+    /* Çapalı kalıplar */
+    { "/TODO\n",           "src/TODO",          0, 0 },
+    { "/TODO\n",           "TODO",              0, 1 },
+    { "doc/*.html\n",      "doc/a.html",        0, 1 },
+    { "doc/*.html\n",      "doc/x/a.html",      0, 0 },
+    { "doc/*.html\n",      "src/doc/a.html",    0, 0 },
+    /* Yalnızca dizinler */
+    { "build/\n",          "build",             1, 1 },
+    { "build/\n",          "build",             0, 0 },
+    { "build/\n",          "x/build",           1, 1 },
+    /* "**" */
+    { "**/tmp\n",          "tmp",               1, 1 },
+    { "**/tmp\n",          "a/b/tmp",           0, 1 },
+    { "a/**/b\n",          "a/b",               0, 1 },
+    { "a/**/b\n",          "a/x/y/b",           0, 1 },
+    { "a/**/b\n",          "a/x/y/c",           0, 0 },
+    { "logs/**\n",         "logs/x/y",          0, 1 },
+    { "logs/**\n",         "logs",              1, 0 },
+    { "a**b\n",            "axxb",              0, 1 },
+    /* '?', sınıflar, kaçış */
+    { "tmp-?.log\n",       "tmp-1.log",         0, 1 },
+    { "tmp-?.log\n",       "tmp-12.log",        0, 0 },
+    { "[a-c]*.txt\n",      "b1.txt",            0, 1 },
+    { "[a-c]*.txt\n",      "d1.txt",            0, 0 },
+    { "[!a-c]*.txt\n",     "d1.txt",            0, 1 },
+    { "\\#x\n",            "#x",                0, 1 },
+    { "# yorum\n",         "# yorum",           0, 0 },
+    { "\\!x\n",            "!x",                0, 1 },
+    { "a\\*\n",            "a*",                0, 1 },
+    { "a\\*\n",            "ab",                0, 0 },
+    { "x  \n",             "x",                 0, 1 },
+    /* Olumsuzlama: son eşleşen kazanır */
+    { "*.o\n!keep.o\n",    "keep.o",            0, 0 },
+    { "*.o\n!keep.o\n",    "main.o",            0, 1 },
+    { "!keep.o\n*.o\n",    "keep.o",            0, 1 },
+    /* Önekli glob */
+    { "build*\n",          "build-debug",       1, 1 },
+    { "build*\n",          "rebuild",           1, 0 },
+    { "src/gen_*.c\n",     "src/gen_a.c",       0, 1 },
+    { "src/gen_*.c\n",     "src/main.c",        0, 0 },
+};
+
+/* Alt dizindeki dosya kökteki kuralı geçersiz kılar */
+static int nested(void){
+    VaultIgnore *root, *sub;
+    if (vault_ignore_parse("", "*.log\n", 6, &root) != VAULT_OK ||
+        vault_ignore_parse("keep/", "!*.log\n/local\n", 14, &sub) != VAULT_OK)
+        return 1;
+    VaultIgnoreStack top = { NULL, root };
+    VaultIgnoreStack deep = { &top, sub };
+
+    int failures = 0;
+    failures += vault_ignore_match(&deep, "keep/a.log", 0) != 0;
+    failures += vault_ignore_match(&deep, "other/a.log", 0) != 1;
+    failures += vault_ignore_match(&deep, "keep/local", 0) != 1;
+    failures += vault_ignore_match(&deep, "keep/x/local", 0) != 0;
+    failures += vault_ignore_match(&top, "keep/a.log", 0) != 1;
+    if (failures)
+        fprintf(stderr, "FAIL nested .vaultignore\n");
+    vault_ignore_free(root);
+    vault_ignore_free(sub);
+    return failures;
+}
+
+int main(void){
+    int failures = 0;
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        const Case *c = &cases[i];
+        VaultIgnore *ig;
+        if (vault_ignore_parse("", c->rules, strlen(c->rules), &ig) != VAULT_OK)
+            return 1;
+        VaultIgnoreStack stack = { NULL, ig };
+        int got = vault_ignore_match(&stack, c->path, c->is_dir);
+        if (got != c->ignored) {
+            fprintf(stderr, "FAIL rules \"%s\" path %s%s: got %d\n",
+                    c->rules, c->path, c->is_dir ? "/" : "", got);
+            failures++;
+        }
+        vault_ignore_free(ig);
+    }
+    failures += nested();
+    printf("ignore %s\n", failures ? "FAIL" : "ok");
+    return failures ? 1 : 0;
+}
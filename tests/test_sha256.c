@@ -0,0 +1,122 @@
+/*
+ * vault_sha256 çekirdeklerini OpenSSL ile karşılaştırır.
+ *
+ * CPU'nun desteklediği her çekirdek birleşimi için (generic, sha-ni, avx2)
+ * rastgele boyutlu mesajlar tek seferde, rastgele parçalarla artımlı olarak
+ * ve önekli çoklu akışla hash'lenir; her özet EVP_Digest ile aynı olmalı.
+ *
+ * Kullanım: make test
+ */
+
+#include "../include/vault_sha256.h"
+
+#include <openssl/evp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_MESSAGE  (3 * 65536 + 17)
+#define MANY         37
+
+static unsigned seed = 12345;
+
+static unsigned next_rand(void){
+    seed = seed * 1103515245u + 12345u;
+    return seed >> 8;
+}
+
+static void reference(const uint8_t *data, size_t size, uint8_t out[32]){
+    unsigned int len = 0;
+    EVP_Digest(data, size, out, &len, EVP_sha256(), NULL);
+}
+
+/* Sınırlara yakın boyutlar (55/56/64) ağırlıklı */
+static size_t random_size(void){
+    static const size_t edges[] = { 0, 1, 55, 56, 63, 64, 65, 119, 120, 127, 128, 129 };
+    unsigned r = next_rand() % 10;
+    if (r < 4)
+        return edges[next_rand() % (sizeof(edges) / sizeof(edges[0]))];
+    if (r < 9)
+        return next_rand() % 8192;
+    return next_rand() % MAX_MESSAGE;
+}
+
+static int check(const char *what, const uint8_t *data, size_t size,
+                 const uint8_t got[32]){
+    uint8_t want[32];
+    reference(data, size, want);
+    if (memcmp(got, want, 32) == 0)
+        return 0;
+    fprintf(stderr, "FAIL %s: %s, size %zu\n", vault_sha256_impl_name(), what, size);
+    return 1;
+}
+
+static int run(const uint8_t *pool){
+    int failures = 0;
+
+    for (int round = 0; round < 300; round++) {
+        size_t size = random_size();
+        const uint8_t *data = pool + next_rand() % 64;
+        uint8_t got[32];
+
+        vault_sha256(data, size, got);
+        failures += check("one-shot", data, size, got);
+
+        VaultSha256 ctx;
+        vault_sha256_init(&ctx);
+        for (size_t off = 0; off < size; ) {
+            size_t n = next_rand() % 200;
+            if (n > size - off)
+                n = size - off;
+            vault_sha256_update(&ctx, data + off, n);
+            off += n;
+        }
+        vault_sha256_final(&ctx, got);
+        failures += check("incremental", data, size, got);
+    }
+
+    /* Çoklu akış: her mesajın önce önek kısmı update ile eklenir */
+    for (int round = 0; round < 40; round++) {
+        VaultSha256 ctx[MANY];
+        const uint8_t *data[MANY], *start[MANY];
+        size_t sizes[MANY], total[MANY];
+        uint8_t out[MANY][32];
+        size_t count = 1 + next_rand() % MANY;
+
+        for (size_t i = 0; i < count; i++) {
+            size_t prefix = next_rand() % 3 == 0 ? next_rand() % 100 : 0;
+            total[i] = random_size() % 20000 + prefix;
+            start[i] = pool + next_rand() % 64;
+            vault_sha256_init(&ctx[i]);
+            vault_sha256_update(&ctx[i], start[i], prefix);
+            data[i] = start[i] + prefix;
+            sizes[i] = total[i] - prefix;
+        }
+        vault_sha256_final_many(ctx, data, sizes, count, out);
+        for (size_t i = 0; i < count; i++)
+            failures += check("many", start[i], total[i], out[i]);
+    }
+    return failures;
+}
+
+int main(void){
+    uint8_t *pool = malloc(MAX_MESSAGE + 64);
+    if (!pool)
+        return 1;
+    for (size_t i = 0; i < MAX_MESSAGE + 64; i++)
+        pool[i] = (uint8_t)next_rand();
+
+    static const unsigned combos[] = { 0, VAULT_SHA256_SHANI, VAULT_SHA256_AVX2 };
+    unsigned cpu = vault_sha256_features();
+    int failures = 0;
+    for (size_t c = 0; c < sizeof(combos) / sizeof(combos[0]); c++) {
+        if ((combos[c] & cpu) != combos[c] || vault_sha256_use(combos[c]) != combos[c])
+            continue;
+        int f = run(pool);
+        printf("sha256 %-12s %s\n", vault_sha256_impl_name(), f ? "FAIL" : "ok");
+        failures += f;
+    }
+
+    free(pool);
+    return failures ? 1 : 0;
+}